@@ -0,0 +1,288 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LIBPLATFORM_V8_TRACING_H_
+#define V8_LIBPLATFORM_V8_TRACING_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace v8 {
+
+namespace base {
+class Mutex;
+}  // namespace base
+
+namespace platform {
+namespace tracing {
+
+const int kTraceMaxNumArgs = 2;
+
+/**
+ * A single recorded trace event.
+ */
+class TraceObject {
+ public:
+  union ArgValue {
+    bool as_bool;
+    uint64_t as_uint;
+    int64_t as_int;
+    double as_double;
+    const void* as_pointer;
+    const char* as_string;
+  };
+
+  TraceObject() {}
+  ~TraceObject();
+  void Initialize(char phase, const uint8_t* category_enabled_flag,
+                  const char* name, const char* scope, uint64_t id,
+                  uint64_t bind_id, int num_args, const char** arg_names,
+                  const uint8_t* arg_types, const uint64_t* arg_values,
+                  unsigned int flags);
+  void UpdateDuration();
+  void InitializeForTesting(char phase, const uint8_t* category_enabled_flag,
+                            const char* name, const char* scope, uint64_t id,
+                            uint64_t bind_id, int num_args,
+                            const char** arg_names, const uint8_t* arg_types,
+                            const uint64_t* arg_values, unsigned int flags,
+                            int pid, int tid, int64_t ts, int64_t tts,
+                            uint64_t duration, uint64_t cpu_duration);
+
+  int pid() const { return pid_; }
+  int tid() const { return tid_; }
+  char phase() const { return phase_; }
+  const uint8_t* category_enabled_flag() const {
+    return category_enabled_flag_;
+  }
+  const char* name() const { return name_; }
+  const char* scope() const { return scope_; }
+  uint64_t id() const { return id_; }
+  uint64_t bind_id() const { return bind_id_; }
+  int num_args() const { return num_args_; }
+  const char** arg_names() { return arg_names_; }
+  uint8_t* arg_types() { return arg_types_; }
+  ArgValue* arg_values() { return arg_values_; }
+  unsigned int flags() const { return flags_; }
+  int64_t ts() { return ts_; }
+  int64_t tts() { return tts_; }
+  uint64_t duration() { return duration_; }
+  uint64_t cpu_duration() { return cpu_duration_; }
+
+ private:
+  int pid_;
+  int tid_;
+  char phase_;
+  const char* name_;
+  const char* scope_;
+  const uint8_t* category_enabled_flag_;
+  uint64_t id_;
+  uint64_t bind_id_;
+  int num_args_;
+  const char* arg_names_[kTraceMaxNumArgs];
+  uint8_t arg_types_[kTraceMaxNumArgs];
+  ArgValue arg_values_[kTraceMaxNumArgs];
+  // Storage for the name and the string arguments that have to be copied.
+  char* parameter_copy_storage_ = nullptr;
+  unsigned int flags_;
+  int64_t ts_;
+  int64_t tts_;
+  uint64_t duration_;
+  uint64_t cpu_duration_;
+
+  // Disallow copy and assign
+  TraceObject(const TraceObject&) = delete;
+  void operator=(const TraceObject&) = delete;
+};
+
+/**
+ * Serializes trace events.
+ */
+class TraceWriter {
+ public:
+  TraceWriter() {}
+  virtual ~TraceWriter() {}
+  virtual void AppendTraceEvent(TraceObject* trace_event) = 0;
+  virtual void Flush() = 0;
+
+  /**
+   * Returns a writer that produces the JSON trace format understood by
+   * chrome://tracing.
+   */
+  static TraceWriter* CreateJSONTraceWriter(std::ostream& stream);
+
+ private:
+  // Disallow copy and assign
+  TraceWriter(const TraceWriter&) = delete;
+  void operator=(const TraceWriter&) = delete;
+};
+
+/**
+ * A fixed-size block of trace events. Slots are reserved with an atomic
+ * increment, so adding an event does not take a lock even if a recycled chunk
+ * is still filled by the thread it was handed out to before.
+ */
+class TraceBufferChunk {
+ public:
+  explicit TraceBufferChunk(uint32_t seq);
+
+  void Reset(uint32_t new_seq);
+  bool IsFull() const { return next_free_.load() >= kChunkSize; }
+  // Returns nullptr if the chunk is full.
+  TraceObject* AddTraceEvent(size_t* event_index);
+  TraceObject* GetEventAt(size_t index) { return &chunk_[index]; }
+  size_t size() const {
+    size_t next_free = next_free_.load();
+    return next_free < kChunkSize ? next_free : kChunkSize;
+  }
+  // Marks the chunk as full. Returns false if it was full already.
+  bool Seal() { return next_free_.exchange(kChunkSize) < kChunkSize; }
+
+  // The sequence number changes whenever the chunk is recycled. It is read by
+  // threads that update the duration of an event in a chunk they no longer
+  // own.
+  uint32_t seq() const { return seq_.load(std::memory_order_acquire); }
+
+  static const size_t kChunkSize = 64;
+
+ private:
+  std::atomic<size_t> next_free_;
+  TraceObject chunk_[kChunkSize];
+  std::atomic<uint32_t> seq_;
+
+  // Disallow copy and assign
+  TraceBufferChunk(const TraceBufferChunk&) = delete;
+  void operator=(const TraceBufferChunk&) = delete;
+};
+
+/**
+ * Storage for trace events.
+ */
+class TraceBuffer {
+ public:
+  TraceBuffer() {}
+  virtual ~TraceBuffer() {}
+
+  virtual TraceObject* AddTraceEvent(uint64_t* handle) = 0;
+  virtual TraceObject* GetEventByHandle(uint64_t handle) = 0;
+  // Updates the duration of the event identified by |handle|, unless its
+  // storage has been reused for other events in the meantime. The event may
+  // be in a chunk that another thread is recycling, so buffers that recycle
+  // storage have to synchronize this with handing out chunks.
+  virtual void UpdateEventDuration(uint64_t handle);
+  // Writes all recorded events to the trace writer. Must only be called when
+  // no events are added concurrently, i.e., after tracing has been stopped.
+  virtual bool Flush() = 0;
+
+  static const size_t kRingBufferChunks = 1024;
+
+  /**
+   * Returns a buffer that keeps the most recent |max_chunks| chunks of
+   * events. Every thread fills its own chunk without taking a lock; only
+   * handing out a new chunk is synchronized. A chunk is recycled as soon as
+   * its last slot is taken. If every chunk is still being filled, the chunk
+   * handed out first is recycled, so threads that exited or stopped
+   * recording cannot hold on to chunks.
+   */
+  static TraceBuffer* CreateTraceBufferRingBuffer(size_t max_chunks,
+                                                  TraceWriter* trace_writer);
+
+ private:
+  // Disallow copy and assign
+  TraceBuffer(const TraceBuffer&) = delete;
+  void operator=(const TraceBuffer&) = delete;
+};
+
+/**
+ * Selects the categories that are recorded.
+ */
+class TraceConfig {
+ public:
+  typedef std::vector<std::string> StringList;
+
+  static TraceConfig* CreateDefaultTraceConfig();
+
+  TraceConfig() {}
+  const StringList& GetEnabledCategories() const {
+    return included_categories_;
+  }
+  void AddIncludedCategory(const char* included_category);
+  // Adds all categories of a comma separated list.
+  void AddIncludedCategories(const char* included_categories);
+
+  // A category group is a comma separated list of categories. It is enabled
+  // if any of its categories is included.
+  bool IsCategoryGroupEnabled(const char* category_group) const;
+
+ private:
+  StringList included_categories_;
+
+  // Disallow copy and assign
+  TraceConfig(const TraceConfig&) = delete;
+  void operator=(const TraceConfig&) = delete;
+};
+
+/**
+ * Receives trace events from V8 through the platform and records them in a
+ * trace buffer. Install it with v8::platform::SetTracingController.
+ */
+class TracingController {
+ public:
+  enum Mode { DISABLED = 0, RECORDING_MODE };
+
+  // The pointer returned from GetCategoryGroupEnabledInternal() points to a
+  // value with zero or more of the following bits. Used in this class only.
+  // The TRACE_EVENT macros should only use the value as a bool.
+  enum CategoryGroupEnabledFlags {
+    // Category group enabled for the recording mode.
+    ENABLED_FOR_RECORDING = 1 << 0,
+  };
+
+  TracingController();
+  ~TracingController();
+
+  // Takes ownership of |trace_buffer|.
+  void Initialize(TraceBuffer* trace_buffer);
+
+  const uint8_t* GetCategoryGroupEnabled(const char* category_group);
+  static const char* GetCategoryGroupName(const uint8_t* category_enabled_flag);
+  uint64_t AddTraceEvent(char phase, const uint8_t* category_enabled_flag,
+                         const char* name, const char* scope, uint64_t id,
+                         uint64_t bind_id, int32_t num_args,
+                         const char** arg_names, const uint8_t* arg_types,
+                         const uint64_t* arg_values, unsigned int flags);
+  void UpdateTraceEventDuration(const uint8_t* category_enabled_flag,
+                                const char* name, uint64_t handle);
+
+  // Takes ownership of |trace_config|.
+  void StartTracing(TraceConfig* trace_config);
+  // Stops recording and writes all recorded events to the trace writer. The
+  // embedder has to make sure that no thread is still adding an event at this
+  // point, as the events are written without synchronization.
+  void StopTracing();
+
+ private:
+  const uint8_t* GetCategoryGroupEnabledInternal(const char* category_group);
+  void UpdateCategoryGroupEnabledFlag(size_t category_index);
+  void UpdateCategoryGroupEnabledFlags();
+
+  std::unique_ptr<TraceBuffer> trace_buffer_;
+  std::unique_ptr<TraceConfig> trace_config_;
+  std::unique_ptr<base::Mutex> mutex_;
+  Mode mode_ = DISABLED;
+
+  // Disallow copy and assign
+  TracingController(const TracingController&) = delete;
+  void operator=(const TracingController&) = delete;
+};
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
+
+#endif  // V8_LIBPLATFORM_V8_TRACING_H_
@@ -75,6 +75,17 @@ class Platform {
   virtual void CallOnBackgroundThread(Task* task,
                                       ExpectedRuntime expected_runtime) = 0;
 
+  /**
+   * Schedules a task to be invoked on a background thread after the given
+   * number of seconds |delay_in_seconds|. The Platform implementation takes
+   * ownership of |task|. The default implementation does not support delays
+   * and schedules the task right away.
+   */
+  virtual void CallDelayedOnBackgroundThread(Task* task,
+                                             double delay_in_seconds) {
+    CallOnBackgroundThread(task, kShortRunningTask);
+  }
+
   /**
    * Schedules a task to be invoked on a foreground thread wrt a specific
    * |isolate|. Tasks posted for the same isolate should be execute in order of
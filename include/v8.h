@@ -145,6 +145,7 @@ class FastAccessorBuilder;
 
 namespace internal {
 class Arguments;
+class ExternalResourceReleaser;
 class Heap;
 class HeapObject;
 class Isolate;
@@ -1373,6 +1374,17 @@ class V8_EXPORT ScriptCompiler {
    */
   static uint32_t CachedDataVersionTag();
 
+  /**
+   * Creates and returns code cache for the specified unbound_script, which
+   * may have been run already. With --serialize-optimized-code the cache
+   * also includes optimized code that does not depend on the context the
+   * script ran in, so that warm restarts do not need to re-optimize it.
+   * Returns NULL if the script cannot be serialized. The CachedData returned
+   * by this function is owned by the caller.
+   */
+  static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script,
+                                     Local<String> source);
+
   /**
    * Compile an ES6 module.
    *
@@ -2192,6 +2204,17 @@ class V8_EXPORT String : public Name {
 
     virtual bool IsCompressible() const { return false; }
 
+    /**
+     * Returns true if |Dispose| may be called on any thread, concurrently
+     * with the thread that uses the isolate and with calls to |Dispose| of
+     * other resources. V8 then may dispose the resource of a dead external
+     * string on a background thread instead of during the garbage collection
+     * pause (see --concurrent-external-release). |Dispose| must not call into
+     * V8 in that case. Resources that return false are always disposed on the
+     * thread that uses the isolate.
+     */
+    virtual bool IsDisposeThreadSafe() const { return false; }
+
    protected:
     ExternalStringResourceBase() {}
 
@@ -2199,7 +2222,9 @@ class V8_EXPORT String : public Name {
      * Internally V8 will call this Dispose method when the external string
      * resource is no longer needed. The default implementation will use the
      * delete operator. This method can be overridden in subclasses to
-     * control how allocated external string resources are disposed.
+     * control how allocated external string resources are disposed. Unless
+     * |IsDisposeThreadSafe| returns true, it is called on the thread that
+     * uses the isolate.
      */
     virtual void Dispose() { delete this; }
 
@@ -2208,6 +2233,7 @@ class V8_EXPORT String : public Name {
     ExternalStringResourceBase(const ExternalStringResourceBase&);
     void operator=(const ExternalStringResourceBase&);
 
+    friend class v8::internal::ExternalResourceReleaser;
     friend class v8::internal::Heap;
   };
 
@@ -3479,6 +3505,15 @@ class V8_EXPORT ArrayBuffer : public Object {
      * That memory is guaranteed to be previously allocated by |Allocate|.
      */
     virtual void Free(void* data, size_t length) = 0;
+
+    /**
+     * Returns true if |Free| may be called on any thread, concurrently with
+     * calls to |Allocate|, |AllocateUninitialized| and |Free| on other
+     * threads. V8 then may release the backing stores of dead array buffers
+     * on a background thread instead of during the garbage collection pause
+     * (see --concurrent-external-release).
+     */
+    virtual bool IsFreeThreadSafe() { return false; }
   };
 
   /**
@@ -3581,6 +3616,37 @@ class V8_EXPORT ArrayBuffer : public Object {
 };
 
 
+/**
+ * Compilation of WebAssembly modules from their wire bytes. The compiled code
+ * embeds the addresses of the memory and the globals of an instance, so a
+ * module is compiled when it is instantiated.
+ * This API is experimental and may change significantly.
+ */
+class V8_EXPORT WasmCompiledModule {
+ public:
+  /**
+   * Compiles and instantiates the module in |wire_bytes| and returns the
+   * object holding its exports. |ffi| and |memory| may be empty.
+   *
+   * With kProduceCodeCache, |*cached_data| is set to the serialized code of
+   * the module. The caller owns it and may use it to instantiate the same
+   * module later, also in another isolate. With kConsumeCodeCache, the code
+   * is deserialized from |*cached_data| instead. If the cached data does not
+   * match the module, the memory size or this version of V8, it is marked as
+   * rejected and the module is compiled from scratch.
+   */
+  static MaybeLocal<Object> Instantiate(
+      Local<Context> context, const uint8_t* wire_bytes, size_t length,
+      Local<Object> ffi, Local<ArrayBuffer> memory,
+      ScriptCompiler::CachedData** cached_data = nullptr,
+      ScriptCompiler::CompileOptions options =
+          ScriptCompiler::kNoCompileOptions);
+
+ private:
+  WasmCompiledModule();
+};
+
+
 #ifndef V8_ARRAY_BUFFER_VIEW_INTERNAL_FIELD_COUNT
 // The number of required internal fields can be defined by embedder.
 #define V8_ARRAY_BUFFER_VIEW_INTERNAL_FIELD_COUNT 2
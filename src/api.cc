@@ -56,6 +56,7 @@
 #include "src/runtime-profiler.h"
 #include "src/runtime/runtime.h"
 #include "src/simulator.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/snapshot/natives.h"
 #include "src/snapshot/snapshot.h"
 #include "src/startup-data-util.h"
@@ -65,6 +66,10 @@
 #include "src/v8threads.h"
 #include "src/version.h"
 #include "src/vm-state-inl.h"
+#include "src/wasm/module-decoder.h"
+#include "src/wasm/wasm-js.h"
+#include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-result.h"
 
 namespace v8 {
 
@@ -352,6 +357,7 @@ class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
   }
   virtual void* AllocateUninitialized(size_t length) { return malloc(length); }
   virtual void Free(void* data, size_t) { free(data); }
+  virtual bool IsFreeThreadSafe() { return true; }
 };
 
 bool RunExtraCode(Isolate* isolate, Local<Context> context,
@@ -2160,6 +2166,25 @@ uint32_t ScriptCompiler::CachedDataVersionTag() {
 }
 
 
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Local<UnboundScript> unbound_script, Local<String> source) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  LOG_API(isolate, "ScriptCompiler::CreateCodeCache");
+  if (!shared->is_toplevel() || !shared->script()->IsScript()) return NULL;
+  i::HandleScope scope(isolate);
+  i::ScriptData* script_data = i::CodeSerializer::Serialize(
+      isolate, shared, Utils::OpenHandle(*source));
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
 MaybeLocal<Script> Script::Compile(Local<Context> context, Local<String> source,
                                    ScriptOrigin* origin) {
   if (origin) {
@@ -6664,6 +6689,66 @@ MaybeLocal<Proxy> Proxy::New(Local<Context> context, Local<Object> local_target,
   RETURN_ESCAPED(result);
 }
 
+
+MaybeLocal<Object> WasmCompiledModule::Instantiate(
+    Local<Context> context, const uint8_t* wire_bytes, size_t length,
+    Local<Object> ffi, Local<ArrayBuffer> memory,
+    ScriptCompiler::CachedData** cached_data,
+    ScriptCompiler::CompileOptions options) {
+  PREPARE_FOR_EXECUTION(context, "WasmCompiledModule::Instantiate", Object);
+  if (options != ScriptCompiler::kProduceCodeCache &&
+      options != ScriptCompiler::kConsumeCodeCache) {
+    options = ScriptCompiler::kNoCompileOptions;
+  }
+  DCHECK(options == ScriptCompiler::kNoCompileOptions || cached_data);
+
+  i::ScriptData* script_data = NULL;
+  if (options == ScriptCompiler::kConsumeCodeCache) {
+    DCHECK(*cached_data);
+    // ScriptData takes care of pointer-aligning the data.
+    script_data =
+        new i::ScriptData((*cached_data)->data, (*cached_data)->length);
+  }
+
+  i::WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  i::Zone zone(isolate->allocator());
+  i::wasm::ModuleResult decoded = i::wasm::DecodeWasmModule(
+      isolate, &zone, wire_bytes, wire_bytes + length, false,
+      i::wasm::kWasmOrigin);
+  i::MaybeHandle<i::JSObject> instance;
+  if (decoded.failed()) {
+    i::wasm::ErrorThrower thrower(isolate, "WasmCompiledModule::Instantiate()");
+    thrower.Failed("", decoded);
+  } else {
+    i::Handle<i::JSReceiver> ffi_object;
+    if (!ffi.IsEmpty()) ffi_object = Utils::OpenHandle(*ffi);
+    i::Handle<i::JSArrayBuffer> memory_buffer;
+    if (!memory.IsEmpty()) memory_buffer = Utils::OpenHandle(*memory);
+    instance = decoded.val->Instantiate(isolate, ffi_object, memory_buffer,
+                                        &script_data, options);
+  }
+  if (decoded.val) delete decoded.val;
+
+  if (options == ScriptCompiler::kConsumeCodeCache) {
+    (*cached_data)->rejected = script_data->rejected();
+    delete script_data;
+  } else if (options == ScriptCompiler::kProduceCodeCache &&
+             script_data != NULL) {
+    // The cached data takes the ownership of the serialized code.
+    *cached_data =
+        new ScriptCompiler::CachedData(script_data->data(),
+                                       script_data->length(),
+                                       ScriptCompiler::CachedData::BufferOwned);
+    script_data->ReleaseDataOwnership();
+    delete script_data;
+  }
+
+  Local<Object> result;
+  has_pending_exception = !ToLocal<Object>(instance, &result);
+  RETURN_ON_FAILED_EXECUTION(Object);
+  RETURN_ESCAPED(result);
+}
+
 bool v8::ArrayBuffer::IsExternal() const {
   return Utils::OpenHandle(this)->is_external();
 }
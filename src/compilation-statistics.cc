@@ -44,6 +44,31 @@ void CompilationStatistics::RecordTotalStats(size_t source_size,
 }
 
 
+void CompilationStatistics::RecordSchedulingStats(size_t unscheduled_cycles,
+                                                  size_t scheduled_cycles) {
+  unscheduled_cycles_ += unscheduled_cycles;
+  scheduled_cycles_ += scheduled_cycles;
+}
+
+
+void CompilationStatistics::RecordLoopInvariantCodeMotionStats(
+    size_t hoisted_nodes) {
+  hoisted_nodes_ += hoisted_nodes;
+}
+
+
+void CompilationStatistics::RecordRegisterAllocationStats(bool greedy,
+                                                          bool high_pressure,
+                                                          size_t spills,
+                                                          size_t fills) {
+  RegisterAllocationStats& stats =
+      register_allocation_stats_[greedy][high_pressure];
+  stats.functions_++;
+  stats.spills_ += spills;
+  stats.fills_ += fills;
+}
+
+
 void CompilationStatistics::BasicStats::Accumulate(const BasicStats& stats) {
   delta_ += stats.delta_;
   total_allocated_bytes_ += stats.total_allocated_bytes_;
@@ -138,6 +163,51 @@ std::ostream& operator<<(std::ostream& os, const CompilationStatistics& s) {
   WriteFullLine(os);
   WriteLine(os, "totals", s.total_stats_, s.total_stats_);
 
+  if (s.unscheduled_cycles_ > 0) {
+    const size_t kBufferSize = 128;
+    char buffer[kBufferSize];
+    size_t saved_cycles = s.unscheduled_cycles_ > s.scheduled_cycles_
+                              ? s.unscheduled_cycles_ - s.scheduled_cycles_
+                              : 0;
+    double saved_percent = static_cast<double>(saved_cycles * 100) /
+                           static_cast<double>(s.unscheduled_cycles_);
+    base::OS::SNPrintF(buffer, kBufferSize,
+                       "%28s %10" PRIuS " -> %10" PRIuS
+                       " estimated cycles, %" PRIuS " saved (%5.1f%%)",
+                       "instruction scheduling", s.unscheduled_cycles_,
+                       s.scheduled_cycles_, saved_cycles, saved_percent);
+    os << buffer << std::endl;
+  }
+
+  if (s.hoisted_nodes_ > 0) {
+    const size_t kBufferSize = 128;
+    char buffer[kBufferSize];
+    base::OS::SNPrintF(buffer, kBufferSize, "%28s %10" PRIuS " hoisted nodes",
+                       "loop invariant code motion", s.hoisted_nodes_);
+    os << buffer << std::endl;
+  }
+
+  // Comparing the high pressure rows of a run with --turbo-greedy-regalloc
+  // and one without shows whether --turbo-select-regalloc pays off.
+  const char* allocator_names[2][2] = {
+      {"linear scan (low pressure)", "linear scan (high pressure)"},
+      {"greedy (low pressure)", "greedy (high pressure)"}};
+  for (int greedy = 0; greedy < 2; ++greedy) {
+    for (int high_pressure = 0; high_pressure < 2; ++high_pressure) {
+      const CompilationStatistics::RegisterAllocationStats& stats =
+          s.register_allocation_stats_[greedy][high_pressure];
+      if (stats.functions_ == 0) continue;
+      const size_t kBufferSize = 128;
+      char buffer[kBufferSize];
+      base::OS::SNPrintF(buffer, kBufferSize,
+                         "%28s %10" PRIuS " functions, %" PRIuS
+                         " spills, %" PRIuS " fills",
+                         allocator_names[greedy][high_pressure],
+                         stats.functions_, stats.spills_, stats.fills_);
+      os << buffer << std::endl;
+    }
+  }
+
   return os;
 }
 
@@ -18,7 +18,8 @@ class CompilationInfo;
 
 class CompilationStatistics final : public Malloced {
  public:
-  CompilationStatistics() {}
+  CompilationStatistics()
+      : unscheduled_cycles_(0), scheduled_cycles_(0), hoisted_nodes_(0) {}
 
   class BasicStats {
    public:
@@ -44,6 +45,22 @@ class CompilationStatistics final : public Malloced {
 
   void RecordTotalStats(size_t source_size, const BasicStats& stats);
 
+  // Record the estimated number of cycles of the generated code before and
+  // after instruction scheduling.
+  void RecordSchedulingStats(size_t unscheduled_cycles,
+                             size_t scheduled_cycles);
+
+  // Record the number of nodes moved out of loops by loop-invariant code
+  // motion.
+  void RecordLoopInvariantCodeMotionStats(size_t hoisted_nodes);
+
+  // Record the number of spill and fill moves in a function after register
+  // allocation with either the greedy or the linear scan allocator, split by
+  // whether the function has high register pressure, i.e. whether
+  // --turbo-select-regalloc would pick the greedy allocator for it.
+  void RecordRegisterAllocationStats(bool greedy, bool high_pressure,
+                                     size_t spills, size_t fills);
+
  private:
   class TotalStats : public BasicStats {
    public:
@@ -64,6 +81,14 @@ class CompilationStatistics final : public Malloced {
     std::string phase_kind_name_;
   };
 
+  class RegisterAllocationStats {
+   public:
+    RegisterAllocationStats() : functions_(0), spills_(0), fills_(0) {}
+    size_t functions_;
+    size_t spills_;
+    size_t fills_;
+  };
+
   friend std::ostream& operator<<(std::ostream& os,
                                   const CompilationStatistics& s);
 
@@ -74,6 +99,11 @@ class CompilationStatistics final : public Malloced {
   TotalStats total_stats_;
   PhaseKindMap phase_kind_map_;
   PhaseMap phase_map_;
+  size_t unscheduled_cycles_;
+  size_t scheduled_cycles_;
+  size_t hoisted_nodes_;
+  // Indexed by [greedy][high_pressure].
+  RegisterAllocationStats register_allocation_stats_[2][2];
 
   DISALLOW_COPY_AND_ASSIGN(CompilationStatistics);
 };
@@ -450,7 +450,7 @@ int CodeAndMetadataSize(CompilationInfo* info) {
     size += bytecode_array->BytecodeArraySize();
     size += bytecode_array->constant_pool()->Size();
     size += bytecode_array->handler_table()->Size();
-    size += bytecode_array->source_position_table()->Size();
+    size += bytecode_array->SourcePositionTable()->Size();
   } else {
     Handle<Code> code = info->code();
     size += code->CodeSize();
@@ -616,8 +616,14 @@ bool UseTurboFan(Handle<SharedFunctionInfo> shared) {
   // 3. Explicitly enabled by the command-line filter.
   bool passes_turbo_filter = shared->PassesFilter(FLAG_turbo_filter);
 
+  // 4. Interpreted functions, which TurboFan optimizes from their bytecode
+  //    and feedback without needing baseline code first.
+  bool is_optimizable_from_bytecode = FLAG_turbo_from_bytecode &&
+                                      shared->HasBytecodeArray() &&
+                                      !optimization_disabled;
+
   return is_turbofanable_asm || is_unsupported_by_crankshaft_but_turbofanable ||
-         passes_turbo_filter;
+         passes_turbo_filter || is_optimizable_from_bytecode;
 }
 
 bool GetOptimizedCodeNow(CompilationJob* job) {
@@ -664,6 +670,16 @@ bool GetOptimizedCodeLater(CompilationJob* job) {
     return false;
   }
 
+  if (info->is_osr() &&
+      !isolate->optimizing_compile_dispatcher()->IsOSRBufferAvailable()) {
+    if (FLAG_trace_osr) {
+      PrintF("[COSR - OSR buffer full, will retry optimizing ");
+      info->closure()->ShortPrint();
+      PrintF(" later]\n");
+    }
+    return false;
+  }
+
   // All handles below this point will be allocated in a deferred handle scope
   // that is detached and handed off to the background thread when we return.
   CompilationHandleScope handle_scope(info);
@@ -729,6 +745,14 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
 
   info->SetOptimizingForOsr(osr_ast_id, osr_frame);
 
+  // Functions of cached scripts may have their optimized code serialized with
+  // the script, which requires context-independent code with full reloc info.
+  if (FLAG_serialize_optimized_code && use_turbofan && osr_ast_id.IsNone() &&
+      shared->is_compiled() && shared->code()->kind() == Code::FUNCTION &&
+      shared->code()->has_reloc_info_for_serialization()) {
+    info->PrepareForSerializing();
+  }
+
   // Do not use Crankshaft/TurboFan if we need to be able to set break points.
   if (info->shared_info()->HasDebugInfo()) {
     info->AbortOptimization(kFunctionBeingDebugged);
@@ -764,6 +788,9 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   if (mode == Compiler::CONCURRENT) {
     if (GetOptimizedCodeLater(job.get())) {
       job.Detach();   // The background recompile job owns this now.
+      // OSR code is picked up by the loop once it is ready, there is nothing
+      // to install into the function in the meantime.
+      if (info->is_osr()) return MaybeHandle<Code>();
       return isolate->builtins()->InOptimizationQueue();
     }
   } else {
@@ -1213,6 +1240,42 @@ bool Compiler::CompileDebugCode(Handle<SharedFunctionInfo> shared) {
   return true;
 }
 
+bool Compiler::CollectSourcePositions(Handle<SharedFunctionInfo> shared) {
+  Isolate* isolate = shared->GetIsolate();
+  DCHECK(AllowCompilation::IsAllowed(isolate));
+  DCHECK(shared->HasBytecodeArray());
+  Handle<BytecodeArray> bytecode_array(shared->bytecode_array(), isolate);
+  if (bytecode_array->HasSourcePositionTable()) return true;
+
+  // Bytecode generation is deterministic, so regenerating the bytecode with
+  // source positions enabled yields a table matching the existing bytecode.
+  Zone zone(isolate->allocator());
+  ParseInfo parse_info(&zone, shared);
+  CompilationInfo info(&parse_info, Handle<JSFunction>::null());
+  info.MarkAsSourcePositionsEnabled();
+  if (!Compiler::ParseAndAnalyze(&parse_info) ||
+      !interpreter::Interpreter::MakeBytecode(&info)) {
+    isolate->clear_pending_exception();
+    return false;
+  }
+
+  // The bytecode can still differ if it was generated under different
+  // conditions, e.g. before the debugger disabled register optimizations.
+  // Positions would then be wrong, so settle for none at all.
+  Handle<BytecodeArray> regenerated = info.bytecode_array();
+  if (regenerated->length() != bytecode_array->length() ||
+      memcmp(regenerated->GetFirstBytecodeAddress(),
+             bytecode_array->GetFirstBytecodeAddress(),
+             bytecode_array->length()) != 0) {
+    bytecode_array->set_source_position_table(
+        isolate->heap()->empty_byte_array());
+    return false;
+  }
+  bytecode_array->set_source_position_table(
+      regenerated->source_position_table());
+  return true;
+}
+
 bool Compiler::CompileForLiveEdit(Handle<Script> script) {
   Isolate* isolate = script->GetIsolate();
   DCHECK(AllowCompilation::IsAllowed(isolate));
@@ -1657,10 +1720,57 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForNative(
 
 MaybeHandle<Code> Compiler::GetOptimizedCodeForOSR(Handle<JSFunction> function,
                                                    BailoutId osr_ast_id,
-                                                   JavaScriptFrame* osr_frame) {
+                                                   JavaScriptFrame* osr_frame,
+                                                   ConcurrencyMode mode) {
   DCHECK(!osr_ast_id.IsNone());
-  DCHECK_NOT_NULL(osr_frame);
-  return GetOptimizedCode(function, NOT_CONCURRENT, osr_ast_id, osr_frame);
+  // The frame is gone by the time a concurrent job runs, so concurrent OSR
+  // code is never specialized to it.
+  DCHECK_EQ(mode == NOT_CONCURRENT, osr_frame != nullptr);
+  return GetOptimizedCode(function, mode, osr_ast_id, osr_frame);
+}
+
+MaybeHandle<Code> Compiler::FinalizeOSRCompilationJob(CompilationJob* raw_job) {
+  // Take ownership of compilation job.  Deleting job also tears down the zone.
+  base::SmartPointer<CompilationJob> job(raw_job);
+  CompilationInfo* info = job->info();
+  Isolate* isolate = info->isolate();
+  DCHECK(info->is_osr());
+
+  VMState<COMPILER> state(isolate);
+  TimerEventScope<TimerEventRecompileSynchronous> timer(info->isolate());
+  TRACE_EVENT0("v8", "V8.RecompileSynchronous");
+
+  Handle<SharedFunctionInfo> shared = info->shared_info();
+  if (job->last_status() == CompilationJob::SUCCEEDED) {
+    if (shared->optimization_disabled()) {
+      job->RetryOptimization(kOptimizationDisabled);
+    } else if (info->dependencies()->HasAborted()) {
+      job->RetryOptimization(kBailedOutDueToDependencyChange);
+    } else if (job->GenerateCode() == CompilationJob::SUCCEEDED) {
+      job->RecordOptimizationStats();
+      RecordFunctionCompilation(Logger::LAZY_COMPILE_TAG, info);
+      if (shared->SearchOptimizedCodeMap(info->context()->native_context(),
+                                         info->osr_ast_id()).code == nullptr) {
+        InsertCodeIntoOptimizedCodeMap(info);
+      }
+      if (FLAG_trace_osr) {
+        PrintF("[COSR - completed optimizing ");
+        info->closure()->ShortPrint();
+        PrintF(" at AST id %d]\n", info->osr_ast_id().ToInt());
+      }
+      // The code handle lives in the job's deferred handles, which are torn
+      // down together with the job.
+      return handle(*info->code(), isolate);
+    }
+  }
+
+  DCHECK(job->last_status() != CompilationJob::SUCCEEDED);
+  if (FLAG_trace_osr) {
+    PrintF("[COSR - aborted optimizing ");
+    info->closure()->ShortPrint();
+    PrintF(" because: %s]\n", GetBailoutReason(info->bailout_reason()));
+  }
+  return MaybeHandle<Code>();
 }
 
 void Compiler::FinalizeCompilationJob(CompilationJob* raw_job) {
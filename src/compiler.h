@@ -50,6 +50,10 @@ class Compiler : public AllStatic {
   static bool CompileDebugCode(Handle<SharedFunctionInfo> shared);
   static bool CompileForLiveEdit(Handle<Script> script);
 
+  // Regenerates the source position table of bytecode that was compiled
+  // without one (see --lazy-source-positions) by reparsing the function.
+  static bool CollectSourcePositions(Handle<SharedFunctionInfo> shared);
+
   // Generate and install code from previously queued compilation job.
   static void FinalizeCompilationJob(CompilationJob* job);
 
@@ -115,9 +119,17 @@ class Compiler : public AllStatic {
   // instead of generating JIT code for a function at all.
 
   // Generate and return optimized code for OSR, or empty handle on failure.
+  // In {CONCURRENT} mode the job is queued and an empty handle is returned,
+  // the code is picked up later via {FinalizeOSRCompilationJob}.
   MUST_USE_RESULT static MaybeHandle<Code> GetOptimizedCodeForOSR(
       Handle<JSFunction> function, BailoutId osr_ast_id,
-      JavaScriptFrame* osr_frame);
+      JavaScriptFrame* osr_frame, ConcurrencyMode mode = NOT_CONCURRENT);
+
+  // Generate and return code from a finished concurrent OSR job, or empty
+  // handle on failure. Unlike {FinalizeCompilationJob} this does not install
+  // the code into the function.
+  MUST_USE_RESULT static MaybeHandle<Code> FinalizeOSRCompilationJob(
+      CompilationJob* job);
 };
 
 struct InlinedFunctionInfo {
@@ -562,7 +574,10 @@ class CompilationInfo final {
 class CompilationJob {
  public:
   explicit CompilationJob(CompilationInfo* info, const char* compiler_name)
-      : info_(info), compiler_name_(compiler_name), last_status_(SUCCEEDED) {}
+      : info_(info),
+        compiler_name_(compiler_name),
+        last_status_(SUCCEEDED),
+        awaiting_install_(false) {}
   virtual ~CompilationJob() {}
 
   enum Status { FAILED, SUCCEEDED };
@@ -573,6 +588,11 @@ class CompilationJob {
 
   Status last_status() const { return last_status_; }
   CompilationInfo* info() const { return info_; }
+
+  // Concurrent OSR jobs are not installed into their function. Once they are
+  // done on the background thread, they wait until their loop picks them up.
+  void WaitForInstall() { awaiting_install_ = true; }
+  bool IsWaitingForInstall() const { return awaiting_install_; }
   Isolate* isolate() const { return info()->isolate(); }
 
   Status RetryOptimization(BailoutReason reason) {
@@ -602,6 +622,7 @@ class CompilationJob {
   base::TimeDelta time_taken_to_codegen_;
   const char* compiler_name_;
   Status last_status_;
+  bool awaiting_install_;
 
   MUST_USE_RESULT Status SetLastStatus(Status status) {
     last_status_ = status;
@@ -0,0 +1,240 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/allocation-sinking.h"
+
+#include <algorithm>
+
+#include "src/compiler/all-nodes.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/node-properties.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// The maximum number of control nodes visited to classify the uses of a
+// single allocation region.
+const int kMaxControlWalk = 1000;
+
+}  // namespace
+
+AllocationSinking::AllocationSinking(Graph* graph, Zone* zone)
+    : graph_(graph),
+      zone_(zone),
+      sunk_count_(0),
+      branch_(nullptr),
+      if_true_(nullptr),
+      if_false_(nullptr),
+      budget_(0),
+      arm_of_(zone) {}
+
+void AllocationSinking::Run() {
+  NodeVector regions(zone());
+  AllNodes all(zone(), graph());
+  for (Node* node : all.live) {
+    if (node->opcode() == IrOpcode::kFinishRegion) regions.push_back(node);
+  }
+
+  // Sinking a region may make the region before it sinkable as well, since
+  // it is then directly followed by the branch, so iterate until nothing
+  // changes. Each region only ever moves deeper into the control flow.
+  bool changed;
+  do {
+    changed = false;
+    for (Node* finish : regions) {
+      if (TrySink(finish)) changed = true;
+    }
+  } while (changed);
+}
+
+bool AllocationSinking::TrySink(Node* finish) {
+  Node* const object = NodeProperties::GetValueInput(finish, 0);
+  if (object->opcode() != IrOpcode::kAllocate) return false;
+
+  // Collect the region, which must only allocate and initialize {object}.
+  NodeVector chain(zone());
+  Node* control = nullptr;
+  Node* node = NodeProperties::GetEffectInput(finish);
+  while (node->opcode() != IrOpcode::kBeginRegion) {
+    switch (node->opcode()) {
+      case IrOpcode::kAllocate:
+        if (node != object) return false;
+        break;
+      case IrOpcode::kStoreField:
+      case IrOpcode::kStoreElement:
+        if (NodeProperties::GetValueInput(node, 0) != object) return false;
+        break;
+      default:
+        return false;
+    }
+    Node* const node_control = NodeProperties::GetControlInput(node);
+    if (control == nullptr) control = node_control;
+    if (control != node_control) return false;
+    chain.push_back(node);
+    node = NodeProperties::GetEffectInput(node);
+  }
+  Node* const begin = node;
+  if (control == nullptr) return false;
+
+  // The region must be a linear effect chain, and {object} must not be used
+  // before the region is finished.
+  for (Edge edge : begin->use_edges()) {
+    if (NodeProperties::IsEffectEdge(edge) && edge.from() != chain.back()) {
+      return false;
+    }
+  }
+  for (Node* const region_node : chain) {
+    for (Edge edge : region_node->use_edges()) {
+      Node* const user = edge.from();
+      if (user == finish) continue;
+      if (std::find(chain.begin(), chain.end(), user) == chain.end()) {
+        return false;
+      }
+    }
+  }
+
+  // The region can only be sunk past the branch that directly follows it.
+  branch_ = FindBranch(control);
+  if (branch_ == nullptr) return false;
+  Node* projections[2];
+  NodeProperties::CollectControlProjections(branch_, projections, 2);
+  if_true_ = projections[0];
+  if_false_ = projections[1];
+  budget_ = kMaxControlWalk;
+  arm_of_.clear();
+
+  // All value uses of {object}, including frame states, must be in one arm.
+  Node* arm = nullptr;
+  for (Edge edge : finish->use_edges()) {
+    if (!NodeProperties::IsValueEdge(edge)) continue;
+    Node* const user_arm = ArmOfUse(edge.from(), edge.index());
+    if (user_arm == nullptr) return false;
+    if (arm != nullptr && arm != user_arm) return false;
+    arm = user_arm;
+  }
+  if (arm == nullptr) return false;
+
+  // The effect chain continues in both arms; the arm that receives the region
+  // must have a single entry for it.
+  ZoneVector<Edge> other_effect_edges(zone());
+  int arm_effect_count = 0;
+  for (Edge edge : finish->use_edges()) {
+    if (!NodeProperties::IsEffectEdge(edge)) continue;
+    Node* const user_arm = ArmOfUse(edge.from(), edge.index());
+    if (user_arm == nullptr) return false;
+    if (user_arm == arm) {
+      arm_effect_count++;
+    } else {
+      other_effect_edges.push_back(edge);
+    }
+  }
+  if (arm_effect_count != 1) return false;
+
+  // Remove the region from the effect chain of the other arm and pin it to
+  // the start of {arm}.
+  Node* const effect = NodeProperties::GetEffectInput(begin);
+  for (Edge edge : other_effect_edges) edge.UpdateTo(effect);
+  for (Node* const region_node : chain) {
+    NodeProperties::ReplaceControlInput(region_node, arm);
+  }
+  sunk_count_++;
+  return true;
+}
+
+// Returns the branch that directly follows {control}, if any.
+Node* AllocationSinking::FindBranch(Node* control) const {
+  Node* branch = nullptr;
+  for (Edge edge : control->use_edges()) {
+    if (!NodeProperties::IsControlEdge(edge)) continue;
+    Node* const user = edge.from();
+    if (user->opcode() != IrOpcode::kBranch) continue;
+    if (branch != nullptr) return nullptr;
+    branch = user;
+  }
+  return branch;
+}
+
+// Returns the projection of the current branch that dominates {node}, or
+// nullptr if there is none. Nodes without a control input are placed by the
+// scheduler based on their uses, so they are classified by their uses.
+Node* AllocationSinking::ArmOf(Node* node) {
+  auto it = arm_of_.find(node);
+  if (it != arm_of_.end()) return it->second;
+  // Guard against cycles through floating nodes.
+  arm_of_[node] = nullptr;
+
+  Node* arm = nullptr;
+  if (node->op()->ControlInputCount() > 0) {
+    arm = ArmOfControl(NodeProperties::GetControlInput(node));
+  } else {
+    for (Edge edge : node->use_edges()) {
+      Node* const user_arm = ArmOfUse(edge.from(), edge.index());
+      if (user_arm == nullptr || (arm != nullptr && arm != user_arm)) {
+        arm = nullptr;
+        break;
+      }
+      arm = user_arm;
+    }
+  }
+  arm_of_[node] = arm;
+  return arm;
+}
+
+// Returns the projection of the current branch that dominates the input
+// {index} of {user}. Inputs of phis are used at the end of the corresponding
+// predecessor of the merge.
+Node* AllocationSinking::ArmOfUse(Node* user, int index) {
+  switch (user->opcode()) {
+    case IrOpcode::kPhi:
+    case IrOpcode::kEffectPhi: {
+      Node* const merge = NodeProperties::GetControlInput(user);
+      if (index >= merge->InputCount()) return nullptr;
+      return ArmOfControl(merge->InputAt(index));
+    }
+    default:
+      return ArmOf(user);
+  }
+}
+
+// Returns the projection of the current branch that dominates {control}, or
+// nullptr if there is none.
+Node* AllocationSinking::ArmOfControl(Node* control) {
+  while (true) {
+    if (--budget_ < 0) return nullptr;
+    if (control == if_true_ || control == if_false_) return control;
+    if (control == branch_) return nullptr;
+    switch (control->opcode()) {
+      case IrOpcode::kMerge: {
+        // A merge is dominated by an arm if all of its predecessors are.
+        Node* arm = nullptr;
+        for (Node* const input : control->inputs()) {
+          Node* const input_arm = ArmOfControl(input);
+          if (input_arm == nullptr) return nullptr;
+          if (arm != nullptr && arm != input_arm) return nullptr;
+          arm = input_arm;
+        }
+        return arm;
+      }
+      case IrOpcode::kLoop:
+        // A loop is dominated by an arm if its entry is.
+        control = NodeProperties::GetControlInput(control, 0);
+        break;
+      case IrOpcode::kStart:
+      case IrOpcode::kEnd:
+      case IrOpcode::kDead:
+        return nullptr;
+      default:
+        if (control->op()->ControlInputCount() == 0) return nullptr;
+        control = NodeProperties::GetControlInput(control);
+        break;
+    }
+  }
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,72 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_ALLOCATION_SINKING_H_
+#define V8_COMPILER_ALLOCATION_SINKING_H_
+
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class Graph;
+class Node;
+
+// Sinks allocations that only escape on one side of a branch into that side.
+// Escape analysis removes allocations that never escape, but an object that
+// escapes on a rarely taken path, e.g. when it is passed to an error handler,
+// is still allocated eagerly on the fast path. An allocation region, i.e. a
+// BeginRegion, Allocate, initializing stores and FinishRegion chain, is moved
+// to the start of one arm of the branch that immediately follows it on the
+// effect chain if
+//  - the region contains nothing but the allocation and stores into it,
+//  - all uses of the allocated object, including frame states, are dominated
+//    by that arm, and
+//  - the arm has a single effect use of the region.
+// Sinking is repeated until nothing changes, so that consecutive allocations
+// end up next to each other in the arm, where the MemoryOptimizer can fold
+// them into a single allocation again.
+class AllocationSinking final {
+ public:
+  AllocationSinking(Graph* graph, Zone* zone);
+  ~AllocationSinking() {}
+
+  void Run();
+
+  // The number of allocation regions that were moved into a branch.
+  size_t sunk_count() const { return sunk_count_; }
+
+ private:
+  bool TrySink(Node* finish);
+  Node* FindBranch(Node* control) const;
+  Node* ArmOf(Node* node);
+  Node* ArmOfUse(Node* user, int index);
+  Node* ArmOfControl(Node* control);
+
+  Graph* graph() const { return graph_; }
+  Zone* zone() const { return zone_; }
+
+  Graph* const graph_;
+  Zone* const zone_;
+  size_t sunk_count_;
+  // The branch that the current region is sunk past, its projections and the
+  // number of control nodes that may still be visited to classify uses.
+  Node* branch_;
+  Node* if_true_;
+  Node* if_false_;
+  int budget_;
+  // The arm computed for each node visited while classifying the uses of one
+  // region, to stop the walk at shared uses, e.g. of frame states.
+  ZoneMap<Node*, Node*> arm_of_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSinking);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_ALLOCATION_SINKING_H_
@@ -0,0 +1,218 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/bounds-check-elimination.h"
+
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/types.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Limits the number of control and effect nodes visited to prove a single
+// check redundant.
+const int kMaxVisitedNodes = 100;
+
+// Looks through nodes that do not change the value of their input.
+Node* SkipIdentities(Node* node) {
+  while (true) {
+    switch (node->opcode()) {
+      case IrOpcode::kGuard:
+        node = NodeProperties::GetValueInput(node, 0);
+        break;
+      case IrOpcode::kNumberToInt32:
+      case IrOpcode::kNumberToUint32: {
+        Node* const input = NodeProperties::GetValueInput(node, 0);
+        Type* const type = node->opcode() == IrOpcode::kNumberToInt32
+                               ? Type::Signed32()
+                               : Type::Unsigned32();
+        if (!NodeProperties::IsTyped(input) ||
+            !NodeProperties::GetType(input)->Is(type)) {
+          return node;
+        }
+        node = input;
+        break;
+      }
+      default:
+        return node;
+    }
+  }
+}
+
+bool MaybeNaN(Node* node) {
+  return !NodeProperties::IsTyped(node) ||
+         NodeProperties::GetType(node)->Maybe(Type::NaN());
+}
+
+}  // namespace
+
+BoundsCheckElimination::BoundsCheckElimination(Editor* editor)
+    : AdvancedReducer(editor) {}
+
+Reduction BoundsCheckElimination::Reduce(Node* node) {
+  if (node->opcode() == IrOpcode::kDeoptimizeUnless) {
+    return ReduceDeoptimizeUnless(node);
+  }
+  return NoChange();
+}
+
+Reduction BoundsCheckElimination::ReduceDeoptimizeUnless(Node* node) {
+  Node* const condition = NodeProperties::GetValueInput(node, 0);
+  Node* const control = NodeProperties::GetControlInput(node);
+  switch (condition->opcode()) {
+    case IrOpcode::kNumberLessThan: {
+      Node* index = SkipIdentities(NodeProperties::GetValueInput(condition, 0));
+      Node* length = NodeProperties::GetValueInput(condition, 1);
+      int budget = kMaxVisitedNodes;
+      if (IsKnownInBounds(control, index, length, &budget)) {
+        return Replace(control);
+      }
+      break;
+    }
+    case IrOpcode::kNumberEqual: {
+      // A number that is not NaN is always equal to itself.
+      Node* lhs = SkipIdentities(NodeProperties::GetValueInput(condition, 0));
+      Node* rhs = SkipIdentities(NodeProperties::GetValueInput(condition, 1));
+      if (lhs == rhs && !MaybeNaN(lhs)) return Replace(control);
+      break;
+    }
+    default:
+      break;
+  }
+  return NoChange();
+}
+
+// Checks whether index < length holds on every control path that reaches
+// {control}. Gives up at loop headers, since the back edge would have to be
+// proven as well.
+bool BoundsCheckElimination::IsKnownInBounds(Node* control, Node* index,
+                                             Node* length, int* budget) {
+  while (true) {
+    if (--*budget < 0) return false;
+    switch (control->opcode()) {
+      case IrOpcode::kIfTrue:
+      case IrOpcode::kIfFalse: {
+        Node* const branch = NodeProperties::GetControlInput(control);
+        bool const is_true = control->opcode() == IrOpcode::kIfTrue;
+        if (ImpliesInBounds(NodeProperties::GetValueInput(branch, 0), is_true,
+                            index, length, budget)) {
+          return true;
+        }
+        control = NodeProperties::GetControlInput(branch);
+        break;
+      }
+      case IrOpcode::kDeoptimizeIf:
+      case IrOpcode::kDeoptimizeUnless: {
+        bool const is_true = control->opcode() == IrOpcode::kDeoptimizeUnless;
+        if (ImpliesInBounds(NodeProperties::GetValueInput(control, 0), is_true,
+                            index, length, budget)) {
+          return true;
+        }
+        control = NodeProperties::GetControlInput(control);
+        break;
+      }
+      case IrOpcode::kMerge: {
+        for (Node* const input : control->inputs()) {
+          if (!IsKnownInBounds(input, index, length, budget)) return false;
+        }
+        return true;
+      }
+      default: {
+        if (control->op()->ControlInputCount() != 1) return false;
+        control = NodeProperties::GetControlInput(control);
+        break;
+      }
+    }
+  }
+}
+
+// Checks whether {condition} having the value {is_true} implies that
+// index < length.
+bool BoundsCheckElimination::ImpliesInBounds(Node* condition, bool is_true,
+                                             Node* index, Node* length,
+                                             int* budget) {
+  switch (condition->opcode()) {
+    case IrOpcode::kNumberLessThan: {
+      // lhs < rhs
+      if (!is_true) return false;
+      Node* lhs = NodeProperties::GetValueInput(condition, 0);
+      Node* rhs = NodeProperties::GetValueInput(condition, 1);
+      return SkipIdentities(lhs) == index && IsSameLength(length, rhs, budget);
+    }
+    case IrOpcode::kNumberLessThanOrEqual: {
+      // !(lhs <= rhs) means rhs < lhs, unless one of them is NaN.
+      if (is_true) return false;
+      Node* lhs = NodeProperties::GetValueInput(condition, 0);
+      Node* rhs = NodeProperties::GetValueInput(condition, 1);
+      return SkipIdentities(rhs) == index && !MaybeNaN(index) &&
+             !MaybeNaN(lhs) && IsSameLength(length, lhs, budget);
+    }
+    default:
+      return false;
+  }
+}
+
+// Checks whether {length} has the same value as the dominating {other}, i.e.
+// whether it is the same node or a reload of the same field that is not
+// written in between.
+bool BoundsCheckElimination::IsSameLength(Node* length, Node* other,
+                                          int* budget) {
+  if (length == other) return true;
+  if (length->opcode() != IrOpcode::kLoadField ||
+      other->opcode() != IrOpcode::kLoadField) {
+    return false;
+  }
+  FieldAccess const& access = FieldAccessOf(length->op());
+  FieldAccess const& other_access = FieldAccessOf(other->op());
+  if (access.base_is_tagged != other_access.base_is_tagged ||
+      access.offset != other_access.offset ||
+      access.machine_type != other_access.machine_type) {
+    return false;
+  }
+  if (SkipIdentities(NodeProperties::GetValueInput(length, 0)) !=
+      SkipIdentities(NodeProperties::GetValueInput(other, 0))) {
+    return false;
+  }
+  return IsFieldUnchanged(NodeProperties::GetEffectInput(length), other,
+                          budget);
+}
+
+// Checks whether any effect path from {load} to {effect} may write to the
+// field that {load} reads.
+bool BoundsCheckElimination::IsFieldUnchanged(Node* effect, Node* load,
+                                              int* budget) {
+  int const offset = FieldAccessOf(load->op()).offset;
+  while (effect != load) {
+    if (--*budget < 0) return false;
+    switch (effect->opcode()) {
+      case IrOpcode::kEffectPhi: {
+        Node* const control = NodeProperties::GetControlInput(effect);
+        if (control->opcode() != IrOpcode::kMerge) return false;
+        for (int i = 0; i < effect->op()->EffectInputCount(); ++i) {
+          if (!IsFieldUnchanged(NodeProperties::GetEffectInput(effect, i),
+                                load, budget)) {
+            return false;
+          }
+        }
+        return true;
+      }
+      default:
+        if (effect->op()->EffectInputCount() != 1 ||
+            NodeProperties::MayWriteField(effect, offset)) {
+          return false;
+        }
+        break;
+    }
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  return true;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,44 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
+#define V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
+
+#include "src/compiler/graph-reducer.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Eliminates the checks that guard element accesses in the typed pipeline:
+//  - DeoptimizeUnless(NumberLessThan(index, length)) when a dominating branch
+//    or check already established index < length for the same length, which
+//    is the common case of a loop index that is bounded by the array length,
+//  - DeoptimizeUnless(NumberEqual(NumberToUint32(index), index)) when the
+//    type of the index, e.g. the range of an induction variable, is already
+//    an unsigned 32-bit integer.
+class BoundsCheckElimination final : public AdvancedReducer {
+ public:
+  explicit BoundsCheckElimination(Editor* editor);
+  ~BoundsCheckElimination() final {}
+
+  Reduction Reduce(Node* node) final;
+
+ private:
+  Reduction ReduceDeoptimizeUnless(Node* node);
+
+  bool IsKnownInBounds(Node* control, Node* index, Node* length, int* budget);
+  bool ImpliesInBounds(Node* condition, bool is_true, Node* index,
+                       Node* length, int* budget);
+  bool IsSameLength(Node* length, Node* other, int* budget);
+  bool IsFieldUnchanged(Node* effect, Node* load, int* budget);
+
+  DISALLOW_COPY_AND_ASSIGN(BoundsCheckElimination);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
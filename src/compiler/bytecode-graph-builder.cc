@@ -1306,6 +1306,45 @@ void BytecodeGraphBuilder::VisitReturn() {
   MergeControlToLeaveFunction(control);
 }
 
+void BytecodeGraphBuilder::VisitLdaZeroStar() {
+  Node* node = jsgraph()->ZeroConstant();
+  environment()->BindAccumulator(node);
+  environment()->BindRegister(bytecode_iterator().GetRegisterOperand(0), node);
+}
+
+void BytecodeGraphBuilder::VisitLdaUndefinedStar() {
+  Node* node = jsgraph()->UndefinedConstant();
+  environment()->BindAccumulator(node);
+  environment()->BindRegister(bytecode_iterator().GetRegisterOperand(0), node);
+}
+
+void BytecodeGraphBuilder::BuildTestEqualStrictJump(Node* comperand) {
+  // Strict equality cannot lazily deoptimize, so no frame states are needed
+  // between the test and the jump.
+  Node* left =
+      environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(1));
+  Node* right = environment()->LookupAccumulator();
+  Node* node = NewNode(javascript()->StrictEqual(), left, right);
+  environment()->BindAccumulator(node);
+  BuildJumpIfEqual(comperand);
+}
+
+void BytecodeGraphBuilder::VisitTestEqualStrictJumpIfTrue() {
+  BuildTestEqualStrictJump(jsgraph()->TrueConstant());
+}
+
+void BytecodeGraphBuilder::VisitTestEqualStrictJumpIfTrueConstant() {
+  BuildTestEqualStrictJump(jsgraph()->TrueConstant());
+}
+
+void BytecodeGraphBuilder::VisitTestEqualStrictJumpIfFalse() {
+  BuildTestEqualStrictJump(jsgraph()->FalseConstant());
+}
+
+void BytecodeGraphBuilder::VisitTestEqualStrictJumpIfFalseConstant() {
+  BuildTestEqualStrictJump(jsgraph()->FalseConstant());
+}
+
 void BytecodeGraphBuilder::VisitDebugger() {
   FrameStateBeforeAndAfter states(this);
   Node* call =
@@ -136,6 +136,7 @@ class BytecodeGraphBuilder {
   void BuildJumpIfEqual(Node* comperand);
   void BuildJumpIfToBooleanEqual(Node* boolean_comperand);
   void BuildJumpIfNotHole();
+  void BuildTestEqualStrictJump(Node* comperand);
 
   // Simulates control flow by forward-propagating environments.
   void MergeIntoSuccessorEnvironment(int target_offset);
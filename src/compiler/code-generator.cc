@@ -56,6 +56,7 @@ CodeGenerator::CodeGenerator(Frame* frame, Linkage* linkage,
   for (int i = 0; i < code->InstructionBlockCount(); ++i) {
     new (&labels_[i]) Label;
   }
+  if (info->will_serialize()) masm_.enable_serializer();
   CreateFrameAccessState(frame);
 }
 
@@ -207,6 +208,9 @@ Handle<Code> CodeGenerator::GenerateCode() {
   Handle<Code> result =
       v8::internal::CodeGenerator::MakeCodeEpilogue(masm(), info);
   result->set_is_turbofanned(true);
+  if (result->kind() == Code::OPTIMIZED_FUNCTION) {
+    result->set_has_reloc_info_for_serialization(info->will_serialize());
+  }
   result->set_stack_slots(frame()->GetTotalFrameSlotCount());
   result->set_safepoint_table_offset(safepoints()->GetCodeOffset());
 
@@ -132,7 +132,14 @@ class Frame : public ZoneObject {
 
  private:
   int AllocateAlignedFrameSlot(int width) {
-    DCHECK(width == 4 || width == 8);
+    DCHECK(width == 4 || width == 8 || width == 16);
+    if (width == 16) {
+      // 128-bit values occupy several slots and are addressed through the
+      // last one. They are accessed with unaligned moves, so no alignment is
+      // needed.
+      frame_slot_count_ += width / kPointerSize - 1;
+      return frame_slot_count_++;
+    }
     // Skip one slot if necessary.
     if (width > kPointerSize) {
       DCHECK(width == kPointerSize * 2);
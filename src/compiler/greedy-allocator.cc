@@ -17,6 +17,8 @@ namespace compiler {
 
 
 const float GreedyAllocator::kAllocatedRangeMultiplier = 10.0;
+const float GreedyAllocator::kLoopDepthMultiplier = 10.0;
+const int GreedyAllocator::kMaxLoopDepth = 4;
 
 
 namespace {
@@ -45,7 +47,8 @@ LiveRange* Split(LiveRange* range, RegisterAllocationData* data,
          (data->code()
               ->GetInstructionBlock(pos.ToInstructionIndex())
               ->last_instruction_index() != pos.ToInstructionIndex()));
-  LiveRange* result = range->SplitAt(pos, data->allocation_zone());
+  LiveRange* result =
+      range->SplitAt(pos, data->allocation_zone(range->kind()));
   return result;
 }
 
@@ -78,7 +81,33 @@ GreedyAllocator::GreedyAllocator(RegisterAllocationData* data,
       local_zone_(local_zone),
       allocations_(local_zone),
       scheduler_(local_zone),
-      groups_(local_zone) {}
+      groups_(local_zone),
+      loop_depths_(local_zone) {}
+
+
+void GreedyAllocator::ComputeLoopDepths() {
+  // Blocks are in RPO order, so the loops containing a block are exactly the
+  // loops whose header precedes it and whose end follows it.
+  ZoneVector<RpoNumber> loop_ends(local_zone());
+  loop_depths_.reserve(code()->InstructionBlockCount());
+  for (const InstructionBlock* block : code()->instruction_blocks()) {
+    while (!loop_ends.empty() && loop_ends.back() <= block->rpo_number()) {
+      loop_ends.pop_back();
+    }
+    if (block->IsLoopHeader()) loop_ends.push_back(block->loop_end());
+    loop_depths_.push_back(static_cast<int>(loop_ends.size()));
+  }
+}
+
+
+float GreedyAllocator::GetUseWeight(const UsePosition* pos) const {
+  const InstructionBlock* block =
+      code()->GetInstructionBlock(pos->pos().ToInstructionIndex());
+  int depth = Min(loop_depths_[block->rpo_number().ToSize()], kMaxLoopDepth);
+  float weight = pos->RegisterIsBeneficial() ? 1.0f : 0.5f;
+  for (int i = 0; i < depth; ++i) weight *= kLoopDepthMultiplier;
+  return weight;
+}
 
 
 void GreedyAllocator::AssignRangeToRegister(int reg_id, LiveRange* range) {
@@ -369,6 +398,7 @@ void GreedyAllocator::AllocateRegisters() {
         data()->debug_name());
 
   SplitAndSpillRangesDefinedByMemoryOperand(true);
+  ComputeLoopDepths();
   GroupLiveRanges();
   ScheduleAllocationCandidates();
   PreallocateFixedRanges();
@@ -466,11 +496,12 @@ void GreedyAllocator::EnsureValidRangeWeight(LiveRange* range) {
     return;
   }
 
-  float use_count = 0.0;
+  // Uses in loops are executed more often, so spilling them is more costly.
+  float use_weight = 0.0;
   for (auto pos = range->first_pos(); pos != nullptr; pos = pos->next()) {
-    ++use_count;
+    use_weight += GetUseWeight(pos);
   }
-  range->set_weight(use_count / static_cast<float>(range->GetSize()));
+  range->set_weight(use_weight / static_cast<float>(range->GetSize()));
 }
 
 
@@ -582,8 +613,26 @@ LifetimePosition GreedyAllocator::FindSplitPositionBeforeLoops(
 }
 
 
+bool GreedyAllocator::TrySpillUntilFirstRegisterUse(LiveRange* range) {
+  if (!range->CanBeSpilled(range->Start())) return false;
+  UsePosition* first_use = range->NextRegisterPosition(range->Start());
+  if (first_use == nullptr) return false;
+
+  LifetimePosition pos = FindOptimalSplitPos(range->Start(), first_use->pos());
+  pos = GetSplitPositionForInstruction(range, pos.ToInstructionIndex());
+  // Uses at the split position stay with the spilled part.
+  if (!pos.IsValid() || pos >= first_use->pos()) return false;
+
+  LiveRange* tail = Split(range, data(), pos);
+  Spill(range);
+  scheduler().Schedule(tail);
+  return true;
+}
+
+
 void GreedyAllocator::SplitOrSpillBlockedRange(LiveRange* range) {
   if (TrySplitAroundCalls(range)) return;
+  if (TrySpillUntilFirstRegisterUse(range)) return;
 
   LifetimePosition pos = FindSplitPositionBeforeLoops(range);
 
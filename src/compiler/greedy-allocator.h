@@ -88,6 +88,10 @@ class GreedyAllocator final : public RegisterAllocator {
 
  private:
   static const float kAllocatedRangeMultiplier;
+  // Each level of loop nesting makes a use this much more expensive to spill,
+  // up to kMaxLoopDepth levels.
+  static const float kLoopDepthMultiplier;
+  static const int kMaxLoopDepth;
 
   static void UpdateWeightAtAllocation(LiveRange* range) {
     DCHECK_NE(range->weight(), LiveRange::kInvalidWeight);
@@ -135,6 +139,12 @@ class GreedyAllocator final : public RegisterAllocator {
   // Calculate the weight of a candidate for allocation.
   void EnsureValidRangeWeight(LiveRange* range);
 
+  // Compute the loop nesting depth of each instruction block.
+  void ComputeLoopDepths();
+
+  // The contribution of a single use to the weight of its range.
+  float GetUseWeight(const UsePosition* pos) const;
+
   // Calculate the new weight of a range that is about to be allocated.
   float GetAllocatedRangeWeight(float candidate_weight);
 
@@ -159,6 +169,11 @@ class GreedyAllocator final : public RegisterAllocator {
   // were made, or false if no calls were found.
   bool TrySplitAroundCalls(LiveRange* range);
 
+  // If the range does not need a register at its start, spill it up to its
+  // first use that benefits from a register, and requeue the rest. Returns
+  // false if no such split is possible.
+  bool TrySpillUntilFirstRegisterUse(LiveRange* range);
+
   // Find a split position at the outmost loop.
   LifetimePosition FindSplitPositionBeforeLoops(LiveRange* range);
 
@@ -190,6 +205,10 @@ class GreedyAllocator final : public RegisterAllocator {
   ZoneVector<CoalescedLiveRanges*> allocations_;
   AllocationScheduler scheduler_;
   ZoneVector<LiveRangeGroup*> groups_;
+  // Loop nesting depth of each instruction block, indexed by RPO number.
+  ZoneVector<int> loop_depths_;
+
+  friend class GreedyAllocatorTest;
 
   DISALLOW_COPY_AND_ASSIGN(GreedyAllocator);
 };
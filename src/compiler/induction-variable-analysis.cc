@@ -0,0 +1,182 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/induction-variable-analysis.h"
+
+#include <cmath>
+
+#include "src/compiler/graph.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Looks through the ToNumber conversion that count operations like i++ apply
+// to their operand.
+Node* SkipToNumber(Node* node) {
+  if (node->opcode() == IrOpcode::kJSToNumber) {
+    return NodeProperties::GetValueInput(node, 0);
+  }
+  return node;
+}
+
+// Returns the integral constant that {node} adds to {phi} (or subtracts from
+// it), or 0 if {node} is not of that form.
+double GetStep(Node* node, Node* phi) {
+  switch (node->opcode()) {
+    case IrOpcode::kJSAdd:
+    case IrOpcode::kNumberAdd: {
+      Node* lhs = NodeProperties::GetValueInput(node, 0);
+      Node* rhs = NodeProperties::GetValueInput(node, 1);
+      if (SkipToNumber(rhs) == phi) std::swap(lhs, rhs);
+      NumberMatcher m(rhs);
+      if (SkipToNumber(lhs) == phi && m.HasValue()) return m.Value();
+      break;
+    }
+    case IrOpcode::kJSSubtract:
+    case IrOpcode::kNumberSubtract: {
+      Node* lhs = NodeProperties::GetValueInput(node, 0);
+      NumberMatcher m(NodeProperties::GetValueInput(node, 1));
+      if (SkipToNumber(lhs) == phi && m.HasValue()) return -m.Value();
+      break;
+    }
+    default:
+      break;
+  }
+  return 0.0;
+}
+
+}  // namespace
+
+InductionVariableAnalysis::InductionVariableAnalysis(Graph* graph, Zone* zone)
+    : graph_(graph), zone_(zone), induction_vars_(zone) {}
+
+void InductionVariableAnalysis::Run() {
+  LoopTree* loop_tree = LoopFinder::BuildLoopTree(graph(), zone());
+  for (LoopTree::Loop* loop : loop_tree->outer_loops()) {
+    VisitLoop(loop_tree, loop);
+  }
+}
+
+InductionVariable* InductionVariableAnalysis::Get(Node* phi) const {
+  auto it = induction_vars_.find(phi->id());
+  return it == induction_vars_.end() ? nullptr : it->second;
+}
+
+void InductionVariableAnalysis::VisitLoop(LoopTree* loop_tree,
+                                          LoopTree::Loop* loop) {
+  for (LoopTree::Loop* child : loop->children()) VisitLoop(loop_tree, child);
+
+  // Only loops with a single back edge are considered.
+  Node* header = loop_tree->HeaderNode(loop);
+  if (header->InputCount() != 2) return;
+  Node* condition = FindLoopTest(loop_tree, loop, header);
+  if (condition == nullptr) return;
+  for (Node* use : header->uses()) {
+    if (use->opcode() != IrOpcode::kPhi) continue;
+    InductionVariable* induction_var = TryGetInductionVariable(use, condition);
+    if (induction_var != nullptr) induction_vars_[use->id()] = induction_var;
+  }
+}
+
+// Finds the branch that the loop starts with and returns its condition, if the
+// loop is left when the condition is false and continued otherwise.
+Node* InductionVariableAnalysis::FindLoopTest(LoopTree* loop_tree,
+                                              LoopTree::Loop* loop,
+                                              Node* header) {
+  Node* control = header;
+  while (true) {
+    // Find the unique control successor of {control}.
+    Node* next = nullptr;
+    for (Edge edge : control->use_edges()) {
+      Node* const use = edge.from();
+      if (!NodeProperties::IsControlEdge(edge) ||
+          use->op()->ControlOutputCount() == 0 ||
+          use->opcode() == IrOpcode::kTerminate) {
+        continue;
+      }
+      if (next != nullptr) return nullptr;
+      next = use;
+    }
+    if (next == nullptr) return nullptr;
+    if (next->opcode() == IrOpcode::kBranch) {
+      Node* projections[2];
+      NodeProperties::CollectControlProjections(next, projections, 2);
+      Node* if_true = projections[0];
+      Node* if_false = projections[1];
+      if (!loop_tree->Contains(loop, if_true) ||
+          loop_tree->Contains(loop, if_false)) {
+        return nullptr;
+      }
+      return NodeProperties::GetValueInput(next, 0);
+    }
+    if (next->op()->ControlInputCount() != 1) return nullptr;
+    control = next;
+  }
+}
+
+InductionVariable* InductionVariableAnalysis::TryGetInductionVariable(
+    Node* phi, Node* condition) {
+  if (phi->op()->ValueInputCount() != 2) return nullptr;
+  Node* init = NodeProperties::GetValueInput(phi, 0);
+  Node* increment = NodeProperties::GetValueInput(phi, 1);
+  double step = GetStep(increment, phi);
+  if (step == 0.0 || std::isnan(step) || std::floor(step) != step) {
+    return nullptr;
+  }
+
+  bool is_less_than;
+  bool strict;
+  switch (condition->opcode()) {
+    case IrOpcode::kJSLessThan:
+    case IrOpcode::kNumberLessThan:
+      is_less_than = true;
+      strict = true;
+      break;
+    case IrOpcode::kJSLessThanOrEqual:
+    case IrOpcode::kNumberLessThanOrEqual:
+      is_less_than = true;
+      strict = false;
+      break;
+    case IrOpcode::kJSGreaterThan:
+      is_less_than = false;
+      strict = true;
+      break;
+    case IrOpcode::kJSGreaterThanOrEqual:
+      is_less_than = false;
+      strict = false;
+      break;
+    default:
+      return nullptr;
+  }
+
+  // Normalize the condition to phi < bound (or phi <= bound) for an upper
+  // bound, and phi > bound (or phi >= bound) for a lower bound.
+  Node* lhs = NodeProperties::GetValueInput(condition, 0);
+  Node* rhs = NodeProperties::GetValueInput(condition, 1);
+  bool is_upper_bound;
+  Node* bound;
+  if (lhs == phi) {
+    is_upper_bound = is_less_than;
+    bound = rhs;
+  } else if (rhs == phi) {
+    is_upper_bound = !is_less_than;
+    bound = lhs;
+  } else {
+    return nullptr;
+  }
+
+  // The loop test must bound the phi in the direction in which it moves.
+  if (is_upper_bound != (step > 0)) return nullptr;
+  return new (zone()) InductionVariable(phi, init, bound, step, strict);
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
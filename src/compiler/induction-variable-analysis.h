@@ -0,0 +1,85 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_INDUCTION_VARIABLE_ANALYSIS_H_
+#define V8_COMPILER_INDUCTION_VARIABLE_ANALYSIS_H_
+
+#include "src/compiler/loop-analysis.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class Graph;
+class Node;
+
+// NodeIds are identifying numbers for nodes that can be used to index auxiliary
+// out-of-line data associated with each node.
+typedef uint32_t NodeId;
+
+// A basic induction variable, i.e. a loop phi that starts at {init} and is
+// changed by the constant {step} on the back edge of its loop, whose loop is
+// only continued while the phi is below (for a positive {step}) or above (for a
+// negative {step}) the {bound}.
+class InductionVariable final : public ZoneObject {
+ public:
+  InductionVariable(Node* phi, Node* init, Node* bound, double step,
+                    bool strict)
+      : phi_(phi), init_(init), bound_(bound), step_(step), strict_(strict) {}
+
+  Node* phi() const { return phi_; }
+  Node* init() const { return init_; }
+  Node* bound() const { return bound_; }
+  double step() const { return step_; }
+  // Whether the loop test excludes the {bound} itself, i.e. whether it is
+  // phi < bound rather than phi <= bound (or the analog for a negative step).
+  bool strict() const { return strict_; }
+
+ private:
+  Node* const phi_;
+  Node* const init_;
+  Node* const bound_;
+  double const step_;
+  bool const strict_;
+};
+
+// Finds the basic induction variables of all loops in a graph. The analysis is
+// purely structural; the typer combines the result with the types of {init}
+// and {bound} to compute the range of each induction variable.
+class InductionVariableAnalysis final {
+ public:
+  InductionVariableAnalysis(Graph* graph, Zone* zone);
+  ~InductionVariableAnalysis() {}
+
+  void Run();
+
+  // Returns the induction variable for the given phi, or nullptr.
+  InductionVariable* Get(Node* phi) const;
+
+  const ZoneMap<NodeId, InductionVariable*>& induction_variables() const {
+    return induction_vars_;
+  }
+
+ private:
+  void VisitLoop(LoopTree* loop_tree, LoopTree::Loop* loop);
+  Node* FindLoopTest(LoopTree* loop_tree, LoopTree::Loop* loop, Node* header);
+  InductionVariable* TryGetInductionVariable(Node* phi, Node* condition);
+
+  Graph* graph() const { return graph_; }
+  Zone* zone() const { return zone_; }
+
+  Graph* const graph_;
+  Zone* const zone_;
+  ZoneMap<NodeId, InductionVariable*> induction_vars_;
+
+  DISALLOW_COPY_AND_ASSIGN(InductionVariableAnalysis);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_INDUCTION_VARIABLE_ANALYSIS_H_
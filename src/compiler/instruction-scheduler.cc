@@ -4,8 +4,11 @@
 
 #include "src/compiler/instruction-scheduler.h"
 
+#include <algorithm>
+
 #include "src/base/adapters.h"
 #include "src/base/utils/random-number-generator.h"
+#include "src/register-configuration.h"
 
 namespace v8 {
 namespace internal {
@@ -15,6 +18,11 @@ namespace compiler {
 // node2 (i.e. node1 should be scheduled before node2).
 bool InstructionScheduler::CriticalPathFirstQueue::CompareNodes(
     ScheduleGraphNode *node1, ScheduleGraphNode *node2) const {
+  if (scheduler_->IsRegisterPressureHigh()) {
+    int delta1 = node1->RegisterPressureDelta();
+    int delta2 = node2->RegisterPressureDelta();
+    if (delta1 != delta2) return delta1 < delta2;
+  }
   return node1->total_latency() > node2->total_latency();
 }
 
@@ -61,6 +69,7 @@ InstructionScheduler::ScheduleGraphNode::ScheduleGraphNode(
     Instruction* instr)
     : instr_(instr),
       successors_(zone),
+      used_values_(zone),
       unscheduled_predecessors_count_(0),
       latency_(GetInstructionLatency(instr)),
       total_latency_(-1),
@@ -75,6 +84,33 @@ void InstructionScheduler::ScheduleGraphNode::AddSuccessor(
 }
 
 
+void InstructionScheduler::ScheduleGraphNode::AddOperandUser(
+    ScheduleGraphNode* node) {
+  node->AddUse(&defined_value_);
+}
+
+
+void InstructionScheduler::ScheduleGraphNode::AddUse(LiveValue* value) {
+  if (std::find(used_values_.begin(), used_values_.end(), value) !=
+      used_values_.end()) {
+    return;
+  }
+  used_values_.push_back(value);
+  value->AddUser();
+}
+
+
+int InstructionScheduler::ScheduleGraphNode::RegisterPressureDelta() const {
+  // The value defined by this instruction becomes live if it has users in
+  // this block, and the values for which this is the last user die.
+  int delta = (defined_value_.unscheduled_users() > 0) ? 1 : 0;
+  for (LiveValue* value : used_values_) {
+    if (value->unscheduled_users() == 1) delta--;
+  }
+  return delta;
+}
+
+
 InstructionScheduler::InstructionScheduler(Zone* zone,
                                            InstructionSequence* sequence)
     : zone_(zone),
@@ -83,7 +119,15 @@ InstructionScheduler::InstructionScheduler(Zone* zone,
       last_side_effect_instr_(nullptr),
       pending_loads_(zone),
       last_live_in_reg_marker_(nullptr),
-      last_deopt_(nullptr) {
+      last_deopt_(nullptr),
+      defined_vregs_(zone),
+      live_in_values_(zone),
+      live_values_(0),
+      max_live_values_(
+          RegisterConfiguration::ArchDefault(RegisterConfiguration::TURBOFAN)
+              ->num_allocatable_general_registers()),
+      unscheduled_cycles_(0),
+      scheduled_cycles_(0) {
 }
 
 
@@ -93,6 +137,9 @@ void InstructionScheduler::StartBlock(RpoNumber rpo) {
   DCHECK(pending_loads_.empty());
   DCHECK(last_live_in_reg_marker_ == nullptr);
   DCHECK(last_deopt_ == nullptr);
+  DCHECK(defined_vregs_.empty());
+  DCHECK(live_in_values_.empty());
+  DCHECK_EQ(0, live_values_);
   sequence()->StartBlock(rpo);
 }
 
@@ -109,6 +156,9 @@ void InstructionScheduler::EndBlock(RpoNumber rpo) {
   pending_loads_.clear();
   last_live_in_reg_marker_ = nullptr;
   last_deopt_ = nullptr;
+  defined_vregs_.clear();
+  live_in_values_.clear();
+  live_values_ = 0;
 }
 
 
@@ -168,14 +218,48 @@ void InstructionScheduler::AddInstruction(Instruction* instr) {
     for (ScheduleGraphNode* node : graph_) {
       if (HasOperandDependency(node->instruction(), instr)) {
         node->AddSuccessor(new_node);
+        node->AddOperandUser(new_node);
       }
     }
+    AddLiveInUses(new_node);
+  }
+
+  for (size_t i = 0; i < instr->OutputCount(); ++i) {
+    const InstructionOperand* output = instr->OutputAt(i);
+    if (output->IsUnallocated()) {
+      defined_vregs_.insert(
+          UnallocatedOperand::cast(output)->virtual_register());
+    } else if (output->IsConstant()) {
+      defined_vregs_.insert(ConstantOperand::cast(output)->virtual_register());
+    }
   }
 
   graph_.push_back(new_node);
 }
 
 
+void InstructionScheduler::AddLiveInUses(ScheduleGraphNode* node) {
+  Instruction* instr = node->instruction();
+  for (size_t i = 0; i < instr->InputCount(); ++i) {
+    const InstructionOperand* input = instr->InputAt(i);
+    if (!input->IsUnallocated()) continue;
+    int vreg = UnallocatedOperand::cast(input)->virtual_register();
+    if (defined_vregs_.count(vreg) != 0) continue;
+    LiveValue*& value = live_in_values_[vreg];
+    if (value == nullptr) value = new (zone()) LiveValue();
+    node->AddUse(value);
+  }
+}
+
+
+void InstructionScheduler::UpdateLiveValues(ScheduleGraphNode* node) {
+  live_values_ += node->RegisterPressureDelta();
+  for (LiveValue* value : node->used_values()) {
+    value->DropUser();
+  }
+}
+
+
 template <typename QueueType>
 void InstructionScheduler::ScheduleBlock() {
   QueueType ready_list(this);
@@ -183,6 +267,9 @@ void InstructionScheduler::ScheduleBlock() {
   // Compute total latencies so that we can schedule the critical path first.
   ComputeTotalLatencies();
 
+  if (FLAG_turbo_stats) unscheduled_cycles_ += ComputeUnscheduledCycles();
+  StartTrackingLiveValues();
+
   // Add nodes which don't have dependencies to the ready list.
   for (ScheduleGraphNode* node : graph_) {
     if (!node->HasUnscheduledPredecessor()) {
@@ -192,11 +279,15 @@ void InstructionScheduler::ScheduleBlock() {
 
   // Go through the ready list and schedule the instructions.
   int cycle = 0;
+  int end_cycle = 0;
   while (!ready_list.IsEmpty()) {
     ScheduleGraphNode* candidate = ready_list.PopBestCandidate(cycle);
 
     if (candidate != nullptr) {
       sequence()->AddInstruction(candidate->instruction());
+      end_cycle = std::max(end_cycle, cycle + candidate->latency());
+
+      UpdateLiveValues(candidate);
 
       for (ScheduleGraphNode* successor : candidate->successors()) {
         successor->DropUnscheduledPredecessor();
@@ -212,6 +303,8 @@ void InstructionScheduler::ScheduleBlock() {
 
     cycle++;
   }
+
+  if (FLAG_turbo_stats) scheduled_cycles_ += end_cycle;
 }
 
 
@@ -341,6 +434,28 @@ void InstructionScheduler::ComputeTotalLatencies() {
   }
 }
 
+
+int InstructionScheduler::ComputeUnscheduledCycles() {
+  // Issue at most one instruction per cycle, in the original order, and stall
+  // until the operands of the next instruction are available. The start
+  // cycles computed here are reset before the block is actually scheduled.
+  int cycle = 0;
+  int end_cycle = 0;
+  for (ScheduleGraphNode* node : graph_) {
+    cycle = std::max(cycle, node->start_cycle());
+    end_cycle = std::max(end_cycle, cycle + node->latency());
+    for (ScheduleGraphNode* successor : node->successors()) {
+      successor->set_start_cycle(
+          std::max(successor->start_cycle(), cycle + node->latency()));
+    }
+    cycle++;
+  }
+  for (ScheduleGraphNode* node : graph_) {
+    node->set_start_cycle(-1);
+  }
+  return end_cycle;
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
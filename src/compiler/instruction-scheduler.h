@@ -35,7 +35,33 @@ class InstructionScheduler final : public ZoneObject {
 
   static bool SchedulerSupported();
 
+  // Estimated number of cycles needed to execute the scheduled blocks in
+  // their original and in their scheduled instruction order. These are only
+  // computed with --turbo-stats.
+  size_t unscheduled_cycles() const { return unscheduled_cycles_; }
+  size_t scheduled_cycles() const { return scheduled_cycles_; }
+
  private:
+  friend class InstructionSchedulerTest;
+
+  // A value used in the current block, either defined by an instruction of
+  // the block or live on entry to it. It is considered live until its last
+  // user in the block has been scheduled.
+  class LiveValue : public ZoneObject {
+   public:
+    LiveValue() : unscheduled_users_count_(0) {}
+
+    void AddUser() { unscheduled_users_count_++; }
+    void DropUser() {
+      DCHECK(unscheduled_users_count_ > 0);
+      unscheduled_users_count_--;
+    }
+    int unscheduled_users() const { return unscheduled_users_count_; }
+
+   private:
+    int unscheduled_users_count_;
+  };
+
   // A scheduling graph node.
   // Represent an instruction and their dependencies.
   class ScheduleGraphNode: public ZoneObject {
@@ -47,6 +73,12 @@ class InstructionScheduler final : public ZoneObject {
     // of 'node' (i.e. it must be scheduled before 'node').
     void AddSuccessor(ScheduleGraphNode* node);
 
+    // Record that 'node' uses the value defined by this instruction.
+    void AddOperandUser(ScheduleGraphNode* node);
+
+    // Record that this instruction uses 'value'.
+    void AddUse(LiveValue* value);
+
     // Check if all the predecessors of this instruction have been scheduled.
     bool HasUnscheduledPredecessor() {
       return unscheduled_predecessors_count_ != 0;
@@ -60,6 +92,7 @@ class InstructionScheduler final : public ZoneObject {
 
     Instruction* instruction() { return instr_; }
     ZoneDeque<ScheduleGraphNode*>& successors() { return successors_; }
+    ZoneDeque<LiveValue*>& used_values() { return used_values_; }
     int latency() const { return latency_; }
 
     int total_latency() const { return total_latency_; }
@@ -68,10 +101,21 @@ class InstructionScheduler final : public ZoneObject {
     int start_cycle() const { return start_cycle_; }
     void set_start_cycle(int start_cycle) { start_cycle_ = start_cycle; }
 
+    // Estimate of the change in the number of live values in this block when
+    // this instruction is scheduled next.
+    int RegisterPressureDelta() const;
+
    private:
     Instruction* instr_;
     ZoneDeque<ScheduleGraphNode*> successors_;
 
+    // The values used by this instruction, each recorded once.
+    ZoneDeque<LiveValue*> used_values_;
+
+    // The value defined by this instruction. Values without users in the
+    // block are not tracked.
+    LiveValue defined_value_;
+
     // Number of unscheduled predecessors for this node.
     int unscheduled_predecessors_count_;
 
@@ -116,7 +160,9 @@ class InstructionScheduler final : public ZoneObject {
 
   // A scheduling queue which prioritize nodes on the critical path (we look
   // for the instruction with the highest latency on the path to reach the end
-  // of the graph).
+  // of the graph). Once the number of live values reaches the number of
+  // allocatable registers, nodes which do not increase the register pressure
+  // are preferred so that the scheduler does not introduce spills.
   class CriticalPathFirstQueue : public SchedulingQueueBase  {
    public:
     explicit CriticalPathFirstQueue(InstructionScheduler* scheduler)
@@ -187,6 +233,28 @@ class InstructionScheduler final : public ZoneObject {
 
   void ComputeTotalLatencies();
 
+  // Estimate the number of cycles needed to execute the current block in its
+  // original instruction order.
+  int ComputeUnscheduledCycles();
+
+  // Record the uses of values which are live on entry to the block.
+  void AddLiveInUses(ScheduleGraphNode* node);
+
+  // All values live on entry to the block are live before the first
+  // instruction is scheduled.
+  void StartTrackingLiveValues() {
+    live_values_ = static_cast<int>(live_in_values_.size());
+  }
+
+  // Update the number of live values after 'node' has been scheduled.
+  void UpdateLiveValues(ScheduleGraphNode* node);
+
+  // Return true if the values live at the current scheduling point already
+  // occupy all allocatable registers.
+  bool IsRegisterPressureHigh() const {
+    return live_values_ >= max_live_values_;
+  }
+
   static int GetInstructionLatency(const Instruction* instr);
 
   Zone* zone() { return zone_; }
@@ -214,6 +282,20 @@ class InstructionScheduler final : public ZoneObject {
 
   // Last deoptimization instruction encountered while building the graph.
   ScheduleGraphNode* last_deopt_;
+
+  // Virtual registers defined in the current block, and the values used but
+  // not defined in it, by virtual register.
+  ZoneSet<int> defined_vregs_;
+  ZoneMap<int, LiveValue*> live_in_values_;
+
+  // Number of values which are still used by unscheduled instructions of the
+  // current block, and the number of values above which the scheduler starts
+  // to avoid increasing the register pressure.
+  int live_values_;
+  const int max_live_values_;
+
+  size_t unscheduled_cycles_;
+  size_t scheduled_cycles_;
 };
 
 }  // namespace compiler
@@ -48,13 +48,17 @@ class InstructionSelector final {
   class Features;
 
   enum SourcePositionMode { kCallSourcePositions, kAllSourcePositions };
+  enum EnableScheduling { kDisableScheduling, kEnableScheduling };
 
   InstructionSelector(
       Zone* zone, size_t node_count, Linkage* linkage,
       InstructionSequence* sequence, Schedule* schedule,
       SourcePositionTable* source_positions, Frame* frame,
       SourcePositionMode source_position_mode = kCallSourcePositions,
-      Features features = SupportedFeatures());
+      Features features = SupportedFeatures(),
+      EnableScheduling enable_scheduling = FLAG_turbo_instruction_scheduling
+                                               ? kEnableScheduling
+                                               : kDisableScheduling);
 
   // Visit code for the entire graph with the included schedule.
   void SelectInstructions();
@@ -63,6 +67,10 @@ class InstructionSelector final {
   void EndBlock(RpoNumber rpo);
   void AddInstruction(Instruction* instr);
 
+  // The instruction scheduler used for the selected code, or nullptr if
+  // instruction scheduling is disabled.
+  const InstructionScheduler* scheduler() const { return scheduler_; }
+
   // ===========================================================================
   // ============= Architecture-independent code emission methods. =============
   // ===========================================================================
@@ -200,6 +208,9 @@ class InstructionSelector final {
   void MarkAsFloat64(Node* node) {
     MarkAsRepresentation(MachineRepresentation::kFloat64, node);
   }
+  void MarkAsSimd128(Node* node) {
+    MarkAsRepresentation(MachineRepresentation::kSimd128, node);
+  }
   void MarkAsReference(Node* node) {
     MarkAsRepresentation(MachineRepresentation::kTagged, node);
   }
@@ -246,6 +257,14 @@ class InstructionSelector final {
   MACHINE_OP_LIST(DECLARE_GENERATOR)
 #undef DECLARE_GENERATOR
 
+  // SIMD operations that are selected for the SLP vectorizer.
+  void VisitFloat32x4Add(Node* node);
+  void VisitFloat32x4Sub(Node* node);
+  void VisitFloat32x4Mul(Node* node);
+  void VisitFloat32x4Div(Node* node);
+  void VisitInt32x4Add(Node* node);
+  void VisitInt32x4Sub(Node* node);
+
   void VisitFinishRegion(Node* node);
   void VisitGuard(Node* node);
   void VisitParameter(Node* node);
@@ -291,6 +310,7 @@ class InstructionSelector final {
   BoolVector used_;
   IntVector effect_level_;
   IntVector virtual_registers_;
+  EnableScheduling enable_scheduling_;
   InstructionScheduler* scheduler_;
   Frame* frame_;
 };
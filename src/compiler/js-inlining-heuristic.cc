@@ -5,13 +5,32 @@
 #include "src/compiler/js-inlining-heuristic.h"
 
 #include "src/compiler.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/js-graph.h"
 #include "src/compiler/node-matchers.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+// Checks whether {node} is nested more than the maximum allowed number of
+// levels deep into inlined functions.
+bool ExceedsMaxInliningLevel(Node* node) {
+  int level = 0;
+  for (Node* frame_state = NodeProperties::GetFrameStateInput(node, 0);
+       frame_state->opcode() == IrOpcode::kFrameState;
+       frame_state = NodeProperties::GetFrameStateInput(frame_state, 0)) {
+    if (++level > FLAG_max_inlining_levels) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (!IrOpcode::IsInlineeOpcode(node->opcode())) return NoChange();
 
@@ -19,7 +38,50 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (seen_.find(node->id()) != seen_.end()) return NoChange();
   seen_.insert(node->id());
 
+  // Calls through a phi of known functions, e.g. a polymorphic method load,
+  // dispatch on the target and inline every function individually.
   Node* callee = node->InputAt(0);
+  if (callee->opcode() == IrOpcode::kPhi) {
+    if (!FLAG_turbo_polymorphic_inlining) return NoChange();
+    if (mode_ != kGeneralInlining) return NoChange();
+    // Stop inlinining once the maximum allowed level is reached.
+    if (ExceedsMaxInliningLevel(node)) return NoChange();
+    // Only plain calls are dispatched. Constructor calls pass the target as
+    // new.target too, which the dispatch would have to rewire per branch.
+    if (node->opcode() != IrOpcode::kJSCallFunction) return NoChange();
+    int const value_input_count = callee->op()->ValueInputCount();
+    if (value_input_count > kMaxCallPolymorphism) return NoChange();
+    Candidate candidate;
+    candidate.num_functions = 0;
+    candidate.node = node;
+    candidate.size = 0;
+    for (int i = 0; i < value_input_count; ++i) {
+      HeapObjectMatcher match(callee->InputAt(i));
+      if (!match.HasValue() || !match.Value()->IsJSFunction()) {
+        return NoChange();
+      }
+      Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
+      // The same function may flow in through several phi inputs.
+      bool duplicate = false;
+      for (int j = 0; j < candidate.num_functions; ++j) {
+        if (candidate.functions[j].is_identical_to(function)) duplicate = true;
+      }
+      if (duplicate) continue;
+      if (!CanInlineFunction(function)) return NoChange();
+      candidate.functions[candidate.num_functions++] = function;
+      candidate.size += function->shared()->ast_node_count();
+    }
+    if (candidate.num_functions < 2) return NoChange();
+    CallFunctionParameters p = CallFunctionParametersOf(node->op());
+    candidate.calls = -1;  // Same default as CallICNexus::ExtractCallCount.
+    if (p.feedback().IsValid()) {
+      CallICNexus nexus(p.feedback().vector(), p.feedback().slot());
+      candidate.calls = nexus.ExtractCallCount();
+    }
+    candidates_.insert(candidate);
+    return NoChange();
+  }
+
   HeapObjectMatcher match(callee);
   if (!match.HasValue() || !match.Value()->IsJSFunction()) return NoChange();
   Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
@@ -45,33 +107,10 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   // Everything below this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
-  // Built-in functions are handled by the JSBuiltinReducer.
-  if (function->shared()->HasBuiltinFunctionId()) return NoChange();
-
-  // Don't inline builtins.
-  if (function->shared()->IsBuiltin()) return NoChange();
-
-  // Quick check on source code length to avoid parsing large candidate.
-  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
-    return NoChange();
-  }
-
-  // Quick check on the size of the AST to avoid parsing large candidate.
-  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
-    return NoChange();
-  }
-
-  // Avoid inlining within or across the boundary of asm.js code.
-  if (info_->shared_info()->asm_function()) return NoChange();
-  if (function->shared()->asm_function()) return NoChange();
+  if (!CanInlineFunction(function)) return NoChange();
 
   // Stop inlinining once the maximum allowed level is reached.
-  int level = 0;
-  for (Node* frame_state = NodeProperties::GetFrameStateInput(node, 0);
-       frame_state->opcode() == IrOpcode::kFrameState;
-       frame_state = NodeProperties::GetFrameStateInput(frame_state, 0)) {
-    if (++level > FLAG_max_inlining_levels) return NoChange();
-  }
+  if (ExceedsMaxInliningLevel(node)) return NoChange();
 
   // Gather feedback on how often this call site has been hit before.
   int calls = -1;  // Same default as CallICNexus::ExtractCallCount.
@@ -89,11 +128,42 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   // ---------------------------------------------------------------------------
 
   // In the general case we remember the candidate for later.
-  candidates_.insert({function, node, calls});
+  Candidate candidate;
+  candidate.functions[0] = function;
+  candidate.num_functions = 1;
+  candidate.node = node;
+  candidate.calls = calls;
+  candidate.size = function->shared()->ast_node_count();
+  candidates_.insert(candidate);
   return NoChange();
 }
 
 
+bool JSInliningHeuristic::CanInlineFunction(
+    Handle<JSFunction> function) const {
+  // Built-in functions are handled by the JSBuiltinReducer.
+  if (function->shared()->HasBuiltinFunctionId()) return false;
+
+  // Don't inline builtins.
+  if (function->shared()->IsBuiltin()) return false;
+
+  // Quick check on source code length to avoid parsing large candidate.
+  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
+    return false;
+  }
+
+  // Quick check on the size of the AST to avoid parsing large candidate.
+  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
+    return false;
+  }
+
+  // Avoid inlining within or across the boundary of asm.js code.
+  if (info_->shared_info()->asm_function()) return false;
+  if (function->shared()->asm_function()) return false;
+  return true;
+}
+
+
 void JSInliningHeuristic::Finalize() {
   if (candidates_.empty()) return;  // Nothing to do without candidates.
   if (FLAG_trace_turbo_inlining) PrintCandidates();
@@ -108,14 +178,120 @@ void JSInliningHeuristic::Finalize() {
     Candidate candidate = *i;
     candidates_.erase(i);
     // Make sure we don't try to inline dead candidate nodes.
-    if (!candidate.node->IsDead()) {
-      Reduction r = inliner_.ReduceJSCall(candidate.node, candidate.function);
-      if (r.Changed()) {
-        cumulative_count_ += candidate.function->shared()->ast_node_count();
-        return;
-      }
+    if (candidate.node->IsDead()) continue;
+    // Polymorphic call sites are inlined as a whole or not at all.
+    if (candidate.num_functions > 1 &&
+        cumulative_count_ + candidate.size >
+            FLAG_max_inlined_nodes_cumulative) {
+      continue;
+    }
+    Reduction r = InlineCandidate(candidate);
+    if (r.Changed()) return;
+  }
+}
+
+
+Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate) {
+  int const num_calls = candidate.num_functions;
+  Node* const node = candidate.node;
+  if (num_calls == 1) {
+    Handle<JSFunction> function = candidate.functions[0];
+    Reduction const reduction = inliner_.ReduceJSCall(node, function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
+    }
+    return reduction;
+  }
+
+  // Expand the polymorphic call {node} into a dispatch on the {callee}, with
+  // a clone of the call specialized to each of the known target functions.
+  // The {callee} is a phi of exactly these functions, so the last one needs
+  // no check.
+  DCHECK_LE(2, num_calls);
+  Node* calls[kMaxCallPolymorphism + 1];
+  Node* if_successes[kMaxCallPolymorphism];
+  Node* callee = NodeProperties::GetValueInput(node, 0);
+  Node* fallthrough_control = NodeProperties::GetControlInput(node);
+
+  // Setup the inputs for the cloned call nodes.
+  int const input_count = node->InputCount();
+  Node** inputs = graph()->zone()->NewArray<Node*>(input_count);
+  for (int i = 0; i < input_count; ++i) {
+    inputs[i] = node->InputAt(i);
+  }
+
+  for (int i = 0; i < num_calls; ++i) {
+    Node* target = jsgraph()->HeapConstant(candidate.functions[i]);
+    if (i != num_calls - 1) {
+      Node* check =
+          graph()->NewNode(simplified()->ReferenceEqual(Type::Any()), callee,
+                           target);
+      Node* branch =
+          graph()->NewNode(common()->Branch(), check, fallthrough_control);
+      fallthrough_control = graph()->NewNode(common()->IfFalse(), branch);
+      if_successes[i] = graph()->NewNode(common()->IfTrue(), branch);
+    } else {
+      if_successes[i] = fallthrough_control;
+    }
+
+    // The first input to the call is the actual target, the last input is
+    // the control dependency.
+    inputs[0] = target;
+    inputs[input_count - 1] = if_successes[i];
+    calls[i] = graph()->NewNode(node->op(), input_count, inputs);
+    if_successes[i] = graph()->NewNode(common()->IfSuccess(), calls[i]);
+  }
+
+  // Merge the exceptional continuations of the cloned calls, if any.
+  Node* if_exception = nullptr;
+  for (Edge const edge : node->use_edges()) {
+    if (NodeProperties::IsControlEdge(edge) &&
+        edge.from()->opcode() == IrOpcode::kIfException) {
+      if_exception = edge.from();
+      break;
+    }
+  }
+  if (if_exception != nullptr) {
+    IfExceptionHint const hint = OpParameter<IfExceptionHint>(if_exception);
+    Node* if_exceptions[kMaxCallPolymorphism + 1];
+    for (int i = 0; i < num_calls; ++i) {
+      if_exceptions[i] =
+          graph()->NewNode(common()->IfException(hint), calls[i], calls[i]);
+    }
+    Node* exception_control =
+        graph()->NewNode(common()->Merge(num_calls), num_calls, if_exceptions);
+    if_exceptions[num_calls] = exception_control;
+    Node* exception_effect = graph()->NewNode(common()->EffectPhi(num_calls),
+                                              num_calls + 1, if_exceptions);
+    Node* exception_value = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kTagged, num_calls),
+        num_calls + 1, if_exceptions);
+    ReplaceWithValue(if_exception, exception_value, exception_effect,
+                     exception_control);
+  }
+
+  // Morph the call site into the dispatched call sites.
+  Node* control =
+      graph()->NewNode(common()->Merge(num_calls), num_calls, if_successes);
+  calls[num_calls] = control;
+  Node* effect =
+      graph()->NewNode(common()->EffectPhi(num_calls), num_calls + 1, calls);
+  Node* value =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, num_calls),
+                       num_calls + 1, calls);
+  ReplaceWithValue(node, value, effect, control);
+
+  // Inline the individual, cloned call sites. Calls that cannot be inlined
+  // are still specialized to their known target.
+  for (int i = 0; i < num_calls; ++i) {
+    Handle<JSFunction> function = candidate.functions[i];
+    Reduction const reduction = inliner_.ReduceJSCall(calls[i], function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
     }
   }
+
+  return Replace(value);
 }
 
 
@@ -131,14 +307,29 @@ bool JSInliningHeuristic::CandidateCompare::operator()(
 void JSInliningHeuristic::PrintCandidates() {
   PrintF("Candidates for inlining (size=%zu):\n", candidates_.size());
   for (const Candidate& candidate : candidates_) {
-    PrintF("  id:%d, calls:%d, size[source]:%d, size[ast]:%d / %s\n",
-           candidate.node->id(), candidate.calls,
-           candidate.function->shared()->SourceSize(),
-           candidate.function->shared()->ast_node_count(),
-           candidate.function->shared()->DebugName()->ToCString().get());
+    PrintF("  id:%d, calls:%d, targets:%d\n", candidate.node->id(),
+           candidate.calls, candidate.num_functions);
+    for (int i = 0; i < candidate.num_functions; ++i) {
+      SharedFunctionInfo* shared = candidate.functions[i]->shared();
+      PrintF("    size[source]:%d, size[ast]:%d / %s\n", shared->SourceSize(),
+             shared->ast_node_count(), shared->DebugName()->ToCString().get());
+    }
   }
 }
 
+
+CommonOperatorBuilder* JSInliningHeuristic::common() const {
+  return jsgraph()->common();
+}
+
+
+Graph* JSInliningHeuristic::graph() const { return jsgraph()->graph(); }
+
+
+SimplifiedOperatorBuilder* JSInliningHeuristic::simplified() const {
+  return jsgraph()->simplified();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,173 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-invariant-code-motion.h"
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/objects-inl.h"
+#include "src/types.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Checks whether {node} is known to produce a context. The context parameter
+// is typed as Any, so it is recognized by its position instead.
+bool IsContext(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kHeapConstant:
+      return OpParameter<Handle<HeapObject>>(node)->IsContext();
+    case IrOpcode::kParameter: {
+      Node* const start = NodeProperties::GetValueInput(node, 0);
+      if (start->opcode() != IrOpcode::kStart) return false;
+      // See NodeProperties::GetSpecializationContext for the layout.
+      int const index = ParameterIndexOf(node->op());
+      return index == start->op()->ValueOutputCount() - 2;
+    }
+    case IrOpcode::kLoadField: {
+      FieldAccess const& access = FieldAccessOf(node->op());
+      return access.base_is_tagged == kTaggedBase &&
+             access.offset == Context::SlotOffset(Context::PREVIOUS_INDEX) +
+                                  kHeapObjectTag &&
+             IsContext(NodeProperties::GetValueInput(node, 0));
+    }
+    default:
+      return NodeProperties::IsTyped(node) &&
+             NodeProperties::GetType(node)->IsContext();
+  }
+}
+
+// Checks whether {node} is known to produce a heap object, i.e. whether it is
+// safe to load its map without a preceding smi check.
+bool IsHeapObject(Node* node) {
+  if (node->opcode() == IrOpcode::kHeapConstant) return true;
+  if (!NodeProperties::IsTyped(node)) return false;
+  Type* const type = NodeProperties::GetType(node);
+  // A value of type None is never produced, i.e. {node} is unreachable and
+  // may be anything if the typer's assumptions do not hold.
+  if (type->Is(Type::None())) return false;
+  return !type->Maybe(Type::Number());
+}
+
+}  // namespace
+
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(Graph* graph, Zone* zone)
+    : graph_(graph), zone_(zone), hoisted_count_(0), hoisted_to_(zone) {}
+
+void LoopInvariantCodeMotion::Run() {
+  LoopTree* loop_tree = LoopFinder::BuildLoopTree(graph(), zone());
+  for (LoopTree::Loop* loop : loop_tree->outer_loops()) {
+    VisitLoop(loop_tree, loop);
+  }
+}
+
+// Visits inner loops first, so that a load which is invariant in a whole loop
+// nest moves out of one loop at a time.
+void LoopInvariantCodeMotion::VisitLoop(LoopTree* loop_tree,
+                                        LoopTree::Loop* loop) {
+  for (LoopTree::Loop* child : loop->children()) {
+    VisitLoop(loop_tree, child);
+  }
+
+  // Only loops with a single effect phi have a single effect edge to hoist to.
+  Node* loop_effect_phi = nullptr;
+  for (Node* node : loop_tree->HeaderNodes(loop)) {
+    if (node->opcode() != IrOpcode::kEffectPhi) continue;
+    if (loop_effect_phi != nullptr) return;
+    loop_effect_phi = node;
+  }
+  if (loop_effect_phi == nullptr) return;
+
+  // Hoisting a load may make loads from its value invariant as well, e.g. for
+  // chains of context loads, so iterate until nothing changes.
+  bool changed;
+  do {
+    changed = false;
+    for (Node* node : loop_tree->BodyNodes(loop)) {
+      if (!IsHoistable(loop_tree, loop, node)) continue;
+      if (MayWriteField(loop_tree, loop, FieldAccessOf(node->op()).offset)) {
+        continue;
+      }
+      Hoist(node, loop_effect_phi);
+      // Count a node only once, even if it moves out of several loops.
+      if (hoisted_to_.find(node) == hoisted_to_.end()) hoisted_count_++;
+      hoisted_to_[node] = loop->parent();
+      changed = true;
+    }
+  } while (changed);
+}
+
+bool LoopInvariantCodeMotion::IsHoistable(LoopTree* loop_tree,
+                                          LoopTree::Loop* loop,
+                                          Node* node) const {
+  if (node->opcode() != IrOpcode::kLoadField) return false;
+  // Loads in nested loops were either hoisted to this loop already, or are
+  // not invariant in the nested loop.
+  if (LoopOf(loop_tree, node) != loop) return false;
+  FieldAccess const& access = FieldAccessOf(node->op());
+  if (access.base_is_tagged != kTaggedBase) return false;
+  Node* const object = NodeProperties::GetValueInput(node, 0);
+  if (IsContainedIn(loop_tree, loop, object)) return false;
+  if (access.offset == HeapObject::kMapOffset) return IsHeapObject(object);
+  // All slots of a context are known statically from its scope, so loading
+  // from a context is safe wherever the context is available.
+  return IsContext(object);
+}
+
+// Checks whether any node in {loop} may write to a field at {offset} of an
+// object that existed before the loop was entered.
+bool LoopInvariantCodeMotion::MayWriteField(LoopTree* loop_tree,
+                                            LoopTree::Loop* loop,
+                                            int offset) const {
+  for (Node* node : loop_tree->LoopNodes(loop)) {
+    if (node->op()->EffectOutputCount() == 0) continue;
+    if (NodeProperties::MayWriteField(node, offset)) return true;
+  }
+  return false;
+}
+
+// Moves {node} from the effect chain of the loop body to the effect edge that
+// enters the loop, just before {loop_effect_phi}.
+void LoopInvariantCodeMotion::Hoist(Node* node, Node* loop_effect_phi) {
+  Node* const loop = NodeProperties::GetControlInput(loop_effect_phi);
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  for (Edge edge : node->use_edges()) {
+    if (NodeProperties::IsEffectEdge(edge)) edge.UpdateTo(effect);
+  }
+  NodeProperties::ReplaceEffectInput(
+      node, NodeProperties::GetEffectInput(loop_effect_phi,
+                                           kAssumedLoopEntryIndex));
+  NodeProperties::ReplaceControlInput(
+      node, NodeProperties::GetControlInput(loop, kAssumedLoopEntryIndex));
+  NodeProperties::ReplaceEffectInput(loop_effect_phi, node,
+                                     kAssumedLoopEntryIndex);
+}
+
+// Returns the innermost loop that contains {node}, taking into account the
+// nodes that were already moved out of their loop.
+LoopTree::Loop* LoopInvariantCodeMotion::LoopOf(LoopTree* loop_tree,
+                                                Node* node) const {
+  auto it = hoisted_to_.find(node);
+  if (it != hoisted_to_.end()) return it->second;
+  return loop_tree->ContainingLoop(node);
+}
+
+bool LoopInvariantCodeMotion::IsContainedIn(LoopTree* loop_tree,
+                                            LoopTree::Loop* loop,
+                                            Node* node) const {
+  for (LoopTree::Loop* c = LoopOf(loop_tree, node); c != nullptr;
+       c = c->parent()) {
+    if (c == loop) return true;
+  }
+  return false;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
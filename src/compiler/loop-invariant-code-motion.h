@@ -0,0 +1,65 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+#define V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+
+#include "src/compiler/loop-analysis.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class Graph;
+class Node;
+
+// Hoists loop invariant loads out of loops. Pure nodes float freely in the
+// graph and are already hoisted by the scheduler, but loads are pinned to the
+// effect chain inside the loop body. A LoadField is moved to the effect edge
+// that enters the loop if
+//  - the object it loads from is defined outside of the loop,
+//  - it is safe to execute unconditionally, i.e. it loads the map of a value
+//    that is known to be a heap object or a slot of a context, and
+//  - nothing in the loop may write to the loaded field.
+class LoopInvariantCodeMotion final {
+ public:
+  LoopInvariantCodeMotion(Graph* graph, Zone* zone);
+  ~LoopInvariantCodeMotion() {}
+
+  void Run();
+
+  // The number of nodes that were moved out of a loop.
+  size_t hoisted_count() const { return hoisted_count_; }
+
+ private:
+  void VisitLoop(LoopTree* loop_tree, LoopTree::Loop* loop);
+  bool IsHoistable(LoopTree* loop_tree, LoopTree::Loop* loop,
+                   Node* node) const;
+  bool MayWriteField(LoopTree* loop_tree, LoopTree::Loop* loop,
+                     int offset) const;
+  void Hoist(Node* node, Node* loop_effect_phi);
+  LoopTree::Loop* LoopOf(LoopTree* loop_tree, Node* node) const;
+  bool IsContainedIn(LoopTree* loop_tree, LoopTree::Loop* loop,
+                     Node* node) const;
+
+  Graph* graph() const { return graph_; }
+  Zone* zone() const { return zone_; }
+
+  Graph* const graph_;
+  Zone* const zone_;
+  size_t hoisted_count_;
+  // The loop that each hoisted node was moved to, or nullptr if it was moved
+  // out of all loops.
+  ZoneMap<Node*, LoopTree::Loop*> hoisted_to_;
+
+  DISALLOW_COPY_AND_ASSIGN(LoopInvariantCodeMotion);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
@@ -113,6 +113,9 @@ class MachineOperatorBuilder final : public ZoneObject {
     kWord64Popcnt = 1u << 19,
     kWord32ReverseBits = 1u << 20,
     kWord64ReverseBits = 1u << 21,
+    // The backend supports 128-bit loads and stores, Float32x4 add, sub, mul
+    // and div, and Int32x4 add and sub. These are used by the SLP vectorizer.
+    kSimd128Arithmetic = 1u << 22,
     kAllOptionalOps = kFloat32Max | kFloat32Min | kFloat64Max | kFloat64Min |
                       kFloat32RoundDown | kFloat64RoundDown | kFloat32RoundUp |
                       kFloat64RoundUp | kFloat32RoundTruncate |
@@ -144,6 +147,9 @@ class MachineOperatorBuilder final : public ZoneObject {
   const OptionalOperator Word32ReverseBits();
   const OptionalOperator Word64ReverseBits();
   bool Word32ShiftIsSafe() const { return flags_ & kWord32ShiftIsSafe; }
+  bool Simd128ArithmeticIsSupported() const {
+    return flags_ & kSimd128Arithmetic;
+  }
 
   const Operator* Word64And();
   const Operator* Word64Or();
@@ -8,6 +8,7 @@
 #include "src/compiler/linkage.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/operator-properties.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/compiler/verifier.h"
 #include "src/handles-inl.h"
 
@@ -133,6 +134,35 @@ bool NodeProperties::IsExceptionalCall(Node* node) {
 }
 
 
+// static
+bool NodeProperties::MayWriteField(Node* node, int offset) {
+  DCHECK_LT(0, node->op()->EffectOutputCount());
+  switch (node->opcode()) {
+    case IrOpcode::kEffectPhi:
+    case IrOpcode::kAllocate:
+    case IrOpcode::kBeginRegion:
+    case IrOpcode::kFinishRegion:
+      return false;
+    case IrOpcode::kStoreBuffer:
+    case IrOpcode::kStoreElement:
+      // Element stores only write behind the header of a backing store.
+      return false;
+    case IrOpcode::kStoreField: {
+      FieldAccess const& access = FieldAccessOf(node->op());
+      // Untagged stores may write anywhere.
+      if (access.base_is_tagged != kTaggedBase) return true;
+      if (access.offset != offset) return false;
+      // Initializing stores to fresh allocations do not alias.
+      return GetValueInput(node, 0)->opcode() != IrOpcode::kAllocate;
+    }
+    case IrOpcode::kJSStackCheck:
+      return true;
+    default:
+      return !node->op()->HasProperty(Operator::kNoWrite);
+  }
+}
+
+
 // static
 void NodeProperties::ReplaceValueInput(Node* node, Node* value, int index) {
   DCHECK(index < node->op()->ValueInputCount());
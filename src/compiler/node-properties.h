@@ -76,6 +76,11 @@ class NodeProperties final {
   // within the graph (i.e. an IfException projection is present).
   static bool IsExceptionalCall(Node* node);
 
+  // Determines whether the given effectful node may write to the field at
+  // {offset} of an object that exists before the node. Stack checks may run
+  // interrupts, which can execute arbitrary code, so they count as writes.
+  static bool MayWriteField(Node* node, int offset);
+
   // ---------------------------------------------------------------------------
   // Miscellaneous mutators.
 
@@ -26,6 +26,22 @@ class PipelineStatistics : public Malloced {
   void BeginPhaseKind(const char* phase_kind_name);
   void EndPhaseKind();
 
+  void RecordSchedulingStats(size_t unscheduled_cycles,
+                             size_t scheduled_cycles) {
+    compilation_stats_->RecordSchedulingStats(unscheduled_cycles,
+                                              scheduled_cycles);
+  }
+
+  void RecordLoopInvariantCodeMotionStats(size_t hoisted_nodes) {
+    compilation_stats_->RecordLoopInvariantCodeMotionStats(hoisted_nodes);
+  }
+
+  void RecordRegisterAllocationStats(bool greedy, bool high_pressure,
+                                     size_t spills, size_t fills) {
+    compilation_stats_->RecordRegisterAllocationStats(greedy, high_pressure,
+                                                      spills, fills);
+  }
+
  private:
   size_t OuterZoneSize() {
     return static_cast<size_t>(outer_zone_->allocation_size());
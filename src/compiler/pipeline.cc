@@ -9,9 +9,13 @@
 
 #include "src/base/adapters.h"
 #include "src/base/platform/elapsed-timer.h"
+#include "src/base/platform/semaphore.h"
+#include "src/cancelable-task.h"
+#include "src/compiler/allocation-sinking.h"
 #include "src/compiler/ast-graph-builder.h"
 #include "src/compiler/ast-loop-assignment-analyzer.h"
 #include "src/compiler/basic-block-instrumentor.h"
+#include "src/compiler/bounds-check-elimination.h"
 #include "src/compiler/branch-elimination.h"
 #include "src/compiler/bytecode-graph-builder.h"
 #include "src/compiler/code-generator.h"
@@ -26,6 +30,7 @@
 #include "src/compiler/graph-trimmer.h"
 #include "src/compiler/graph-visualizer.h"
 #include "src/compiler/greedy-allocator.h"
+#include "src/compiler/induction-variable-analysis.h"
 #include "src/compiler/instruction-selector.h"
 #include "src/compiler/instruction.h"
 #include "src/compiler/js-builtin-reducer.h"
@@ -43,6 +48,7 @@
 #include "src/compiler/live-range-separator.h"
 #include "src/compiler/load-elimination.h"
 #include "src/compiler/loop-analysis.h"
+#include "src/compiler/loop-invariant-code-motion.h"
 #include "src/compiler/loop-peeling.h"
 #include "src/compiler/machine-operator-reducer.h"
 #include "src/compiler/memory-optimizer.h"
@@ -57,6 +63,7 @@
 #include "src/compiler/simplified-lowering.h"
 #include "src/compiler/simplified-operator-reducer.h"
 #include "src/compiler/simplified-operator.h"
+#include "src/compiler/slp-vectorizer.h"
 #include "src/compiler/tail-call-optimization.h"
 #include "src/compiler/type-hint-analyzer.h"
 #include "src/compiler/typer.h"
@@ -69,6 +76,7 @@
 #include "src/register-configuration.h"
 #include "src/type-info.h"
 #include "src/utils.h"
+#include "src/v8.h"
 
 namespace v8 {
 namespace internal {
@@ -90,7 +98,8 @@ class PipelineData {
         instruction_zone_scope_(zone_pool_),
         instruction_zone_(instruction_zone_scope_.zone()),
         register_allocation_zone_scope_(zone_pool_),
-        register_allocation_zone_(register_allocation_zone_scope_.zone()) {
+        register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_pool_) {
     PhaseScope scope(pipeline_statistics, "init pipeline data");
     graph_ = new (graph_zone_) Graph(graph_zone_);
     source_positions_ = new (graph_zone_) SourcePositionTable(graph_);
@@ -117,7 +126,8 @@ class PipelineData {
         instruction_zone_scope_(zone_pool_),
         instruction_zone_(instruction_zone_scope_.zone()),
         register_allocation_zone_scope_(zone_pool_),
-        register_allocation_zone_(register_allocation_zone_scope_.zone()) {}
+        register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_pool_) {}
 
   // For machine graph testing entry point.
   PipelineData(ZonePool* zone_pool, CompilationInfo* info, Graph* graph,
@@ -133,7 +143,8 @@ class PipelineData {
         instruction_zone_scope_(zone_pool_),
         instruction_zone_(instruction_zone_scope_.zone()),
         register_allocation_zone_scope_(zone_pool_),
-        register_allocation_zone_(register_allocation_zone_scope_.zone()) {}
+        register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_pool_) {}
 
   // For register allocation testing entry point.
   PipelineData(ZonePool* zone_pool, CompilationInfo* info,
@@ -147,7 +158,8 @@ class PipelineData {
         instruction_zone_(sequence->zone()),
         sequence_(sequence),
         register_allocation_zone_scope_(zone_pool_),
-        register_allocation_zone_(register_allocation_zone_scope_.zone()) {}
+        register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_pool_) {}
 
   ~PipelineData() {
     DeleteRegisterAllocationZone();
@@ -211,6 +223,9 @@ class PipelineData {
   RegisterAllocationData* register_allocation_data() const {
     return register_allocation_data_;
   }
+  Zone* fp_register_allocation_zone() {
+    return fp_register_allocation_zone_scope_.zone();
+  }
 
   BasicBlockProfiler::Data* profiler_data() const { return profiler_data_; }
   void set_profiler_data(BasicBlockProfiler::Data* profiler_data) {
@@ -252,6 +267,7 @@ class PipelineData {
     if (register_allocation_zone_ == nullptr) return;
     register_allocation_zone_scope_.Destroy();
     register_allocation_zone_ = nullptr;
+    fp_register_allocation_zone_scope_.Destroy();
     register_allocation_data_ = nullptr;
   }
 
@@ -338,6 +354,9 @@ class PipelineData {
   // destroyed.
   ZonePool::Scope register_allocation_zone_scope_;
   Zone* register_allocation_zone_;
+  // Holds the floating point live ranges when registers are allocated in
+  // parallel, see AllocateRegistersInParallelPhase.
+  ZonePool::Scope fp_register_allocation_zone_scope_;
   RegisterAllocationData* register_allocation_data_ = nullptr;
 
   // Basic block profiling support.
@@ -423,6 +442,65 @@ void TraceSchedule(CompilationInfo* info, Schedule* schedule) {
 }
 
 
+// Beyond these sizes the greedy allocator takes too long compared to the
+// linear scan allocator.
+const int kMaxInstructionsForGreedyAllocation = 20000;
+const size_t kMaxLiveRangesForGreedyAllocation = 10000;
+
+// The greedy allocator makes better spill decisions when there are more live
+// values than registers, while the linear scan allocator is faster and just
+// as good otherwise. Picks the greedy allocator if, on average, more general
+// purpose values are live at the same time than there are registers to hold
+// them.
+bool ShouldUseGreedyAllocator(RegisterAllocationData* data) {
+  const InstructionSequence* code = data->code();
+  int instruction_count = static_cast<int>(code->instructions().size());
+  if (instruction_count == 0 ||
+      instruction_count > kMaxInstructionsForGreedyAllocation ||
+      data->live_ranges().size() > kMaxLiveRangesForGreedyAllocation) {
+    return false;
+  }
+  uint64_t live_size = 0;
+  for (TopLevelLiveRange* range : data->live_ranges()) {
+    if (range == nullptr || range->IsEmpty()) continue;
+    if (range->kind() != GENERAL_REGISTERS) continue;
+    live_size += range->GetSize();
+  }
+  uint64_t code_size = static_cast<uint64_t>(
+      LifetimePosition::GapFromInstructionIndex(instruction_count).value());
+  int registers = data->config()->num_allocatable_general_registers();
+  return live_size > code_size * registers;
+}
+
+
+// Counts the gap moves that store a register to a stack slot (spills) and
+// that load a register from a stack slot (fills).
+void CountSpillsAndFills(const InstructionSequence* code, size_t* spills,
+                         size_t* fills) {
+  *spills = 0;
+  *fills = 0;
+  for (const Instruction* instr : code->instructions()) {
+    for (int i = Instruction::FIRST_GAP_POSITION;
+         i <= Instruction::LAST_GAP_POSITION; i++) {
+      const ParallelMove* moves = instr->parallel_moves()[i];
+      if (moves == nullptr) continue;
+      for (const MoveOperands* move : *moves) {
+        if (move->IsEliminated()) continue;
+        const InstructionOperand& source = move->source();
+        const InstructionOperand& destination = move->destination();
+        if (source.IsAnyRegister() &&
+            (destination.IsStackSlot() || destination.IsFPStackSlot())) {
+          ++*spills;
+        } else if ((source.IsStackSlot() || source.IsFPStackSlot()) &&
+                   destination.IsAnyRegister()) {
+          ++*fills;
+        }
+      }
+    }
+  }
+}
+
+
 class AstGraphBuilderWithPositions final : public AstGraphBuilder {
  public:
   AstGraphBuilderWithPositions(Zone* local_zone, CompilationInfo* info,
@@ -590,7 +668,8 @@ PipelineCompilationJob::Status PipelineCompilationJob::CreateGraphImpl() {
     if (!FLAG_always_opt) {
       info()->MarkAsBailoutOnUninitialized();
     }
-    if (FLAG_native_context_specialization) {
+    // Code for the code cache must not depend on the native context.
+    if (FLAG_native_context_specialization && !info()->will_serialize()) {
       info()->MarkAsNativeContextSpecializing();
     }
   }
@@ -624,6 +703,12 @@ PipelineCompilationJob::Status PipelineCompilationJob::GenerateCodeImpl() {
     }
     return FAILED;
   }
+  // Code that depends on objects in this heap cannot be reused by another
+  // process, even if its reloc info supports serialization.
+  if (code->has_reloc_info_for_serialization() &&
+      !info()->dependencies()->IsEmpty()) {
+    code->set_has_reloc_info_for_serialization(false);
+  }
   info()->dependencies()->Commit(code);
   info()->SetCode(code);
   if (info()->is_deoptimization_enabled()) {
@@ -821,7 +906,13 @@ struct TyperPhase {
   void Run(PipelineData* data, Zone* temp_zone, Typer* typer) {
     NodeVector roots(temp_zone);
     data->jsgraph()->GetCachedNodes(&roots);
-    typer->Run(roots);
+    if (FLAG_turbo_induction_variables) {
+      InductionVariableAnalysis induction_vars(data->graph(), temp_zone);
+      induction_vars.Run();
+      typer->Run(roots, &induction_vars);
+    } else {
+      typer->Run(roots);
+    }
   }
 };
 
@@ -911,6 +1002,30 @@ struct TypedLoweringPhase {
 };
 
 
+struct BoundsCheckEliminationPhase {
+  static const char* phase_name() { return "bounds check elimination"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    JSGraphReducer graph_reducer(data->jsgraph(), temp_zone);
+    BoundsCheckElimination bounds_check_elimination(&graph_reducer);
+    AddReducer(data, &graph_reducer, &bounds_check_elimination);
+    graph_reducer.ReduceGraph();
+  }
+};
+
+struct LoopInvariantCodeMotionPhase {
+  static const char* phase_name() { return "loop invariant code motion"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopInvariantCodeMotion licm(data->graph(), temp_zone);
+    licm.Run();
+    if (data->pipeline_statistics() != nullptr) {
+      data->pipeline_statistics()->RecordLoopInvariantCodeMotionStats(
+          licm.hoisted_count());
+    }
+  }
+};
+
 struct BranchEliminationPhase {
   static const char* phase_name() { return "branch condition elimination"; }
 
@@ -945,6 +1060,15 @@ struct EscapeAnalysisPhase {
   }
 };
 
+struct AllocationSinkingPhase {
+  static const char* phase_name() { return "allocation sinking"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    AllocationSinking allocation_sinking(data->graph(), temp_zone);
+    allocation_sinking.Run();
+  }
+};
+
 struct RepresentationSelectionPhase {
   static const char* phase_name() { return "representation selection"; }
 
@@ -1052,6 +1176,16 @@ struct LateOptimizationPhase {
   }
 };
 
+struct SLPVectorizationPhase {
+  static const char* phase_name() { return "slp vectorization"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    SLPVectorizer vectorizer(data->graph(), data->common(), data->machine(),
+                             temp_zone);
+    vectorizer.Vectorize();
+  }
+};
+
 struct EarlyGraphTrimmingPhase {
   static const char* phase_name() { return "early graph trimming"; }
   void Run(PipelineData* data, Zone* temp_zone) {
@@ -1114,6 +1248,12 @@ struct InstructionSelectionPhase {
             ? InstructionSelector::kAllSourcePositions
             : InstructionSelector::kCallSourcePositions);
     selector.SelectInstructions();
+    if (data->pipeline_statistics() != nullptr &&
+        selector.scheduler() != nullptr) {
+      data->pipeline_statistics()->RecordSchedulingStats(
+          selector.scheduler()->unscheduled_cycles(),
+          selector.scheduler()->scheduled_cycles());
+    }
   }
 };
 
@@ -1184,6 +1324,68 @@ struct AllocateFPRegistersPhase {
 };
 
 
+// Functions with fewer instructions are not worth the overhead of allocating
+// registers on a background thread.
+const size_t kMinInstructionsForParallelRegisterAllocation = 2000;
+
+// Allocates floating point registers on a background thread.
+class AllocateFPRegistersTask final : public CancelableTask {
+ public:
+  AllocateFPRegistersTask(Isolate* isolate, LinearScanAllocator* allocator,
+                          base::Semaphore* on_finished)
+      : CancelableTask(isolate),
+        allocator_(allocator),
+        on_finished_(on_finished) {}
+
+  void RunInternal() final {
+    allocator_->AllocateRegisters();
+    on_finished_->Signal();
+  }
+
+ private:
+  LinearScanAllocator* const allocator_;
+  base::Semaphore* const on_finished_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocateFPRegistersTask);
+};
+
+// General and floating point registers are allocated independently of each
+// other, so for large functions they are allocated in parallel. The live
+// ranges of each kind are only touched by their allocator, and the floating
+// point allocator splits ranges in a zone of its own.
+struct AllocateRegistersInParallelPhase {
+  static const char* phase_name() { return "allocate registers in parallel"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    RegisterAllocationData* allocation_data = data->register_allocation_data();
+    allocation_data->set_fp_allocation_zone(
+        data->fp_register_allocation_zone());
+    ZonePool::Scope fp_zone_scope(data->zone_pool());
+    LinearScanAllocator fp_allocator(allocation_data, FP_REGISTERS,
+                                     fp_zone_scope.zone());
+    base::Semaphore fp_allocation_finished(0);
+    CancelableTask* task = new AllocateFPRegistersTask(
+        data->isolate(), &fp_allocator, &fp_allocation_finished);
+    uint32_t task_id = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kLongRunningTask);
+
+    LinearScanAllocator general_allocator(allocation_data, GENERAL_REGISTERS,
+                                          temp_zone);
+    general_allocator.AllocateRegisters();
+
+    // Do not wait for a background thread that has not even picked up the
+    // task yet; allocate the floating point registers here instead.
+    if (data->isolate()->cancelable_task_manager()->TryAbort(task_id)) {
+      fp_allocator.AllocateRegisters();
+    } else {
+      fp_allocation_finished.Wait();
+    }
+    allocation_data->set_fp_allocation_zone(nullptr);
+  }
+};
+
+
 struct MergeSplintersPhase {
   static const char* phase_name() { return "merge splintered ranges"; }
   void Run(PipelineData* pipeline_data, Zone* temp_zone) {
@@ -1407,6 +1609,16 @@ bool PipelineImpl::CreateGraph() {
     Run<TypedLoweringPhase>();
     RunPrintAndVerify("Lowered typed");
 
+    if (FLAG_turbo_bounds_check_elimination) {
+      Run<BoundsCheckEliminationPhase>();
+      RunPrintAndVerify("Bounds checks eliminated");
+    }
+
+    if (FLAG_turbo_licm) {
+      Run<LoopInvariantCodeMotionPhase>();
+      RunPrintAndVerify("Loop invariants hoisted");
+    }
+
     if (FLAG_turbo_stress_loop_peeling) {
       Run<StressLoopPeelingPhase>();
       RunPrintAndVerify("Loop peeled");
@@ -1415,6 +1627,12 @@ bool PipelineImpl::CreateGraph() {
     if (FLAG_experimental_turbo_escape) {
       Run<EscapeAnalysisPhase>();
       RunPrintAndVerify("Escape Analysed");
+
+      // Sinks the allocations that escape analysis had to keep.
+      if (FLAG_turbo_allocation_sinking) {
+        Run<AllocationSinkingPhase>();
+        RunPrintAndVerify("Allocations sunk");
+      }
     }
 
     // Select representations.
@@ -1475,6 +1693,14 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   // TODO(jarin, rossberg): Remove UNTYPED once machine typing works.
   RunPrintAndVerify("Late optimized", true);
 
+  // Combine isomorphic scalar memory operations and arithmetic into SIMD
+  // operations.
+  if (FLAG_turbo_slp_vectorize &&
+      data->machine()->Simd128ArithmeticIsSupported()) {
+    Run<SLPVectorizationPhase>();
+    RunPrintAndVerify("SLP vectorized", true);
+  }
+
   Run<LateGraphTrimmingPhase>();
   // TODO(jarin, rossberg): Remove UNTYPED once machine typing works.
   RunPrintAndVerify("Late trimmed", true);
@@ -1766,9 +1992,23 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
     Run<SplinterLiveRangesPhase>();
   }
 
-  if (FLAG_turbo_greedy_regalloc) {
+  // The heuristic is also evaluated for --turbo-stats, so that the spills of
+  // both allocators can be compared on the functions it would select.
+  bool high_register_pressure =
+      (FLAG_turbo_select_regalloc || data->pipeline_statistics() != nullptr) &&
+      ShouldUseGreedyAllocator(data->register_allocation_data());
+  bool use_greedy_allocator =
+      FLAG_turbo_greedy_regalloc ||
+      (FLAG_turbo_select_regalloc && high_register_pressure);
+  if (use_greedy_allocator) {
     Run<AllocateGeneralRegistersPhase<GreedyAllocator>>();
     Run<AllocateFPRegistersPhase<GreedyAllocator>>();
+  } else if (FLAG_turbo_parallel_regalloc && !FLAG_trace_alloc &&
+             data->sequence()->instructions().size() >=
+                 kMinInstructionsForParallelRegisterAllocation &&
+             V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads() >
+                 0) {
+    Run<AllocateRegistersInParallelPhase>();
   } else {
     Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
     Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
@@ -1790,6 +2030,13 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
 
   Run<LocateSpillSlotsPhase>();
 
+  if (data->pipeline_statistics() != nullptr) {
+    size_t spills, fills;
+    CountSpillsAndFills(data->sequence(), &spills, &fills);
+    data->pipeline_statistics()->RecordRegisterAllocationStats(
+        use_greedy_allocator, high_register_pressure, spills, fills);
+  }
+
   if (FLAG_trace_turbo_graph) {
     OFStream os(stdout);
     PrintableInstructionSequence printable = {config, data->sequence()};
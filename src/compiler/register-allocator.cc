@@ -1393,6 +1393,7 @@ RegisterAllocationData::RegisterAllocationData(
     const RegisterConfiguration* config, Zone* zone, Frame* frame,
     InstructionSequence* code, const char* debug_name)
     : allocation_zone_(zone),
+      fp_allocation_zone_(nullptr),
       frame_(frame),
       code_(code),
       debug_name_(debug_name),
@@ -1557,7 +1558,8 @@ SpillRange* RegisterAllocationData::AssignSpillRangeToLiveRange(
   SpillRange* spill_range = range->GetAllocatedSpillRange();
   if (spill_range == nullptr) {
     DCHECK(!range->IsSplinter());
-    spill_range = new (allocation_zone()) SpillRange(range, allocation_zone());
+    Zone* zone = allocation_zone(range->kind());
+    spill_range = new (zone) SpillRange(range, zone);
   }
   range->set_spill_type(TopLevelLiveRange::SpillType::kSpillRange);
 
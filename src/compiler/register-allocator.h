@@ -804,6 +804,16 @@ class RegisterAllocationData final : public ZoneObject {
   // This zone is for datastructures only needed during register allocation
   // phases.
   Zone* allocation_zone() const { return allocation_zone_; }
+  // This zone is for the live ranges and spill ranges created while
+  // allocating registers of the given {kind}. Floating point registers are
+  // allocated in a separate zone when they are allocated in parallel with
+  // general registers.
+  Zone* allocation_zone(RegisterKind kind) const {
+    return kind == FP_REGISTERS && fp_allocation_zone_ != nullptr
+               ? fp_allocation_zone_
+               : allocation_zone_;
+  }
+  void set_fp_allocation_zone(Zone* zone) { fp_allocation_zone_ = zone; }
   // This zone is for InstructionOperands and moves that live beyond register
   // allocation.
   Zone* code_zone() const { return code()->zone(); }
@@ -848,6 +858,7 @@ class RegisterAllocationData final : public ZoneObject {
   int GetNextLiveRangeId();
 
   Zone* const allocation_zone_;
+  Zone* fp_allocation_zone_;
   Frame* const frame_;
   InstructionSequence* const code_;
   const char* const debug_name_;
@@ -985,7 +996,7 @@ class RegisterAllocator : public ZoneObject {
   LifetimePosition GetSplitPositionForInstruction(const LiveRange* range,
                                                   int instruction_index);
 
-  Zone* allocation_zone() const { return data()->allocation_zone(); }
+  Zone* allocation_zone() const { return data()->allocation_zone(mode()); }
 
   // Find the optimal split for ranges defined by a memory operand, e.g.
   // constants or function parameters passed on the stack.
@@ -0,0 +1,611 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/slp-vectorizer.h"
+
+#include <algorithm>
+
+#include "src/compiler/all-nodes.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Size of the 32-bit lanes of a 128-bit vector.
+const int kLaneSize = kSimd128Size / 4;
+
+bool GetIntegerConstant(Node* node, int64_t* value) {
+  switch (node->opcode()) {
+    case IrOpcode::kInt32Constant:
+      *value = OpParameter<int32_t>(node);
+      return true;
+    case IrOpcode::kInt64Constant:
+      *value = OpParameter<int64_t>(node);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool GetRelocatableConstant(Node* node, int64_t* value,
+                            RelocInfo::Mode* rmode) {
+  switch (node->opcode()) {
+    case IrOpcode::kRelocatableInt32Constant:
+    case IrOpcode::kRelocatableInt64Constant: {
+      RelocatablePtrConstantInfo const& info =
+          OpParameter<RelocatablePtrConstantInfo>(node);
+      *value = info.value();
+      *rmode = info.rmode();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+SLPVectorizer::SLPVectorizer(Graph* graph, CommonOperatorBuilder* common,
+                             MachineOperatorBuilder* machine, Zone* zone)
+    : graph_(graph),
+      common_(common),
+      machine_(machine),
+      zone_(zone),
+      runs_(zone),
+      packs_(zone),
+      positions_(zone) {}
+
+void SLPVectorizer::Vectorize() {
+  CollectRuns(&runs_);
+  // Runs can be added while vectorizing, so do not hold on to iterators.
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    while (VectorizeRun(runs_[i])) {
+    }
+  }
+}
+
+void SLPVectorizer::CollectRuns(ZoneVector<NodeVector*>* runs) {
+  AllNodes all(zone(), graph());
+  for (Node* node : all.live) {
+    if (!IsMemoryAccess(node)) continue;
+    // Only start a run at its first node.
+    if (NextInRun(NodeProperties::GetEffectInput(node)) == node) continue;
+    NodeVector* run = new (zone()) NodeVector(zone());
+    for (Node* current = node; current != nullptr;
+         current = NextInRun(current)) {
+      run->push_back(current);
+    }
+    if (run->size() >= kLanes) runs->push_back(run);
+  }
+}
+
+bool SLPVectorizer::IsMemoryAccess(Node* node) const {
+  return IsLoad(node) || IsStore(node);
+}
+
+Node* SLPVectorizer::NextInRun(Node* node) const {
+  if (!IsMemoryAccess(node)) return nullptr;
+  Node* next = nullptr;
+  for (Edge edge : node->use_edges()) {
+    if (!NodeProperties::IsEffectEdge(edge)) continue;
+    if (next != nullptr) return nullptr;
+    next = edge.from();
+  }
+  if (next == nullptr || !IsMemoryAccess(next)) return nullptr;
+  if (NodeProperties::GetControlInput(next) !=
+      NodeProperties::GetControlInput(node)) {
+    return nullptr;
+  }
+  return next;
+}
+
+bool SLPVectorizer::IsAdjacentAccess(Node* node, Node* previous) const {
+  if (node->op() != previous->op()) return false;
+  // Checked accesses must be checked against the same length.
+  if (IsCheckedAccess(node) && node->InputAt(2) != previous->InputAt(2)) {
+    return false;
+  }
+  return IsAdjacent(GetAddress(node), GetAddress(previous));
+}
+
+bool SLPVectorizer::VectorizeRun(NodeVector* run) {
+  positions_.clear();
+  for (size_t i = 0; i < run->size(); ++i) {
+    positions_[run->at(i)->id()] = static_cast<int>(i);
+  }
+  for (Node* store : *run) {
+    if (!IsStore(store)) continue;
+    MachineRepresentation rep = AccessRepresentation(store);
+    if (rep != MachineRepresentation::kFloat32 &&
+        rep != MachineRepresentation::kWord32) {
+      continue;
+    }
+    // Look for stores to the following lanes.
+    Node* stores[kLanes] = {store};
+    for (int lane = 1; lane < kLanes; ++lane) {
+      for (Node* node : *run) {
+        if (IsAdjacentAccess(node, stores[lane - 1])) {
+          stores[lane] = node;
+          break;
+        }
+      }
+      if (stores[lane] == nullptr) break;
+    }
+    if (stores[kLanes - 1] == nullptr) continue;
+    if (VectorizeStores(run, stores)) return true;
+  }
+  return false;
+}
+
+bool SLPVectorizer::VectorizeStores(NodeVector* run,
+                                    Node* const stores[kLanes]) {
+  packs_.clear();
+  for (int lane = 0; lane < kLanes; ++lane) {
+    if (stores[lane]->opcode() == IrOpcode::kStore &&
+        StoreRepresentationOf(stores[lane]->op()).write_barrier_kind() !=
+            kNoWriteBarrier) {
+      return false;
+    }
+  }
+
+  Node* values[kLanes];
+  for (int lane = 0; lane < kLanes; ++lane) {
+    values[lane] = StoredValue(stores[lane]);
+  }
+  Pack* value_pack = BuildPack(values, AccessRepresentation(stores[0]));
+  if (value_pack == nullptr) return false;
+  Pack* store_pack = NewPack(stores);
+  if (store_pack == nullptr) return false;
+  store_pack->inputs[0] = value_pack;
+  packs_.push_back(store_pack);
+
+  for (Pack* pack : packs_) {
+    if (!HasOnlyPackedUses(pack)) return false;
+    if (IsMemoryAccess(pack->lanes[0]) && !IsLegalReordering(*run, pack)) {
+      return false;
+    }
+  }
+  bool guarded = HasCheckedPack();
+  int begin, end;
+  if (guarded && !GetPackedSegment(*run, &begin, &end)) return false;
+
+  EmitVectorNodes();
+  if (guarded) {
+    RewriteGuardedRun(run, begin, end);
+  } else {
+    RewriteRun(run);
+  }
+  return true;
+}
+
+SLPVectorizer::Pack* SLPVectorizer::BuildPack(Node* const lanes[kLanes],
+                                              MachineRepresentation rep) {
+  // Reuse an existing pack for the same lanes, e.g. for x * x.
+  for (Pack* pack : packs_) {
+    if (std::equal(lanes, lanes + kLanes, pack->lanes)) return pack;
+  }
+
+  Node* first = lanes[0];
+  for (int lane = 1; lane < kLanes; ++lane) {
+    if (lanes[lane]->op() != first->op()) return nullptr;
+  }
+
+  Pack* pack = nullptr;
+  switch (first->opcode()) {
+    case IrOpcode::kLoad:
+    case IrOpcode::kCheckedLoad:
+      if (AccessRepresentation(first) != rep) return nullptr;
+      if (!IsAdjacentMemoryAccess(lanes)) return nullptr;
+      pack = NewPack(lanes);
+      break;
+    case IrOpcode::kFloat32Add:
+    case IrOpcode::kFloat32Sub:
+    case IrOpcode::kFloat32Mul:
+    case IrOpcode::kFloat32Div:
+    case IrOpcode::kInt32Add:
+    case IrOpcode::kInt32Sub: {
+      MachineRepresentation op_rep =
+          first->opcode() == IrOpcode::kInt32Add ||
+                  first->opcode() == IrOpcode::kInt32Sub
+              ? MachineRepresentation::kWord32
+              : MachineRepresentation::kFloat32;
+      if (op_rep != rep) return nullptr;
+      Pack* inputs[2];
+      for (int i = 0; i < 2; ++i) {
+        Node* input_lanes[kLanes];
+        for (int lane = 0; lane < kLanes; ++lane) {
+          input_lanes[lane] = lanes[lane]->InputAt(i);
+        }
+        inputs[i] = BuildPack(input_lanes, rep);
+        if (inputs[i] == nullptr) return nullptr;
+      }
+      pack = NewPack(lanes);
+      if (pack == nullptr) return nullptr;
+      pack->inputs[0] = inputs[0];
+      pack->inputs[1] = inputs[1];
+      break;
+    }
+    default:
+      return nullptr;
+  }
+  if (pack == nullptr) return nullptr;
+  packs_.push_back(pack);
+  return pack;
+}
+
+SLPVectorizer::Pack* SLPVectorizer::NewPack(Node* const lanes[kLanes]) {
+  for (int lane = 0; lane < kLanes; ++lane) {
+    // Splats of one value to all lanes are not supported, and a node can only
+    // be part of one pack.
+    for (int other = 0; other < lane; ++other) {
+      if (lanes[other] == lanes[lane]) return nullptr;
+    }
+    int unused;
+    if (FindPack(lanes[lane], &unused) != nullptr) return nullptr;
+  }
+  Pack* pack = new (zone()) Pack();
+  std::copy(lanes, lanes + kLanes, pack->lanes);
+  pack->inputs[0] = nullptr;
+  pack->inputs[1] = nullptr;
+  pack->vector = nullptr;
+  return pack;
+}
+
+bool SLPVectorizer::IsAdjacentMemoryAccess(Node* const lanes[kLanes]) const {
+  for (int lane = 0; lane < kLanes; ++lane) {
+    if (PositionOf(lanes[lane]) < 0) return false;
+    if (lane > 0 && !IsAdjacentAccess(lanes[lane], lanes[lane - 1])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SLPVectorizer::IsLegalReordering(NodeVector const& run,
+                                      Pack* pack) const {
+  bool is_store = IsStore(pack->lanes[0]);
+  int target = TargetPosition(pack);
+  for (Node* lane_node : pack->lanes) {
+    int position = PositionOf(lane_node);
+    // Loads move up to the target position, stores move down to it. Check
+    // all the memory accesses they are moved across.
+    int begin = is_store ? position + 1 : target;
+    int end = is_store ? target + 1 : position;
+    for (int i = begin; i < end; ++i) {
+      Node* other = run[i];
+      int unused;
+      if (FindPack(other, &unused) == pack) continue;
+      // Loads can be reordered with respect to each other.
+      if (!is_store && IsLoad(other)) continue;
+      if (MayAlias(lane_node, other)) return false;
+    }
+  }
+  return true;
+}
+
+bool SLPVectorizer::HasOnlyPackedUses(Pack* pack) const {
+  for (int lane = 0; lane < kLanes; ++lane) {
+    for (Edge edge : pack->lanes[lane]->use_edges()) {
+      if (!NodeProperties::IsValueEdge(edge)) continue;
+      int user_lane;
+      if (FindPack(edge.from(), &user_lane) == nullptr || user_lane != lane) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void SLPVectorizer::EmitVectorNodes() {
+  // The packs are in post order, so the inputs of a pack are always emitted
+  // before the pack itself.
+  for (Pack* pack : packs_) {
+    Node* lane = pack->lanes[0];
+    // Checked accesses only take the vector path if all lanes are in bounds,
+    // so the buffer and offset inputs are used like base and index.
+    switch (lane->opcode()) {
+      case IrOpcode::kLoad:
+      case IrOpcode::kCheckedLoad:
+        pack->vector = graph()->NewNode(
+            machine()->Load(MachineType::Simd128()), lane->InputAt(0),
+            lane->InputAt(1), NodeProperties::GetEffectInput(lane),
+            NodeProperties::GetControlInput(lane));
+        break;
+      case IrOpcode::kStore:
+      case IrOpcode::kCheckedStore:
+        pack->vector = graph()->NewNode(
+            machine()->Store(StoreRepresentation(
+                MachineRepresentation::kSimd128, kNoWriteBarrier)),
+            lane->InputAt(0), lane->InputAt(1), pack->inputs[0]->vector,
+            NodeProperties::GetEffectInput(lane),
+            NodeProperties::GetControlInput(lane));
+        break;
+      default:
+        pack->vector =
+            graph()->NewNode(VectorOperator(lane), pack->inputs[0]->vector,
+                             pack->inputs[1]->vector);
+        break;
+    }
+  }
+}
+
+void SLPVectorizer::RewriteRun(NodeVector* run) {
+  // Rebuild the effect chain of the run, with the vector loads and stores in
+  // place of their target lanes and without the other lanes.
+  Node* effect = NodeProperties::GetEffectInput(run->front());
+  Node* last = run->back();
+  NodeVector rewritten(zone());
+  for (size_t i = 0; i < run->size(); ++i) {
+    Node* node = run->at(i);
+    int lane;
+    Pack* pack = FindPack(node, &lane);
+    if (pack != nullptr) {
+      if (TargetPosition(pack) != static_cast<int>(i)) continue;
+      node = pack->vector;
+    }
+    NodeProperties::ReplaceEffectInput(node, effect);
+    effect = node;
+    rewritten.push_back(node);
+  }
+  if (effect != last) {
+    for (Edge edge : last->use_edges()) {
+      if (NodeProperties::IsEffectEdge(edge)) edge.UpdateTo(effect);
+    }
+  }
+
+  // The scalar lanes are only used by each other now.
+  for (Pack* pack : packs_) {
+    for (Node* lane : pack->lanes) lane->NullAllInputs();
+  }
+  packs_.clear();
+  run->swap(rewritten);
+}
+
+bool SLPVectorizer::HasCheckedPack() const {
+  for (Pack* pack : packs_) {
+    if (IsCheckedAccess(pack->lanes[0])) return true;
+  }
+  return false;
+}
+
+bool SLPVectorizer::GetPackedSegment(NodeVector const& run, int* begin,
+                                     int* end) const {
+  *begin = static_cast<int>(run.size());
+  *end = -1;
+  for (Pack* pack : packs_) {
+    if (!IsMemoryAccess(pack->lanes[0])) continue;
+    for (Node* lane : pack->lanes) {
+      *begin = std::min(*begin, PositionOf(lane));
+      *end = std::max(*end, PositionOf(lane));
+    }
+  }
+  // The scalar accesses stay in place on the slow path, so no other access
+  // may be interleaved with them.
+  for (int i = *begin; i <= *end; ++i) {
+    int unused;
+    if (FindPack(run[i], &unused) == nullptr) return false;
+  }
+  return true;
+}
+
+void SLPVectorizer::RewriteGuardedRun(NodeVector* run, int begin, int end) {
+  Node* effect = NodeProperties::GetEffectInput(run->at(begin));
+  Node* control = NodeProperties::GetControlInput(run->at(begin));
+  Node* last = run->at(end);
+
+  // The vector path is taken if the first and last lanes of each checked pack
+  // are in bounds, and the offsets in between do not wrap around.
+  Node* check = nullptr;
+  for (Pack* pack : packs_) {
+    if (!IsCheckedAccess(pack->lanes[0])) continue;
+    Node* first_offset = pack->lanes[0]->InputAt(1);
+    Node* last_offset = pack->lanes[kLanes - 1]->InputAt(1);
+    Node* length = pack->lanes[0]->InputAt(2);
+    Node* in_bounds = graph()->NewNode(
+        machine()->Word32And(),
+        graph()->NewNode(machine()->Uint32LessThan(), first_offset,
+                         last_offset),
+        graph()->NewNode(machine()->Uint32LessThan(), last_offset, length));
+    check = check == nullptr
+                ? in_bounds
+                : graph()->NewNode(machine()->Word32And(), check, in_bounds);
+  }
+  Node* branch =
+      graph()->NewNode(common()->Branch(BranchHint::kTrue), check, control);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+
+  // The vector loads and stores are placed at their target lanes, as in an
+  // unguarded run.
+  Node* etrue = effect;
+  for (int i = begin; i <= end; ++i) {
+    int lane;
+    Pack* pack = FindPack(run->at(i), &lane);
+    if (TargetPosition(pack) != i) continue;
+    NodeProperties::ReplaceEffectInput(pack->vector, etrue);
+    NodeProperties::ReplaceControlInput(pack->vector, if_true);
+    etrue = pack->vector;
+  }
+  // The scalar accesses are kept as they are on the other path.
+  for (int i = begin; i <= end; ++i) {
+    NodeProperties::ReplaceControlInput(run->at(i), if_false);
+  }
+
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* ephi = graph()->NewNode(common()->EffectPhi(2), etrue, last, merge);
+  for (Edge edge : last->use_edges()) {
+    if (edge.from() != ephi && NodeProperties::IsEffectEdge(edge)) {
+      edge.UpdateTo(ephi);
+    }
+  }
+  packs_.clear();
+
+  // The accesses after the segment now start a run on the effect phi.
+  if (begin >= kLanes) {
+    NodeVector* prefix = new (zone()) NodeVector(zone());
+    prefix->insert(prefix->end(), run->begin(), run->begin() + begin);
+    runs_.push_back(prefix);
+  }
+  run->erase(run->begin(), run->begin() + end + 1);
+}
+
+SLPVectorizer::Address SLPVectorizer::GetAddress(Node* node) const {
+  DCHECK(IsMemoryAccess(node));
+  IrOpcode::Value add_opcode =
+      machine()->Is64() ? IrOpcode::kInt64Add : IrOpcode::kInt32Add;
+  Address address = {node->InputAt(0), node->InputAt(1), 0,
+                     RelocInfo::NONE64};
+  for (Node** part : {&address.base, &address.index}) {
+    // The offsets of checked accesses are always 32-bit.
+    if (IsCheckedAccess(node) && part == &address.index) {
+      add_opcode = IrOpcode::kInt32Add;
+    }
+    int64_t value;
+    RelocInfo::Mode rmode;
+    while (true) {
+      if (GetIntegerConstant(*part, &value)) {
+        address.offset += value;
+        *part = nullptr;
+        break;
+      }
+      if (RelocInfo::IsNone(address.rmode) &&
+          GetRelocatableConstant(*part, &value, &rmode)) {
+        address.offset += value;
+        address.rmode = rmode;
+        *part = nullptr;
+        break;
+      }
+      if ((*part)->opcode() != add_opcode ||
+          !GetIntegerConstant((*part)->InputAt(1), &value)) {
+        break;
+      }
+      address.offset += value;
+      *part = (*part)->InputAt(0);
+    }
+  }
+  // The base and index inputs are interchangeable.
+  if (address.index != nullptr &&
+      (address.base == nullptr || address.base->id() > address.index->id())) {
+    std::swap(address.base, address.index);
+  }
+  return address;
+}
+
+bool SLPVectorizer::IsAdjacent(Address const& address,
+                               Address const& previous) const {
+  return address.base == previous.base && address.index == previous.index &&
+         address.rmode == previous.rmode &&
+         address.offset == previous.offset + kLaneSize;
+}
+
+bool SLPVectorizer::MayAlias(Node* node1, Node* node2) const {
+  Address address1 = GetAddress(node1);
+  Address address2 = GetAddress(node2);
+  if (address1.base != address2.base || address1.index != address2.index ||
+      address1.rmode != address2.rmode) {
+    return true;
+  }
+  int64_t size1 = 1 << ElementSizeLog2Of(AccessRepresentation(node1));
+  int64_t size2 = 1 << ElementSizeLog2Of(AccessRepresentation(node2));
+  return address1.offset < address2.offset + size2 &&
+         address2.offset < address1.offset + size1;
+}
+
+// static
+MachineRepresentation SLPVectorizer::AccessRepresentation(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kLoad:
+      return LoadRepresentationOf(node->op()).representation();
+    case IrOpcode::kStore:
+      return StoreRepresentationOf(node->op()).representation();
+    case IrOpcode::kCheckedLoad:
+      return CheckedLoadRepresentationOf(node->op()).representation();
+    case IrOpcode::kCheckedStore:
+      return CheckedStoreRepresentationOf(node->op());
+    default:
+      UNREACHABLE();
+      return MachineRepresentation::kNone;
+  }
+}
+
+// static
+bool SLPVectorizer::IsLoad(Node* node) {
+  return node->opcode() == IrOpcode::kLoad ||
+         node->opcode() == IrOpcode::kCheckedLoad;
+}
+
+// static
+bool SLPVectorizer::IsStore(Node* node) {
+  return node->opcode() == IrOpcode::kStore ||
+         node->opcode() == IrOpcode::kCheckedStore;
+}
+
+// static
+bool SLPVectorizer::IsCheckedAccess(Node* node) {
+  return node->opcode() == IrOpcode::kCheckedLoad ||
+         node->opcode() == IrOpcode::kCheckedStore;
+}
+
+// static
+Node* SLPVectorizer::StoredValue(Node* node) {
+  DCHECK(IsStore(node));
+  return node->InputAt(IsCheckedAccess(node) ? 3 : 2);
+}
+
+const Operator* SLPVectorizer::VectorOperator(Node* node) const {
+  switch (node->opcode()) {
+    case IrOpcode::kFloat32Add:
+      return machine()->Float32x4Add();
+    case IrOpcode::kFloat32Sub:
+      return machine()->Float32x4Sub();
+    case IrOpcode::kFloat32Mul:
+      return machine()->Float32x4Mul();
+    case IrOpcode::kFloat32Div:
+      return machine()->Float32x4Div();
+    case IrOpcode::kInt32Add:
+      return machine()->Int32x4Add();
+    case IrOpcode::kInt32Sub:
+      return machine()->Int32x4Sub();
+    default:
+      UNREACHABLE();
+      return nullptr;
+  }
+}
+
+SLPVectorizer::Pack* SLPVectorizer::FindPack(Node* node, int* lane) const {
+  for (Pack* pack : packs_) {
+    for (int i = 0; i < kLanes; ++i) {
+      if (pack->lanes[i] == node) {
+        *lane = i;
+        return pack;
+      }
+    }
+  }
+  return nullptr;
+}
+
+int SLPVectorizer::PositionOf(Node* node) const {
+  auto it = positions_.find(node->id());
+  return it == positions_.end() ? -1 : it->second;
+}
+
+int SLPVectorizer::TargetPosition(Pack* pack) const {
+  bool is_store = IsStore(pack->lanes[0]);
+  int target = PositionOf(pack->lanes[0]);
+  for (Node* lane : pack->lanes) {
+    int position = PositionOf(lane);
+    target = is_store ? std::max(target, position) : std::min(target, position);
+  }
+  return target;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
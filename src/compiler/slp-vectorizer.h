@@ -0,0 +1,141 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_SLP_VECTORIZER_H_
+#define V8_COMPILER_SLP_VECTORIZER_H_
+
+#include "src/assembler.h"
+#include "src/compiler/node.h"
+#include "src/machine-type.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class CommonOperatorBuilder;
+class Graph;
+class MachineOperatorBuilder;
+
+// Superword level parallelism vectorizer for machine graphs.
+//
+// Looks for groups of four 32-bit stores to adjacent addresses whose values
+// are computed by isomorphic trees of Float32 or Int32 arithmetic on 32-bit
+// loads from adjacent addresses, and replaces each group by a single 128-bit
+// store of a tree of Float32x4/Int32x4 operations on 128-bit loads.
+//
+// The pass works on straight-line code, i.e. on runs of loads and stores that
+// are chained directly on the effect chain and share the same control input.
+// Loads and stores are only reordered within such a run, and only if their
+// addresses are provably disjoint.
+//
+// Bounds-checked accesses (CheckedLoad and CheckedStore, as used for typed
+// arrays and asm.js heaps) are vectorized behind a guard: if all lanes of the
+// checked packs are in bounds, the vector code runs, otherwise the original
+// scalar accesses run and handle the out-of-bounds lanes individually.
+class SLPVectorizer final {
+ public:
+  SLPVectorizer(Graph* graph, CommonOperatorBuilder* common,
+                MachineOperatorBuilder* machine, Zone* zone);
+  ~SLPVectorizer() {}
+
+  void Vectorize();
+
+ private:
+  static const int kLanes = 4;
+
+  // An address of the form base + index + offset, where base and index are
+  // the parts of the address inputs that are not constant. If the offset
+  // includes a relocatable constant, e.g. the start of the wasm memory, its
+  // mode is recorded in rmode, which is RelocInfo::NONE64 otherwise.
+  struct Address {
+    Node* base;
+    Node* index;
+    int64_t offset;
+    RelocInfo::Mode rmode;
+  };
+
+  // A group of isomorphic nodes that are combined into one vector node. The
+  // lanes are ordered by increasing memory address.
+  struct Pack : public ZoneObject {
+    Node* lanes[kLanes];
+    Pack* inputs[2];
+    Node* vector;
+  };
+
+  // Tries to vectorize one group of stores in the given run of loads and
+  // stores, and updates the run accordingly. Returns true if the graph was
+  // changed.
+  bool VectorizeRun(NodeVector* run);
+  bool VectorizeStores(NodeVector* run, Node* const stores[kLanes]);
+
+  // Builds the pack computing the given value lanes, or returns nullptr.
+  Pack* BuildPack(Node* const lanes[kLanes], MachineRepresentation rep);
+  Pack* NewPack(Node* const lanes[kLanes]);
+  bool IsAdjacentMemoryAccess(Node* const lanes[kLanes]) const;
+  bool IsLegalReordering(NodeVector const& run, Pack* pack) const;
+  bool HasOnlyPackedUses(Pack* pack) const;
+  void EmitVectorNodes();
+  void RewriteRun(NodeVector* run);
+
+  // Support for packs of bounds-checked accesses. The accesses of all memory
+  // packs must form a segment of the run without other accesses, which is
+  // duplicated into a guarded vector path and the original scalar path.
+  bool HasCheckedPack() const;
+  bool GetPackedSegment(NodeVector const& run, int* begin, int* end) const;
+  void RewriteGuardedRun(NodeVector* run, int begin, int end);
+
+  void CollectRuns(ZoneVector<NodeVector*>* runs);
+  bool IsMemoryAccess(Node* node) const;
+  Node* NextInRun(Node* node) const;
+  bool IsAdjacentAccess(Node* node, Node* previous) const;
+
+  Address GetAddress(Node* node) const;
+  bool IsAdjacent(Address const& address, Address const& previous) const;
+  bool MayAlias(Node* node1, Node* node2) const;
+  static MachineRepresentation AccessRepresentation(Node* node);
+  static bool IsLoad(Node* node);
+  static bool IsStore(Node* node);
+  static bool IsCheckedAccess(Node* node);
+  static Node* StoredValue(Node* node);
+
+  const Operator* VectorOperator(Node* node) const;
+
+  Pack* FindPack(Node* node, int* lane) const;
+  int PositionOf(Node* node) const;
+
+  // The position in the run at which the vector node of a load or store pack
+  // is placed: loads are hoisted to the first lane and stores are sunk to the
+  // last lane.
+  int TargetPosition(Pack* pack) const;
+
+  Graph* graph() const { return graph_; }
+  CommonOperatorBuilder* common() const { return common_; }
+  MachineOperatorBuilder* machine() const { return machine_; }
+  Zone* zone() const { return zone_; }
+
+  Graph* const graph_;
+  CommonOperatorBuilder* const common_;
+  MachineOperatorBuilder* const machine_;
+  Zone* const zone_;
+
+  // The runs of loads and stores. Rewriting a guarded segment splits its run,
+  // and the part before the segment is added as a new run.
+  ZoneVector<NodeVector*> runs_;
+
+  // The packs of the tree that is currently being built, in post order.
+  ZoneVector<Pack*> packs_;
+
+  // Position of each node in the run that is currently being vectorized.
+  ZoneMap<NodeId, int> positions_;
+
+  DISALLOW_COPY_AND_ASSIGN(SLPVectorizer);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_SLP_VECTORIZER_H_
@@ -9,6 +9,7 @@
 #include "src/compilation-dependencies.h"
 #include "src/compiler/common-operator.h"
 #include "src/compiler/graph-reducer.h"
+#include "src/compiler/induction-variable-analysis.h"
 #include "src/compiler/js-operator.h"
 #include "src/compiler/node.h"
 #include "src/compiler/node-properties.h"
@@ -76,8 +77,11 @@ Typer::~Typer() {
 
 class Typer::Visitor : public Reducer {
  public:
-  explicit Visitor(Typer* typer)
-      : typer_(typer), weakened_nodes_(typer->zone()) {}
+  explicit Visitor(Typer* typer,
+                   InductionVariableAnalysis const* induction_vars = nullptr)
+      : typer_(typer),
+        induction_vars_(induction_vars),
+        weakened_nodes_(typer->zone()) {}
 
   Reduction Reduce(Node* node) override {
     if (node->op()->ValueOutputCount() == 0) return NoChange();
@@ -182,6 +186,7 @@ class Typer::Visitor : public Reducer {
 
  private:
   Typer* typer_;
+  InductionVariableAnalysis const* induction_vars_;
   ZoneSet<NodeId> weakened_nodes_;
 
 #define DECLARE_METHOD(x) inline Type* Type##x(Node* node);
@@ -202,6 +207,7 @@ class Typer::Visitor : public Reducer {
 
   Type* WrapContextTypeForInput(Node* node);
   Type* Weaken(Node* node, Type* current_type, Type* previous_type);
+  Type* NarrowInductionVariable(Node* node, Type* type);
 
   Zone* zone() { return typer_->zone(); }
   Isolate* isolate() { return typer_->isolate(); }
@@ -280,6 +286,10 @@ class Typer::Visitor : public Reducer {
       if (node->opcode() == IrOpcode::kPhi) {
         // Speed up termination in the presence of range types:
         current = Weaken(node, current, previous);
+        // Narrowing induction variables after weakening keeps them precise,
+        // and including the previous type keeps the typing monotonic.
+        current = Type::Union(NarrowInductionVariable(node, current), previous,
+                              zone());
       }
 
       CHECK(previous->Is(current));
@@ -302,12 +312,30 @@ class Typer::Visitor : public Reducer {
 void Typer::Run() { Run(NodeVector(zone())); }
 
 
-void Typer::Run(const NodeVector& roots) {
-  Visitor visitor(this);
+void Typer::Run(const NodeVector& roots,
+                InductionVariableAnalysis const* induction_vars) {
+  Visitor visitor(this, induction_vars);
   GraphReducer graph_reducer(zone(), graph());
   graph_reducer.AddReducer(&visitor);
   for (Node* const root : roots) graph_reducer.ReduceNode(root);
   graph_reducer.ReduceGraph();
+
+  if (induction_vars != nullptr) {
+    // The bound of an induction variable is not an input of its phi, so the
+    // phi is not revisited when the type of the bound changes. Retype the
+    // phis until they are consistent with the final types of their bounds.
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto const& entry : induction_vars->induction_variables()) {
+        Node* const phi = entry.second->phi();
+        if (!NodeProperties::IsTyped(phi)) continue;
+        Type* const previous = NodeProperties::GetType(phi);
+        graph_reducer.ReduceNode(phi);
+        if (!NodeProperties::GetType(phi)->Is(previous)) changed = true;
+      }
+    }
+  }
 }
 
 
@@ -690,7 +718,40 @@ Type* Typer::Visitor::TypePhi(Node* node) {
   for (int i = 1; i < arity; ++i) {
     type = Type::Union(type, Operand(node, i), zone());
   }
-  return type;
+  return NarrowInductionVariable(node, type);
+}
+
+
+// An induction variable with a positive step only reaches the back edge while
+// it is below its bound, so it never exceeds the largest value below the bound
+// plus the step. The analog holds for a negative step.
+Type* Typer::Visitor::NarrowInductionVariable(Node* node, Type* type) {
+  if (induction_vars_ == nullptr) return type;
+  InductionVariable* induction_var = induction_vars_->Get(node);
+  if (induction_var == nullptr) return type;
+
+  Type* const integer = typer_->cache_.kInteger;
+  Type* init_type = TypeOrNone(induction_var->init());
+  Type* bound_type = TypeOrNone(induction_var->bound());
+  if (!init_type->IsInhabited() || !init_type->Is(integer) ||
+      !bound_type->IsInhabited() || !bound_type->Is(integer)) {
+    return type;
+  }
+
+  double const step = induction_var->step();
+  double const strict_offset = induction_var->strict() ? 1.0 : 0.0;
+  double min;
+  double max;
+  if (step > 0) {
+    min = init_type->Min();
+    max = std::max(init_type->Max(),
+                   bound_type->Max() - strict_offset + step);
+  } else {
+    min = std::min(init_type->Min(),
+                   bound_type->Min() + strict_offset + step);
+    max = init_type->Max();
+  }
+  return Type::Intersect(type, Type::Range(min, max, zone()), zone());
 }
 
 
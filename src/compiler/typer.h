@@ -18,6 +18,9 @@ class TypeCache;
 
 namespace compiler {
 
+// Forward declarations.
+class InductionVariableAnalysis;
+
 
 class Typer {
  public:
@@ -35,7 +38,10 @@ class Typer {
 
   void Run();
   // TODO(bmeurer,jarin): Remove this once we have a notion of "roots" on Graph.
-  void Run(const ZoneVector<Node*>& roots);
+  // If {induction_vars} is given, the types of the induction variables are
+  // narrowed to the ranges that their loop tests allow.
+  void Run(const ZoneVector<Node*>& roots,
+           InductionVariableAnalysis const* induction_vars = nullptr);
 
  private:
   class Visitor;
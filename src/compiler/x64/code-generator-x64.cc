@@ -44,8 +44,7 @@ class X64OperandConverter : public InstructionOperandConverter {
       DCHECK_EQ(0, bit_cast<int64_t>(constant.ToFloat64()));
       return Immediate(0);
     }
-    if (constant.rmode() == RelocInfo::WASM_MEMORY_REFERENCE ||
-        constant.rmode() == RelocInfo::WASM_MEMORY_SIZE_REFERENCE) {
+    if (RelocInfo::IsWasmReference(constant.rmode())) {
       return Immediate(constant.ToInt32(), constant.rmode());
     }
     return Immediate(constant.ToInt32());
@@ -1412,6 +1411,24 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
         __ Movd(i.OutputDoubleRegister(), i.InputOperand(0));
       }
       break;
+    case kSSEFloat32x4Add:
+      __ addps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kSSEFloat32x4Sub:
+      __ subps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kSSEFloat32x4Mul:
+      __ mulps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kSSEFloat32x4Div:
+      __ divps(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kSSEInt32x4Add:
+      __ paddd(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
+    case kSSEInt32x4Sub:
+      __ psubd(i.OutputSimd128Register(), i.InputSimd128Register(1));
+      break;
     case kAVXFloat32Cmp: {
       CpuFeatureScope avx_scope(masm(), AVX);
       if (instr->InputAt(1)->IsFPRegister()) {
@@ -1611,6 +1628,15 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
         __ movss(operand, i.InputDoubleRegister(index));
       }
       break;
+    case kX64Movups:
+      if (instr->HasOutput()) {
+        __ movups(i.OutputSimd128Register(), i.MemoryOperand());
+      } else {
+        size_t index = 0;
+        Operand operand = i.MemoryOperand(&index);
+        __ movups(operand, i.InputSimd128Register(index));
+      }
+      break;
     case kX64Movsd:
       if (instr->HasOutput()) {
         __ Movsd(i.OutputDoubleRegister(), i.MemoryOperand());
@@ -2134,7 +2160,7 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
                                                : kScratchRegister;
       switch (src.type()) {
         case Constant::kInt32: {
-          if (src.rmode() == RelocInfo::WASM_MEMORY_REFERENCE) {
+          if (RelocInfo::IsWasmPtrReference(src.rmode())) {
             __ movq(dst, src.ToInt64(), src.rmode());
           } else {
             // TODO(dcarney): don't need scratch in this case.
@@ -2148,7 +2174,7 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
           break;
         }
         case Constant::kInt64:
-          if (src.rmode() == RelocInfo::WASM_MEMORY_REFERENCE) {
+          if (RelocInfo::IsWasmPtrReference(src.rmode())) {
             __ movq(dst, src.ToInt64(), src.rmode());
           } else {
             DCHECK(src.rmode() != RelocInfo::WASM_MEMORY_SIZE_REFERENCE);
@@ -2212,11 +2238,25 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
     if (destination->IsFPRegister()) {
       XMMRegister dst = g.ToDoubleRegister(destination);
       __ Movapd(dst, src);
+    } else if (destination->IsSimd128StackSlot()) {
+      Operand dst = g.ToOperand(destination);
+      __ movups(dst, src);
     } else {
       DCHECK(destination->IsFPStackSlot());
       Operand dst = g.ToOperand(destination);
       __ Movsd(dst, src);
     }
+  } else if (source->IsSimd128StackSlot()) {
+    DCHECK(destination->IsFPRegister() || destination->IsSimd128StackSlot());
+    Operand src = g.ToOperand(source);
+    if (destination->IsFPRegister()) {
+      __ movups(g.ToSimd128Register(destination), src);
+    } else {
+      // We rely on having xmm0 available as a fixed scratch register.
+      Operand dst = g.ToOperand(destination);
+      __ movups(xmm0, src);
+      __ movups(dst, xmm0);
+    }
   } else if (source->IsFPStackSlot()) {
     DCHECK(destination->IsFPRegister() || destination->IsFPStackSlot());
     Operand src = g.ToOperand(source);
@@ -2256,6 +2296,18 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     frame_access_state()->IncreaseSPDelta(-1);
     dst = g.ToOperand(destination);
     __ popq(dst);
+  } else if (source->IsSimd128StackSlot() &&
+             destination->IsSimd128StackSlot()) {
+    // Memory-memory swap of 128-bit values. We rely on having xmm0 available
+    // as a fixed scratch register.
+    Operand src = g.ToOperand(source);
+    Operand dst = g.ToOperand(destination);
+    __ movups(xmm0, src);
+    __ movq(kScratchRegister, dst);
+    __ movq(src, kScratchRegister);
+    __ movq(kScratchRegister, Operand(dst, kDoubleSize));
+    __ movq(Operand(src, kDoubleSize), kScratchRegister);
+    __ movups(dst, xmm0);
   } else if ((source->IsStackSlot() && destination->IsStackSlot()) ||
              (source->IsFPStackSlot() && destination->IsFPStackSlot())) {
     // Memory-memory.
@@ -2283,9 +2335,15 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     // available as a fixed scratch register.
     XMMRegister src = g.ToDoubleRegister(source);
     Operand dst = g.ToOperand(destination);
-    __ Movsd(xmm0, src);
-    __ Movsd(src, dst);
-    __ Movsd(dst, xmm0);
+    if (destination->IsSimd128StackSlot()) {
+      __ Movapd(xmm0, src);
+      __ movups(src, dst);
+      __ movups(dst, xmm0);
+    } else {
+      __ Movsd(xmm0, src);
+      __ Movsd(src, dst);
+      __ Movsd(dst, xmm0);
+    }
   } else {
     // No other combinations are possible.
     UNREACHABLE();
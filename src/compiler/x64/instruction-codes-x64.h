@@ -102,6 +102,12 @@ namespace compiler {
   V(SSEFloat64InsertLowWord32)     \
   V(SSEFloat64InsertHighWord32)    \
   V(SSEFloat64LoadLowWord32)       \
+  V(SSEFloat32x4Add)               \
+  V(SSEFloat32x4Sub)               \
+  V(SSEFloat32x4Mul)               \
+  V(SSEFloat32x4Div)               \
+  V(SSEInt32x4Add)                 \
+  V(SSEInt32x4Sub)                 \
   V(AVXFloat32Cmp)                 \
   V(AVXFloat32Add)                 \
   V(AVXFloat32Sub)                 \
@@ -131,6 +137,7 @@ namespace compiler {
   V(X64Movq)                       \
   V(X64Movsd)                      \
   V(X64Movss)                      \
+  V(X64Movups)                     \
   V(X64BitcastFI)                  \
   V(X64BitcastDL)                  \
   V(X64BitcastIF)                  \
@@ -104,6 +104,12 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kSSEFloat64InsertLowWord32:
     case kSSEFloat64InsertHighWord32:
     case kSSEFloat64LoadLowWord32:
+    case kSSEFloat32x4Add:
+    case kSSEFloat32x4Sub:
+    case kSSEFloat32x4Mul:
+    case kSSEFloat32x4Div:
+    case kSSEInt32x4Add:
+    case kSSEInt32x4Sub:
     case kAVXFloat32Cmp:
     case kAVXFloat32Add:
     case kAVXFloat32Sub:
@@ -159,6 +165,7 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kX64Movq:
     case kX64Movsd:
     case kX64Movss:
+    case kX64Movups:
       return instr->HasOutput() ? kIsLoadOperation : kHasSideEffect;
 
     case kX64StackCheck:
@@ -186,8 +193,222 @@ int InstructionScheduler::GetTargetInstructionFlags(
 
 
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // TODO(all): Add instruction cost modeling.
-  return 1;
+  // Approximate latencies of the code generated for x64 instructions on
+  // recent x86-64 cores (e.g. Intel Skylake, AMD Zen), taken from published
+  // instruction tables. Instructions with a memory operand additionally pay
+  // the load-to-use latency of the L1 cache.
+  const int kLoadLatency = 5;
+  const int memory_latency =
+      (instr->addressing_mode() != kMode_None) ? kLoadLatency : 0;
+  switch (instr->arch_opcode()) {
+    case kX64Add:
+    case kX64Add32:
+    case kX64And:
+    case kX64And32:
+    case kX64Cmp:
+    case kX64Cmp32:
+    case kX64Cmp16:
+    case kX64Cmp8:
+    case kX64Test:
+    case kX64Test32:
+    case kX64Test16:
+    case kX64Test8:
+    case kX64Or:
+    case kX64Or32:
+    case kX64Xor:
+    case kX64Xor32:
+    case kX64Sub:
+    case kX64Sub32:
+    case kX64Not:
+    case kX64Not32:
+    case kX64Neg:
+    case kX64Neg32:
+    case kX64Shl:
+    case kX64Shl32:
+    case kX64Shr:
+    case kX64Shr32:
+    case kX64Sar:
+    case kX64Sar32:
+    case kX64Ror:
+    case kX64Ror32:
+    case kX64Dec32:
+    case kX64Inc32:
+      return 1 + memory_latency;
+
+    case kX64Lea32:
+    case kX64Lea:
+      // The addressing mode of lea doesn't access memory.
+      return 1;
+
+    case kX64Imul:
+    case kX64Imul32:
+    case kX64Lzcnt:
+    case kX64Lzcnt32:
+    case kX64Tzcnt:
+    case kX64Tzcnt32:
+    case kX64Popcnt:
+    case kX64Popcnt32:
+      return 3 + memory_latency;
+
+    case kX64ImulHigh32:
+    case kX64UmulHigh32:
+      return 4 + memory_latency;
+
+    case kX64Idiv32:
+    case kX64Udiv32:
+      return 26 + memory_latency;
+
+    case kX64Idiv:
+    case kX64Udiv:
+      return 40 + memory_latency;
+
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movsxlq:
+    case kX64Movl:
+    case kX64Movq:
+    case kX64Movsd:
+    case kX64Movss:
+    case kX64Movups:
+      // Register to register moves and stores.
+      if (memory_latency == 0 || !instr->HasOutput()) return 1;
+      return kLoadLatency;
+
+    case kX64Movb:
+    case kX64Movw:
+    case kX64Push:
+    case kX64Poke:
+      return 1;
+
+    case kX64StackCheck:
+      return kLoadLatency;
+
+    case kX64Xchgb:
+    case kX64Xchgw:
+    case kX64Xchgl:
+      // xchg with a memory operand is implicitly locked.
+      return 20;
+
+    case kCheckedLoadInt8:
+    case kCheckedLoadUint8:
+    case kCheckedLoadInt16:
+    case kCheckedLoadUint16:
+    case kCheckedLoadWord32:
+    case kCheckedLoadWord64:
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+      return kLoadLatency + 1;
+
+    case kSSEInt32x4Add:
+    case kSSEInt32x4Sub:
+    case kSSEFloat32Abs:
+    case kSSEFloat32Neg:
+    case kSSEFloat64Abs:
+    case kSSEFloat64Neg:
+    case kAVXFloat32Abs:
+    case kAVXFloat32Neg:
+    case kAVXFloat64Abs:
+    case kAVXFloat64Neg:
+      return 1;
+
+    case kX64BitcastFI:
+    case kX64BitcastDL:
+    case kX64BitcastIF:
+    case kX64BitcastLD:
+    case kSSEFloat64ExtractLowWord32:
+    case kSSEFloat64ExtractHighWord32:
+    case kSSEFloat64InsertLowWord32:
+    case kSSEFloat64InsertHighWord32:
+    case kSSEFloat64LoadLowWord32:
+      return 2 + memory_latency;
+
+    case kSSEFloat32Cmp:
+    case kSSEFloat64Cmp:
+    case kAVXFloat32Cmp:
+    case kAVXFloat64Cmp:
+      return 3 + memory_latency;
+
+    case kSSEFloat32Add:
+    case kSSEFloat32Sub:
+    case kSSEFloat32Mul:
+    case kSSEFloat64Add:
+    case kSSEFloat64Sub:
+    case kSSEFloat64Mul:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat32Mul:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+    case kAVXFloat64Mul:
+    case kSSEFloat32x4Add:
+    case kSSEFloat32x4Sub:
+    case kSSEFloat32x4Mul:
+    case kSSEFloat32Max:
+    case kSSEFloat32Min:
+    case kSSEFloat64Max:
+    case kSSEFloat64Min:
+    case kAVXFloat32Max:
+    case kAVXFloat32Min:
+    case kAVXFloat64Max:
+    case kAVXFloat64Min:
+      return 4 + memory_latency;
+
+    case kSSEFloat32ToFloat64:
+    case kSSEFloat64ToFloat32:
+    case kSSEInt32ToFloat64:
+    case kSSEInt32ToFloat32:
+    case kSSEInt64ToFloat32:
+    case kSSEInt64ToFloat64:
+      return 5 + memory_latency;
+
+    case kSSEFloat32ToInt32:
+    case kSSEFloat64ToInt32:
+    case kSSEFloat32ToInt64:
+    case kSSEFloat64ToInt64:
+      return 6 + memory_latency;
+
+    case kSSEFloat32Round:
+    case kSSEFloat64Round:
+      return 8;
+
+    case kSSEFloat32ToUint32:
+    case kSSEFloat64ToUint32:
+    case kSSEUint32ToFloat64:
+    case kSSEUint32ToFloat32:
+      // Implemented via the 64-bit conversion.
+      return 7 + memory_latency;
+
+    case kSSEFloat32ToUint64:
+    case kSSEFloat64ToUint64:
+    case kSSEUint64ToFloat32:
+    case kSSEUint64ToFloat64:
+      // Multi-instruction sequences which handle the sign bit separately.
+      return 12;
+
+    case kSSEFloat32Div:
+    case kSSEFloat32x4Div:
+    case kAVXFloat32Div:
+      return 11 + memory_latency;
+
+    case kSSEFloat64Div:
+    case kAVXFloat64Div:
+      return 14 + memory_latency;
+
+    case kSSEFloat32Sqrt:
+      return 12 + memory_latency;
+
+    case kSSEFloat64Sqrt:
+      return 18 + memory_latency;
+
+    case kSSEFloat64Mod:
+      // Computed with an x87 fprem loop.
+      return 50;
+
+    default:
+      return 1;
+  }
 }
 
 }  // namespace compiler
@@ -161,7 +161,9 @@ void InstructionSelector::VisitLoad(Node* node) {
     case MachineRepresentation::kWord64:
       opcode = kX64Movq;
       break;
-    case MachineRepresentation::kSimd128:  // Fall through.
+    case MachineRepresentation::kSimd128:
+      opcode = kX64Movups;
+      break;
     case MachineRepresentation::kNone:
       UNREACHABLE();
       return;
@@ -246,7 +248,9 @@ void InstructionSelector::VisitStore(Node* node) {
       case MachineRepresentation::kWord64:
         opcode = kX64Movq;
         break;
-      case MachineRepresentation::kSimd128:  // Fall through.
+      case MachineRepresentation::kSimd128:
+        opcode = kX64Movups;
+        break;
       case MachineRepresentation::kNone:
         UNREACHABLE();
         return;
@@ -1124,6 +1128,18 @@ void VisitFloatBinop(InstructionSelector* selector, Node* node,
 }
 
 
+// Shared routine for lane-wise 128-bit operations. The SSE forms of these
+// instructions require aligned memory operands, so both inputs are kept in
+// registers.
+void VisitSimd128Binop(InstructionSelector* selector, Node* node,
+                       ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  selector->Emit(opcode, g.DefineSameAsFirst(node),
+                 g.UseRegister(node->InputAt(0)),
+                 g.UseRegister(node->InputAt(1)));
+}
+
+
 void VisitFloatUnop(InstructionSelector* selector, Node* node, Node* input,
                     ArchOpcode avx_opcode, ArchOpcode sse_opcode) {
   X64OperandGenerator g(selector);
@@ -1241,6 +1257,36 @@ void InstructionSelector::VisitFloat32Add(Node* node) {
 }
 
 
+void InstructionSelector::VisitFloat32x4Add(Node* node) {
+  VisitSimd128Binop(this, node, kSSEFloat32x4Add);
+}
+
+
+void InstructionSelector::VisitFloat32x4Sub(Node* node) {
+  VisitSimd128Binop(this, node, kSSEFloat32x4Sub);
+}
+
+
+void InstructionSelector::VisitFloat32x4Mul(Node* node) {
+  VisitSimd128Binop(this, node, kSSEFloat32x4Mul);
+}
+
+
+void InstructionSelector::VisitFloat32x4Div(Node* node) {
+  VisitSimd128Binop(this, node, kSSEFloat32x4Div);
+}
+
+
+void InstructionSelector::VisitInt32x4Add(Node* node) {
+  VisitSimd128Binop(this, node, kSSEInt32x4Add);
+}
+
+
+void InstructionSelector::VisitInt32x4Sub(Node* node) {
+  VisitSimd128Binop(this, node, kSSEInt32x4Sub);
+}
+
+
 void InstructionSelector::VisitFloat32Sub(Node* node) {
   X64OperandGenerator g(this);
   Float32BinopMatcher m(node);
@@ -2138,7 +2184,8 @@ InstructionSelector::SupportedMachineOperatorFlags() {
       MachineOperatorBuilder::kFloat64Max |
       MachineOperatorBuilder::kFloat64Min |
       MachineOperatorBuilder::kWord32ShiftIsSafe |
-      MachineOperatorBuilder::kWord32Ctz | MachineOperatorBuilder::kWord64Ctz;
+      MachineOperatorBuilder::kWord32Ctz | MachineOperatorBuilder::kWord64Ctz |
+      MachineOperatorBuilder::kSimd128Arithmetic;
   if (CpuFeatures::IsSupported(POPCNT)) {
     flags |= MachineOperatorBuilder::kWord32Popcnt |
              MachineOperatorBuilder::kWord64Popcnt;
@@ -710,7 +710,11 @@ class RuntimeCallTimerScope {
   HT(wasm_compile_module_time, V8.WasmCompileModuleMicroSeconds, 1000000,     \
      MICROSECOND)                                                             \
   HT(wasm_compile_function_time, V8.WasmCompileFunctionMicroSeconds, 1000000, \
-     MICROSECOND)
+     MICROSECOND)                                                             \
+  HT(wasm_serialize_module_time, V8.WasmSerializeModuleMicroSeconds, 1000000, \
+     MICROSECOND)                                                             \
+  HT(wasm_deserialize_module_time, V8.WasmDeserializeModuleMicroSeconds,      \
+     1000000, MICROSECOND)
 
 #define AGGREGATABLE_HISTOGRAM_TIMER_LIST(AHT) \
   AHT(compile_lazy, V8.CompileLazyMicroSeconds)
@@ -74,6 +74,10 @@ const int MB = 1024 * 1024;
 const int kMaxWorkers = 50;
 #endif
 
+// Length of the idle period granted to idle tasks whenever the message queues
+// of the shell run empty.
+const double kIdleTimeInSeconds = 0.05;
+
 
 class ShellArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
  public:
@@ -83,6 +87,7 @@ class ShellArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
   }
   virtual void* AllocateUninitialized(size_t length) { return malloc(length); }
   virtual void Free(void* data, size_t) { free(data); }
+  virtual bool IsFreeThreadSafe() { return true; }
 };
 
 
@@ -97,6 +102,7 @@ class MockArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
     return length > 10 * MB ? malloc(1) : malloc(length);
   }
   void Free(void* p, size_t) override { free(p); }
+  bool IsFreeThreadSafe() override { return true; }
 };
 
 
@@ -113,6 +119,11 @@ class PredictablePlatform : public Platform {
     delete task;
   }
 
+  void CallDelayedOnBackgroundThread(Task* task,
+                                     double delay_in_seconds) override {
+    delete task;
+  }
+
   void CallOnForegroundThread(v8::Isolate* isolate, Task* task) override {
     task->Run();
     delete task;
@@ -1939,6 +1950,18 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strcmp(argv[i], "--throws") == 0) {
       options.expected_to_throw = true;
       argv[i] = NULL;
+    } else if (strcmp(argv[i], "--enable-idle-tasks") == 0) {
+      options.enable_idle_tasks = true;
+      argv[i] = NULL;
+    } else if (strcmp(argv[i], "--enable-tracing") == 0) {
+      options.trace_enabled = true;
+      argv[i] = NULL;
+    } else if (strncmp(argv[i], "--trace-file=", 13) == 0) {
+      options.trace_file = argv[i] + 13;
+      argv[i] = NULL;
+    } else if (strncmp(argv[i], "--trace-categories=", 19) == 0) {
+      options.trace_categories = argv[i] + 19;
+      argv[i] = NULL;
     } else if (strncmp(argv[i], "--icu-data-file=", 16) == 0) {
       options.icu_data_file = argv[i] + 16;
       argv[i] = NULL;
@@ -2060,6 +2083,10 @@ void Shell::EmptyMessageQueues(Isolate* isolate) {
   if (!i::FLAG_verify_predictable) {
 #endif
     while (v8::platform::PumpMessageLoop(g_platform, isolate)) continue;
+    if (options.enable_idle_tasks) {
+      // All pending tasks ran, so the shell is idle until the next script.
+      v8::platform::RunIdleTasks(g_platform, isolate, kIdleTimeInSeconds);
+    }
 #ifndef V8_SHARED
   }
 #endif
@@ -2402,13 +2429,36 @@ int Shell::Main(int argc, char* argv[]) {
 #endif  // defined(_WIN32) || defined(_WIN64)
   if (!SetOptions(argc, argv)) return 1;
   v8::V8::InitializeICU(options.icu_data_file);
+  v8::platform::IdleTaskSupport idle_task_support =
+      options.enable_idle_tasks ? v8::platform::IdleTaskSupport::kEnabled
+                                : v8::platform::IdleTaskSupport::kDisabled;
 #ifndef V8_SHARED
   g_platform = i::FLAG_verify_predictable
                    ? new PredictablePlatform()
-                   : v8::platform::CreateDefaultPlatform();
+                   : v8::platform::CreateDefaultPlatform(0, idle_task_support);
 #else
-  g_platform = v8::platform::CreateDefaultPlatform();
+  g_platform = v8::platform::CreateDefaultPlatform(0, idle_task_support);
+#endif  // !V8_SHARED
+
+  // The trace file has to outlive the platform, which owns the JSON writer.
+  std::ofstream trace_file;
+  platform::tracing::TracingController* tracing_controller = NULL;
+  if (options.trace_enabled) {
+#ifndef V8_SHARED
+    if (i::FLAG_verify_predictable) {
+      printf("Tracing is not supported with --verify-predictable.\n");
+      return 1;
+    }
 #endif  // !V8_SHARED
+    trace_file.open(options.trace_file);
+    platform::tracing::TraceBuffer* trace_buffer =
+        platform::tracing::TraceBuffer::CreateTraceBufferRingBuffer(
+            platform::tracing::TraceBuffer::kRingBufferChunks,
+            platform::tracing::TraceWriter::CreateJSONTraceWriter(trace_file));
+    tracing_controller = new platform::tracing::TracingController();
+    tracing_controller->Initialize(trace_buffer);
+    platform::SetTracingController(g_platform, tracing_controller);
+  }
 
   v8::V8::InitializePlatform(g_platform);
   v8::V8::Initialize();
@@ -2446,6 +2496,12 @@ int Shell::Main(int argc, char* argv[]) {
     create_params.add_histogram_sample_callback = AddHistogramSample;
   }
 #endif
+  if (tracing_controller != NULL) {
+    platform::tracing::TraceConfig* trace_config =
+        new platform::tracing::TraceConfig();
+    trace_config->AddIncludedCategories(options.trace_categories);
+    tracing_controller->StartTracing(trace_config);
+  }
   Isolate* isolate = Isolate::New(create_params);
   {
     Isolate::Scope scope(isolate);
@@ -2517,6 +2573,7 @@ int Shell::Main(int argc, char* argv[]) {
     os << *profiler;
   }
 #endif  // !V8_SHARED
+  if (tracing_controller != NULL) tracing_controller->StopTracing();
   isolate->Dispose();
   V8::Dispose();
   V8::ShutdownPlatform();
@@ -285,6 +285,10 @@ class ShellOptions {
         dump_heap_constants(false),
         expected_to_throw(false),
         mock_arraybuffer_allocator(false),
+        enable_idle_tasks(false),
+        trace_enabled(false),
+        trace_file("v8_trace.json"),
+        trace_categories("v8"),
         num_isolates(1),
         compile_options(v8::ScriptCompiler::kNoCompileOptions),
         isolate_sources(NULL),
@@ -312,6 +316,10 @@ class ShellOptions {
   bool dump_heap_constants;
   bool expected_to_throw;
   bool mock_arraybuffer_allocator;
+  bool enable_idle_tasks;
+  bool trace_enabled;
+  const char* trace_file;
+  const char* trace_categories;
   int num_isolates;
   v8::ScriptCompiler::CompileOptions compile_options;
   SourceGroup* isolate_sources;
@@ -16,6 +16,10 @@ FrameInspector::FrameInspector(JavaScriptFrame* frame,
   is_bottommost_ = inlined_jsframe_index == 0;
   is_optimized_ = frame_->is_optimized();
   is_interpreted_ = frame_->is_interpreted();
+  if (is_interpreted_) {
+    SharedFunctionInfo::EnsureSourcePositionsAvailable(
+        handle(frame_->function()->shared(), isolate));
+  }
   // Calculate the deoptimized frame.
   if (frame->is_optimized()) {
     // TODO(turbofan): Revisit once we support deoptimization.
@@ -184,7 +184,7 @@ BreakLocation::BytecodeArrayIterator::BytecodeArrayIterator(
     : Iterator(debug_info),
       source_position_iterator_(debug_info->abstract_code()
                                     ->GetBytecodeArray()
-                                    ->source_position_table()),
+                                    ->SourcePositionTable()),
       break_locator_type_(type),
       start_position_(debug_info->shared()->start_position()) {
   // There is at least one break location.
@@ -1533,6 +1533,9 @@ bool Debug::EnsureDebugInfo(Handle<SharedFunctionInfo> shared,
   }
 
   if (shared->HasBytecodeArray()) {
+    // Break locations are found through the source positions, which the
+    // debug copy of the bytecode shares.
+    SharedFunctionInfo::EnsureSourcePositionsAvailable(shared);
     // To prepare bytecode for debugging, we already need to have the debug
     // info (containing the debug copy) upfront, but since we do not recompile,
     // preparing for break points cannot fail.
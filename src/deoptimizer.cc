@@ -2644,6 +2644,8 @@ Handle<Object> GetValueForDebugger(TranslatedFrame::iterator it,
 int ComputeSourcePosition(Handle<SharedFunctionInfo> shared,
                           BailoutId node_id) {
   if (shared->HasBytecodeArray()) {
+    // Bytecode may have been generated without source positions.
+    SharedFunctionInfo::EnsureSourcePositionsAvailable(shared);
     BytecodeArray* bytecodes = shared->bytecode_array();
     // BailoutId points to the next bytecode in the bytecode aray. Subtract
     // 1 to get the end of current bytecode.
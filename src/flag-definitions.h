@@ -303,6 +303,13 @@ DEFINE_BOOL(ignition, false, "use ignition interpreter")
 DEFINE_BOOL(ignition_eager, true, "eagerly compile and parse with ignition")
 DEFINE_BOOL(ignition_generators, false,
             "enable experimental ignition support for generators")
+DEFINE_BOOL(ignition_peephole, false, "use ignition peephole optimizer")
+DEFINE_BOOL(ignition_reo, false,
+            "use ignition register equivalence optimizer")
+DEFINE_BOOL(ignition_superinstructions, false,
+            "fuse frequent bytecode pairs into superinstructions")
+DEFINE_BOOL(lazy_source_positions, false,
+            "collect bytecode source positions only when they are needed")
 DEFINE_STRING(ignition_filter, "*", "filter for ignition interpreter")
 DEFINE_BOOL(print_bytecode, false,
             "print bytecode generated by ignition interpreter")
@@ -413,6 +420,7 @@ DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_BOOL(block_concurrent_recompilation, false,
             "block queued jobs until released")
+DEFINE_BOOL(concurrent_osr, false, "concurrent on-stack replacement")
 
 DEFINE_BOOL(omit_map_checks_for_leaf_maps, true,
             "do not emit check maps for constant values that have a leaf map, "
@@ -424,6 +432,11 @@ DEFINE_IMPLICATION(turbo, turbo_asm_deoptimization)
 DEFINE_BOOL(turbo_shipping, true, "enable TurboFan compiler on subset")
 DEFINE_BOOL(turbo_from_bytecode, false, "enable building graphs from bytecode")
 DEFINE_BOOL(turbo_greedy_regalloc, false, "use the greedy register allocator")
+DEFINE_BOOL(turbo_select_regalloc, false,
+            "use the greedy register allocator for functions with high "
+            "register pressure")
+DEFINE_BOOL(turbo_parallel_regalloc, false,
+            "allocate general and floating point registers in parallel")
 DEFINE_BOOL(turbo_sp_frame_access, false,
             "use stack pointer-relative access to frame wherever possible")
 DEFINE_BOOL(turbo_preprocess_ranges, true,
@@ -454,6 +467,8 @@ DEFINE_BOOL(function_context_specialization, false,
 DEFINE_BOOL(native_context_specialization, true,
             "enable native context specialization in TurboFan")
 DEFINE_BOOL(turbo_inlining, true, "enable inlining in TurboFan")
+DEFINE_BOOL(turbo_polymorphic_inlining, true,
+            "polymorphic inlining in TurboFan")
 DEFINE_BOOL(trace_turbo_inlining, false, "trace TurboFan inlining")
 DEFINE_BOOL(loop_assignment_analysis, true, "perform loop assignment analysis")
 DEFINE_BOOL(turbo_profiling, false, "enable profiling in TurboFan")
@@ -464,14 +479,23 @@ DEFINE_BOOL(turbo_jt, true, "enable jump threading in TurboFan")
 DEFINE_BOOL(turbo_stress_loop_peeling, false,
             "stress loop peeling optimization")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
+DEFINE_BOOL(turbo_induction_variables, false,
+            "narrow the types of loop induction variables in TurboFan")
+DEFINE_BOOL(turbo_bounds_check_elimination, false,
+            "eliminate redundant array bounds checks in TurboFan")
+DEFINE_BOOL(turbo_licm, false, "loop-invariant code motion in TurboFan")
 DEFINE_BOOL(turbo_frame_elision, true, "elide frames in TurboFan")
 DEFINE_BOOL(turbo_cache_shared_code, true, "cache context-independent code")
 DEFINE_BOOL(turbo_preserve_shared_code, false, "keep context-independent code")
 DEFINE_BOOL(experimental_turbo_escape, false, "enable escape analysis")
+DEFINE_BOOL(turbo_allocation_sinking, true,
+            "sink allocations into the branch where they escape")
 DEFINE_BOOL(turbo_instruction_scheduling, false,
             "enable instruction scheduling in TurboFan")
 DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
             "randomly schedule instructions to stress dependency tracking")
+DEFINE_BOOL(turbo_slp_vectorize, false,
+            "combine adjacent 32-bit memory operations into SIMD operations")
 
 // Flags for native WebAssembly.
 DEFINE_BOOL(expose_wasm, false, "expose WASM interface to JavaScript")
@@ -603,6 +627,9 @@ DEFINE_BOOL(trace_stub_failures, false,
 DEFINE_BOOL(serialize_toplevel, true, "enable caching of toplevel scripts")
 DEFINE_BOOL(serialize_eager, false, "compile eagerly when caching scripts")
 DEFINE_BOOL(serialize_age_code, false, "pre age code in the code cache")
+DEFINE_BOOL(serialize_optimized_code, false,
+            "include context-independent optimized code in the code cache")
+DEFINE_IMPLICATION(serialize_optimized_code, turbo_cache_shared_code)
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
 
 // compiler.cc
@@ -703,6 +730,9 @@ DEFINE_BOOL(trace_code_flushing, false, "trace code flushing progress")
 DEFINE_BOOL(age_code, true,
             "track un-executed functions to age code and flush only "
             "old code (required for code flushing)")
+DEFINE_BOOL(flush_bytecode, false,
+            "flush bytecode of functions that have not been executed "
+            "recently in GCs that reduce memory (requires --flush-code)")
 DEFINE_BOOL(incremental_marking, true, "use incremental marking")
 DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
            "keep finalizing incremental marking as long as we discover at "
@@ -711,6 +741,9 @@ DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
            "at most try this many times to finalize incremental marking")
 DEFINE_BOOL(black_allocation, true, "use black allocation")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_BOOL(concurrent_external_release, false,
+            "release the external resources of dead array buffers and "
+            "external strings on a background thread")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
@@ -880,7 +913,9 @@ DEFINE_BOOL(profile_hydrogen_code_stub_compilation, false,
 DEFINE_BOOL(predictable, false, "enable predictable mode")
 DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sweeping)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_external_release)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compaction)
+DEFINE_NEG_IMPLICATION(predictable, turbo_parallel_regalloc)
 DEFINE_NEG_IMPLICATION(predictable, memory_reducer)
 
 // mark-compact.cc
@@ -973,6 +973,13 @@ FrameSummary FrameSummary::GetFirst(JavaScriptFrame* frame) {
   return frames.first();
 }
 
+void FrameSummary::EnsureSourcePositionsAvailable() {
+  if (abstract_code_->IsBytecodeArray()) {
+    SharedFunctionInfo::EnsureSourcePositionsAvailable(
+        handle(function_->shared()));
+  }
+}
+
 void FrameSummary::Print() {
   PrintF("receiver: ");
   receiver_->ShortPrint();
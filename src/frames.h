@@ -654,6 +654,10 @@ class FrameSummary BASE_EMBEDDED {
   int code_offset() { return code_offset_; }
   bool is_constructor() { return is_constructor_; }
 
+  // Makes sure abstract_code()->SourcePosition() is accurate for bytecode
+  // compiled with --lazy-source-positions. May allocate.
+  void EnsureSourcePositionsAvailable();
+
   void Print();
 
  private:
@@ -3,7 +3,10 @@
 // found in the LICENSE file.
 
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/external-resource-releaser.h"
 #include "src/heap/heap.h"
+#include "src/heap/mark-compact.h"
+#include "src/heap/spaces-inl.h"
 #include "src/isolate.h"
 #include "src/objects.h"
 #include "src/objects-inl.h"
@@ -12,25 +15,69 @@
 namespace v8 {
 namespace internal {
 
-ArrayBufferTracker::~ArrayBufferTracker() {
-  Isolate* isolate = heap()->isolate();
+LocalArrayBufferTracker::~LocalArrayBufferTracker() {
+  DCHECK(array_buffers_.empty());
+}
+
+void LocalArrayBufferTracker::Add(Key key, const Value& value) {
+  DCHECK(!IsTracked(key));
+  array_buffers_[key] = value;
+}
+
+LocalArrayBufferTracker::Value LocalArrayBufferTracker::Remove(Key key) {
+  auto it = array_buffers_.find(key);
+  DCHECK(it != array_buffers_.end());
+  Value value = it->second;
+  array_buffers_.erase(it);
+  return value;
+}
+
+template <LocalArrayBufferTracker::FreeMode free_mode>
+size_t LocalArrayBufferTracker::Free() {
+  ExternalResourceReleaser* releaser = heap_->external_resource_releaser();
   size_t freed_memory = 0;
-  for (auto& buffer : live_array_buffers_) {
-    isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
-    freed_memory += buffer.second;
+  for (auto it = array_buffers_.begin(); it != array_buffers_.end();) {
+    if ((free_mode == kFreeAll) ||
+        !Marking::IsBlack(Marking::MarkBitFrom(it->first))) {
+      releaser->FreeBackingStore(it->second.first, it->second.second);
+      freed_memory += it->second.second;
+      it = array_buffers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return freed_memory;
+}
+
+void LocalArrayBufferTracker::ProcessForwarded(
+    std::vector<std::pair<Key, Value>>* moved) {
+  for (auto it = array_buffers_.begin(); it != array_buffers_.end();) {
+    MapWord map_word = it->first->map_word();
+    if (map_word.IsForwardingAddress()) {
+      Key new_key = JSArrayBuffer::cast(map_word.ToForwardingAddress());
+      moved->push_back(std::make_pair(new_key, it->second));
+      it = array_buffers_.erase(it);
+    } else {
+      ++it;
+    }
   }
-  for (auto& buffer : live_array_buffers_for_scavenge_) {
-    isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
-    freed_memory += buffer.second;
+}
+
+ArrayBufferTracker::~ArrayBufferTracker() {
+  // Free the backing stores of all buffers that are still alive when the heap
+  // is torn down. Array buffers only live in new and old space.
+  NewSpace* new_space = heap()->new_space();
+  NewSpacePageIterator to_space_it(new_space->ToSpaceStart(),
+                                   new_space->ToSpaceEnd());
+  while (to_space_it.has_next()) FreeAll(to_space_it.next());
+  if (new_space->IsFromSpaceCommitted()) {
+    NewSpacePageIterator from_space_it(new_space->FromSpaceStart(),
+                                       new_space->FromSpaceEnd());
+    while (from_space_it.has_next()) FreeAll(from_space_it.next());
   }
-  live_array_buffers_.clear();
-  live_array_buffers_for_scavenge_.clear();
-  not_yet_discovered_array_buffers_.clear();
-  not_yet_discovered_array_buffers_for_scavenge_.clear();
-
-  if (freed_memory > 0) {
-    heap()->update_amount_of_external_allocated_memory(
-        -static_cast<int64_t>(freed_memory));
+  if (heap()->old_space() != nullptr) {
+    PageIterator it(heap()->old_space());
+    while (it.has_next()) FreeAll(it.next());
   }
 }
 
@@ -39,13 +86,13 @@ void ArrayBufferTracker::RegisterNew(JSArrayBuffer* buffer) {
   void* data = buffer->backing_store();
   if (!data) return;
 
-  bool in_new_space = heap()->InNewSpace(buffer);
   size_t length = NumberToSize(heap()->isolate(), buffer->byte_length());
-  if (in_new_space) {
-    live_array_buffers_for_scavenge_[data] = length;
-  } else {
-    live_array_buffers_[data] = length;
+  Page* page = Page::FromAddress(buffer->address());
+  LocalArrayBufferTracker* tracker = page->local_tracker();
+  if (tracker == nullptr) {
+    tracker = page->AllocateLocalTracker();
   }
+  tracker->Add(buffer, std::make_pair(data, length));
 
   // We may go over the limit of externally allocated memory here. We call the
   // api function to trigger a GC in this case.
@@ -58,83 +105,81 @@ void ArrayBufferTracker::Unregister(JSArrayBuffer* buffer) {
   void* data = buffer->backing_store();
   if (!data) return;
 
-  bool in_new_space = heap()->InNewSpace(buffer);
-  std::map<void*, size_t>* live_buffers =
-      in_new_space ? &live_array_buffers_for_scavenge_ : &live_array_buffers_;
-  std::map<void*, size_t>* not_yet_discovered_buffers =
-      in_new_space ? &not_yet_discovered_array_buffers_for_scavenge_
-                   : &not_yet_discovered_array_buffers_;
-
-  DCHECK(live_buffers->count(data) > 0);
-
-  size_t length = (*live_buffers)[data];
-  live_buffers->erase(data);
-  not_yet_discovered_buffers->erase(data);
+  Page* page = Page::FromAddress(buffer->address());
+  LocalArrayBufferTracker* tracker = page->local_tracker();
+  DCHECK_NOT_NULL(tracker);
+  size_t length = tracker->Remove(buffer).second;
 
   heap()->update_amount_of_external_allocated_memory(
       -static_cast<int64_t>(length));
 }
 
 
-void ArrayBufferTracker::MarkLive(JSArrayBuffer* buffer) {
-  base::LockGuard<base::Mutex> guard(&mutex_);
-  void* data = buffer->backing_store();
-
-  // ArrayBuffer might be in the middle of being constructed.
-  if (data == heap()->undefined_value()) return;
-  if (heap()->InNewSpace(buffer)) {
-    not_yet_discovered_array_buffers_for_scavenge_.erase(data);
-  } else {
-    not_yet_discovered_array_buffers_.erase(data);
+void ArrayBufferTracker::FreeDeadInNewSpace() {
+  // After a scavenge all buffers that were alive before are on from-space
+  // pages. Surviving buffers have been evacuated, so everything that is left
+  // on these pages after processing is dead.
+  NewSpace* new_space = heap()->new_space();
+  NewSpacePageIterator it(new_space->FromSpaceStart(),
+                          new_space->FromSpaceEnd());
+  while (it.has_next()) {
+    Page* page = it.next();
+    ProcessBuffers(page);
+    FreeAll(page);
   }
 }
 
 
-void ArrayBufferTracker::FreeDead(bool from_scavenge) {
-  size_t freed_memory = 0;
-  Isolate* isolate = heap()->isolate();
-  for (auto& buffer : not_yet_discovered_array_buffers_for_scavenge_) {
-    isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
-    freed_memory += buffer.second;
-    live_array_buffers_for_scavenge_.erase(buffer.first);
-  }
-
-  if (!from_scavenge) {
-    for (auto& buffer : not_yet_discovered_array_buffers_) {
-      isolate->array_buffer_allocator()->Free(buffer.first, buffer.second);
-      freed_memory += buffer.second;
-      live_array_buffers_.erase(buffer.first);
-    }
-  }
+void ArrayBufferTracker::FreeDead(Page* page) {
+  LocalArrayBufferTracker* tracker = page->local_tracker();
+  if (tracker == nullptr) return;
+  size_t freed_memory = tracker->Free<LocalArrayBufferTracker::kFreeDead>();
+  if (tracker->IsEmpty()) page->ReleaseLocalTracker();
+  // Do not call through the api as this code is triggered while doing a GC.
+  heap()->update_amount_of_external_allocated_memory(
+      -static_cast<int64_t>(freed_memory));
+}
 
-  not_yet_discovered_array_buffers_for_scavenge_ =
-      live_array_buffers_for_scavenge_;
-  if (!from_scavenge) not_yet_discovered_array_buffers_ = live_array_buffers_;
 
+void ArrayBufferTracker::FreeAll(Page* page) {
+  LocalArrayBufferTracker* tracker = page->local_tracker();
+  if (tracker == nullptr) return;
+  size_t freed_memory = tracker->Free<LocalArrayBufferTracker::kFreeAll>();
+  page->ReleaseLocalTracker();
   // Do not call through the api as this code is triggered while doing a GC.
   heap()->update_amount_of_external_allocated_memory(
       -static_cast<int64_t>(freed_memory));
 }
 
 
-void ArrayBufferTracker::PrepareDiscoveryInNewSpace() {
-  not_yet_discovered_array_buffers_for_scavenge_ =
-      live_array_buffers_for_scavenge_;
-}
+void ArrayBufferTracker::ProcessBuffers(Page* page) {
+  LocalArrayBufferTracker* tracker = page->local_tracker();
+  if (tracker == nullptr) return;
 
+  // The source page is only processed by a single task. Entries are moved in
+  // one batch to keep the time spent under the lock short.
+  std::vector<std::pair<LocalArrayBufferTracker::Key,
+                        LocalArrayBufferTracker::Value>>
+      moved;
+  tracker->ProcessForwarded(&moved);
+  if (moved.empty()) return;
 
-void ArrayBufferTracker::Promote(JSArrayBuffer* buffer) {
   base::LockGuard<base::Mutex> guard(&mutex_);
+  for (auto& entry : moved) {
+    Page* target_page = Page::FromAddress(entry.first->address());
+    LocalArrayBufferTracker* target_tracker = target_page->local_tracker();
+    if (target_tracker == nullptr) {
+      target_tracker = target_page->AllocateLocalTracker();
+    }
+    target_tracker->Add(entry.first, entry.second);
+  }
+}
 
-  if (buffer->is_external()) return;
-  void* data = buffer->backing_store();
-  if (!data) return;
-  // ArrayBuffer might be in the middle of being constructed.
-  if (data == heap()->undefined_value()) return;
-  DCHECK(live_array_buffers_for_scavenge_.count(data) > 0);
-  live_array_buffers_[data] = live_array_buffers_for_scavenge_[data];
-  live_array_buffers_for_scavenge_.erase(data);
-  not_yet_discovered_array_buffers_for_scavenge_.erase(data);
+
+bool ArrayBufferTracker::IsTracked(JSArrayBuffer* buffer) {
+  LocalArrayBufferTracker* tracker =
+      Page::FromAddress(buffer->address())->local_tracker();
+  return tracker != nullptr && tracker->IsTracked(buffer);
 }
 
 }  // namespace internal
@@ -5,8 +5,10 @@
 #ifndef V8_HEAP_ARRAY_BUFFER_TRACKER_H_
 #define V8_HEAP_ARRAY_BUFFER_TRACKER_H_
 
-#include <map>
+#include <unordered_map>
+#include <vector>
 
+#include "src/allocation.h"
 #include "src/base/platform/mutex.h"
 #include "src/globals.h"
 
@@ -16,7 +18,51 @@ namespace internal {
 // Forward declarations.
 class Heap;
 class JSArrayBuffer;
+class Page;
 
+// Tracks the backing stores of the array buffers that live on a single page.
+// Entries are keyed by the JSArrayBuffer object, so the tracker has to be
+// processed whenever the objects on its page move.
+class LocalArrayBufferTracker {
+ public:
+  typedef JSArrayBuffer* Key;
+  typedef std::pair<void*, size_t> Value;
+
+  enum FreeMode { kFreeDead, kFreeAll };
+
+  explicit LocalArrayBufferTracker(Heap* heap) : heap_(heap) {}
+  ~LocalArrayBufferTracker();
+
+  void Add(Key key, const Value& value);
+  Value Remove(Key key);
+
+  // Frees the backing stores of all dead buffers (kFreeDead), i.e., buffers
+  // that have not been marked black, or of all buffers (kFreeAll). Returns the
+  // number of freed bytes.
+  template <FreeMode free_mode>
+  size_t Free();
+
+  // Removes the entries of evacuated buffers and appends them, keyed by their
+  // new location, to |moved|. Entries of buffers that did not move are kept.
+  void ProcessForwarded(std::vector<std::pair<Key, Value>>* moved);
+
+  bool IsEmpty() { return array_buffers_.empty(); }
+  bool IsTracked(Key key) {
+    return array_buffers_.find(key) != array_buffers_.end();
+  }
+
+ private:
+  Heap* heap_;
+  std::unordered_map<Key, Value> array_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(LocalArrayBufferTracker);
+};
+
+// Tracks the externally allocated backing stores of array buffers. The
+// backing stores are recorded on the page the owning JSArrayBuffer lives on
+// (see MemoryChunk::local_tracker()), so that pages can be processed
+// independently, e.g., in parallel by the evacuation tasks of the mark-compact
+// collector.
 class ArrayBufferTracker {
  public:
   explicit ArrayBufferTracker(Heap* heap) : heap_(heap) {}
@@ -33,42 +79,31 @@ class ArrayBufferTracker {
   // The backing store |data| is no longer owned by V8.
   void Unregister(JSArrayBuffer* buffer);
 
-  // A live ArrayBuffer was discovered during marking/scavenge.
-  void MarkLive(JSArrayBuffer* buffer);
+  // Frees the backing stores of all buffers that died in the last scavenge
+  // and moves the entries of the surviving ones to their new pages. Called on
+  // the main thread after the scavenge has finished.
+  void FreeDeadInNewSpace();
+
+  // Frees the backing stores of all buffers on |page| that have not been
+  // marked. Has to be called before the mark bits of the page are cleared.
+  void FreeDead(Page* page);
 
-  // Frees all backing store pointers that weren't discovered in the previous
-  // marking or scavenge phase.
-  void FreeDead(bool from_scavenge);
+  // Frees the backing stores of all buffers that are still tracked on |page|.
+  void FreeAll(Page* page);
 
-  // Prepare for a new scavenge phase. A new marking phase is implicitly
-  // prepared by finishing the previous one.
-  void PrepareDiscoveryInNewSpace();
+  // Moves the entries of buffers that have been evacuated from |page| to the
+  // pages they have been evacuated to. Can be called concurrently for
+  // different pages.
+  void ProcessBuffers(Page* page);
 
-  // An ArrayBuffer moved from new space to old space.
-  void Promote(JSArrayBuffer* buffer);
+  // Returns whether |buffer| is tracked on its current page. Used in tests.
+  bool IsTracked(JSArrayBuffer* buffer);
 
  private:
+  // Protects the lazy allocation of page local trackers and the insertion of
+  // entries from concurrent evacuation tasks.
   base::Mutex mutex_;
   Heap* heap_;
-
-  // |live_array_buffers_| maps externally allocated memory used as backing
-  // store for ArrayBuffers to the length of the respective memory blocks.
-  //
-  // At the beginning of mark/compact, |not_yet_discovered_array_buffers_| is
-  // a copy of |live_array_buffers_| and we remove pointers as we discover live
-  // ArrayBuffer objects during marking. At the end of mark/compact, the
-  // remaining memory blocks can be freed.
-  std::map<void*, size_t> live_array_buffers_;
-  std::map<void*, size_t> not_yet_discovered_array_buffers_;
-
-  // To be able to free memory held by ArrayBuffers during scavenge as well, we
-  // have a separate list of allocated memory held by ArrayBuffers in new space.
-  //
-  // Since mark/compact also evacuates the new space, all pointers in the
-  // |live_array_buffers_for_scavenge_| list are also in the
-  // |live_array_buffers_| list.
-  std::map<void*, size_t> live_array_buffers_for_scavenge_;
-  std::map<void*, size_t> not_yet_discovered_array_buffers_for_scavenge_;
 };
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,103 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/external-resource-releaser.h"
+
+#include "src/heap/heap.h"
+#include "src/isolate.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+class ExternalResourceReleaser::ReleaseTask : public v8::Task {
+ public:
+  ReleaseTask(ExternalResourceReleaser* releaser, Batch* batch)
+      : releaser_(releaser), batch_(batch) {}
+
+ private:
+  // v8::Task overrides.
+  void Run() override {
+    releaser_->PerformRelease(batch_);
+    delete batch_;
+    releaser_->pending_release_tasks_semaphore_.Signal(
+        "ExternalResourceReleaser::ReleaseTask::Run");
+  }
+
+  ExternalResourceReleaser* releaser_;
+  Batch* batch_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReleaseTask);
+};
+
+ExternalResourceReleaser::ExternalResourceReleaser(Heap* heap)
+    : heap_(heap),
+      queued_(new Batch()),
+      pending_release_tasks_semaphore_(0),
+      concurrent_release_tasks_active_(0) {}
+
+ExternalResourceReleaser::~ExternalResourceReleaser() {
+  DCHECK_EQ(0, concurrent_release_tasks_active_);
+  DCHECK(queued_->IsEmpty());
+  delete queued_;
+}
+
+bool ExternalResourceReleaser::ReleaseBackingStoresConcurrently() {
+  return FLAG_concurrent_external_release &&
+         heap_->isolate()->array_buffer_allocator()->IsFreeThreadSafe();
+}
+
+bool ExternalResourceReleaser::ReleaseStringResourcesConcurrently(
+    v8::String::ExternalStringResourceBase* resource) {
+  return FLAG_concurrent_external_release && resource->IsDisposeThreadSafe();
+}
+
+void ExternalResourceReleaser::FreeBackingStore(void* data, size_t length) {
+  if (ReleaseBackingStoresConcurrently()) {
+    queued_->backing_stores.push_back(std::make_pair(data, length));
+  } else {
+    heap_->isolate()->array_buffer_allocator()->Free(data, length);
+  }
+}
+
+void ExternalResourceReleaser::DisposeStringResource(
+    v8::String::ExternalStringResourceBase* resource) {
+  if (ReleaseStringResourcesConcurrently(resource)) {
+    queued_->string_resources.push_back(resource);
+  } else {
+    resource->Dispose();
+  }
+}
+
+void ExternalResourceReleaser::ReleaseQueued() {
+  if (queued_->IsEmpty()) return;
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      new ReleaseTask(this, queued_), v8::Platform::kShortRunningTask);
+  concurrent_release_tasks_active_++;
+  queued_ = new Batch();
+}
+
+void ExternalResourceReleaser::TearDown() {
+  while (concurrent_release_tasks_active_ > 0) {
+    pending_release_tasks_semaphore_.Wait();
+    concurrent_release_tasks_active_--;
+  }
+  PerformRelease(queued_);
+  queued_->backing_stores.clear();
+  queued_->string_resources.clear();
+}
+
+void ExternalResourceReleaser::PerformRelease(Batch* batch) {
+  v8::ArrayBuffer::Allocator* allocator =
+      heap_->isolate()->array_buffer_allocator();
+  for (auto& backing_store : batch->backing_stores) {
+    allocator->Free(backing_store.first, backing_store.second);
+  }
+  for (auto resource : batch->string_resources) {
+    resource->Dispose();
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,77 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_EXTERNAL_RESOURCE_RELEASER_H_
+#define V8_HEAP_EXTERNAL_RESOURCE_RELEASER_H_
+
+#include <vector>
+
+#include "include/v8.h"
+#include "src/allocation.h"
+#include "src/base/platform/semaphore.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Releases the external resources of dead objects, i.e., array buffer backing
+// stores and external string resources. With --concurrent-external-release
+// the resources found during a garbage collection are batched and handed to
+// a background task at the end of the collection, instead of calling into the
+// embedder while the pause is running. Backing stores are only released
+// concurrently if the array buffer allocator declares Free as thread-safe,
+// string resources only if they declare Dispose as thread-safe.
+class ExternalResourceReleaser {
+ public:
+  explicit ExternalResourceReleaser(Heap* heap);
+  ~ExternalResourceReleaser();
+
+  // Frees or queues the backing store |data| of |length| bytes.
+  void FreeBackingStore(void* data, size_t length);
+
+  // Disposes or queues the resource of a dead external string.
+  void DisposeStringResource(v8::String::ExternalStringResourceBase* resource);
+
+  // Hands all queued resources to a background task. Called at the end of a
+  // garbage collection.
+  void ReleaseQueued();
+
+  // Waits for all background tasks and releases the remaining resources on
+  // the main thread.
+  void TearDown();
+
+ private:
+  class ReleaseTask;
+
+  struct Batch {
+    std::vector<std::pair<void*, size_t>> backing_stores;
+    std::vector<v8::String::ExternalStringResourceBase*> string_resources;
+
+    bool IsEmpty() {
+      return backing_stores.empty() && string_resources.empty();
+    }
+  };
+
+  bool ReleaseBackingStoresConcurrently();
+  bool ReleaseStringResourcesConcurrently(
+      v8::String::ExternalStringResourceBase* resource);
+
+  void PerformRelease(Batch* batch);
+
+  Heap* heap_;
+  // Only accessed on the main thread. Batches that have been handed to a
+  // background task are owned by the task.
+  Batch* queued_;
+  base::Semaphore pending_release_tasks_semaphore_;
+  intptr_t concurrent_release_tasks_active_;
+
+  DISALLOW_COPY_AND_ASSIGN(ExternalResourceReleaser);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_EXTERNAL_RESOURCE_RELEASER_H_
@@ -9,6 +9,7 @@
 
 #include "src/base/platform/platform.h"
 #include "src/counters.h"
+#include "src/heap/external-resource-releaser.h"
 #include "src/heap/heap.h"
 #include "src/heap/incremental-marking-inl.h"
 #include "src/heap/mark-compact.h"
@@ -355,7 +356,7 @@ void Heap::FinalizeExternalString(String* string) {
 
   // Dispose of the C++ object if it has not already been disposed.
   if (*resource_addr != NULL) {
-    (*resource_addr)->Dispose();
+    external_resource_releaser()->DisposeStringResource(*resource_addr);
     *resource_addr = NULL;
   }
 }
@@ -286,6 +286,7 @@ using v8::MemoryPressureLevel;
 // Forward declarations.
 class AllocationObserver;
 class ArrayBufferTracker;
+class ExternalResourceReleaser;
 class GCIdleTimeAction;
 class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
@@ -851,6 +852,10 @@ class Heap {
     return memory_pressure_level_.Value() != MemoryPressureLevel::kNone;
   }
 
+  inline bool ShouldReduceMemory() const {
+    return current_gc_flags_ & kReduceMemoryFootprintMask;
+  }
+
   // ===========================================================================
   // Initialization. ===========================================================
   // ===========================================================================
@@ -1344,6 +1349,10 @@ class Heap {
     return array_buffer_tracker_;
   }
 
+  inline ExternalResourceReleaser* external_resource_releaser() {
+    return external_resource_releaser_;
+  }
+
   // ===========================================================================
   // Allocation site tracking. =================================================
   // ===========================================================================
@@ -1511,10 +1520,6 @@ class Heap {
            !ShouldAbortIncrementalMarking());
   }
 
-  inline bool ShouldReduceMemory() const {
-    return current_gc_flags_ & kReduceMemoryFootprintMask;
-  }
-
   inline bool ShouldAbortIncrementalMarking() const {
     return current_gc_flags_ & kAbortIncrementalMarkingMask;
   }
@@ -2220,6 +2225,8 @@ class Heap {
 
   ArrayBufferTracker* array_buffer_tracker_;
 
+  ExternalResourceReleaser* external_resource_releaser_;
+
   // The depth of HeapIterator nestings.
   int heap_iterator_depth_;
 
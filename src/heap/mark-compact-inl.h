@@ -77,6 +77,11 @@ void CodeFlusher::AddCandidate(SharedFunctionInfo* shared_info) {
 }
 
 
+void CodeFlusher::AddBytecodeCandidate(SharedFunctionInfo* shared_info) {
+  bytecode_candidates_.Add(shared_info);
+}
+
+
 void CodeFlusher::AddCandidate(JSFunction* function) {
   DCHECK(function->code() == function->shared()->code());
   if (function->next_function_link()->IsUndefined()) {
@@ -1038,6 +1038,51 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
 }
 
 
+void CodeFlusher::ProcessBytecodeCandidates() {
+  Code* lazy_compile = isolate_->builtins()->builtin(Builtins::kCompileLazy);
+  MarkCompactCollector* collector = isolate_->heap()->mark_compact_collector();
+
+  for (int i = 0; i < bytecode_candidates_.length(); i++) {
+    SharedFunctionInfo* candidate = bytecode_candidates_[i];
+    // Candidates recorded by an aborted incremental marking may have died
+    // since, and a candidate may have been recorded more than once.
+    if (Marking::IsWhite(Marking::MarkBitFrom(candidate))) continue;
+
+    Object* function_data = candidate->function_data();
+    if (function_data->IsBytecodeArray() &&
+        Marking::IsWhite(
+            Marking::MarkBitFrom(HeapObject::cast(function_data)))) {
+      if (FLAG_trace_code_flushing) {
+        PrintF("[bytecode-flushing clears: ");
+        candidate->ShortPrint();
+        PrintF(" - age: %d]\n",
+               BytecodeArray::cast(function_data)->bytecode_age());
+      }
+      // Optimized code deoptimizes to the bytecode, drop it as well.
+      if (!candidate->OptimizedCodeMapIsCleared()) {
+        candidate->ClearOptimizedCodeMap();
+      }
+      candidate->ClearBytecodeArray();
+      if (candidate->code()->is_interpreter_entry_trampoline()) {
+        candidate->set_code(lazy_compile);
+      }
+    }
+
+    Object** code_slot =
+        HeapObject::RawField(candidate, SharedFunctionInfo::kCodeOffset);
+    collector->RecordSlot(candidate, code_slot, *code_slot);
+    Object** function_data_slot =
+        HeapObject::RawField(candidate, SharedFunctionInfo::kFunctionDataOffset);
+    if ((*function_data_slot)->IsHeapObject()) {
+      collector->RecordSlot(candidate, function_data_slot,
+                            *function_data_slot);
+    }
+  }
+
+  bytecode_candidates_.Rewind(0);
+}
+
+
 void CodeFlusher::EvictCandidate(SharedFunctionInfo* shared_info) {
   // Make sure previous flushing decisions are revisited.
   isolate_->heap()->incremental_marking()->IterateBlackObject(shared_info);
@@ -1672,20 +1717,12 @@ class MarkCompactCollector::EvacuateNewSpaceVisitor final
     if (heap_->ShouldBePromoted(object->address(), size) &&
         TryEvacuateObject(compaction_spaces_->Get(OLD_SPACE), object,
                           &target_object)) {
-      // If we end up needing more special cases, we should factor this out.
-      if (V8_UNLIKELY(target_object->IsJSArrayBuffer())) {
-        heap_->array_buffer_tracker()->Promote(
-            JSArrayBuffer::cast(target_object));
-      }
       promoted_size_ += size;
       return true;
     }
     HeapObject* target = nullptr;
     AllocationSpace space = AllocateTargetObject(object, &target);
     MigrateObject(HeapObject::cast(target), object, size, space);
-    if (V8_UNLIKELY(target->IsJSArrayBuffer())) {
-      heap_->array_buffer_tracker()->MarkLive(JSArrayBuffer::cast(target));
-    }
     semispace_copied_size_ += size;
     return true;
   }
@@ -1809,10 +1846,6 @@ class MarkCompactCollector::EvacuateNewSpacePageVisitor final
   }
 
   inline bool Visit(HeapObject* object) {
-    if (V8_UNLIKELY(object->IsJSArrayBuffer())) {
-      object->GetHeap()->array_buffer_tracker()->Promote(
-          JSArrayBuffer::cast(object));
-    }
     RecordMigratedSlotVisitor visitor;
     object->IterateBodyFast(&visitor);
     promoted_size_ += object->Size();
@@ -3242,16 +3275,24 @@ class EvacuationJobTraits {
 
   static bool ProcessPageInParallel(Heap* heap, PerTaskData evacuator,
                                     MemoryChunk* chunk, PerPageData) {
-    return evacuator->EvacuatePage(reinterpret_cast<Page*>(chunk));
+    Page* page = reinterpret_cast<Page*>(chunk);
+    bool success = evacuator->EvacuatePage(page);
+    // Buffers that have been evacuated are moved to the trackers of their
+    // target pages. The remaining ones are freed during finalization.
+    heap->array_buffer_tracker()->ProcessBuffers(page);
+    return success;
   }
 
   static void FinalizePageSequentially(Heap* heap, MemoryChunk* chunk,
                                        bool success, PerPageData data) {
     if (chunk->InNewSpace()) {
       DCHECK(success);
+      // All live objects have been evacuated from the page.
+      heap->array_buffer_tracker()->FreeAll(static_cast<Page*>(chunk));
     } else if (chunk->IsFlagSet(Page::PAGE_NEW_OLD_PROMOTION)) {
       DCHECK(success);
       Page* p = static_cast<Page*>(chunk);
+      heap->array_buffer_tracker()->FreeDead(p);
       p->ClearFlag(Page::PAGE_NEW_OLD_PROMOTION);
       p->ForAllFreeListCategories(
           [](FreeListCategory* category) { DCHECK(!category->is_linked()); });
@@ -3262,12 +3303,15 @@ class EvacuationJobTraits {
       if (success) {
         DCHECK(p->IsEvacuationCandidate());
         DCHECK(p->SweepingDone());
+        heap->array_buffer_tracker()->FreeAll(p);
         p->Unlink();
       } else {
         // We have partially compacted the page, i.e., some objects may have
         // moved, others are still in place.
         p->SetFlag(Page::COMPACTION_WAS_ABORTED);
         p->ClearEvacuationCandidate();
+        // Objects that have not been evacuated are still marked.
+        heap->array_buffer_tracker()->FreeDead(p);
         // Slots have already been recorded so we just need to add it to the
         // sweeper.
         *data += 1;
@@ -3557,11 +3601,6 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
       }
     }
 
-    // EvacuateNewSpaceAndCandidates iterates over new space objects and for
-    // ArrayBuffers either re-registers them as live or promotes them. This is
-    // needed to properly free them.
-    heap()->array_buffer_tracker()->FreeDead(false);
-
     // Deallocate evacuated candidate pages.
     ReleaseEvacuationCandidates();
   }
@@ -3845,6 +3884,10 @@ void MarkCompactCollector::StartSweepSpace(PagedSpace* space) {
       continue;
     }
 
+    // Backing stores of dead array buffers are freed before the mark bits are
+    // cleared by the sweeper.
+    heap()->array_buffer_tracker()->FreeDead(p);
+
     if (p->IsFlagSet(Page::NEVER_ALLOCATE_ON_PAGE)) {
       // We need to sweep the page to get it into an iterable state again. Note
       // that this adds unusable memory into the free list that is later on
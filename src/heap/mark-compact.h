@@ -281,11 +281,17 @@ class CodeFlusher {
   inline void AddCandidate(SharedFunctionInfo* shared_info);
   inline void AddCandidate(JSFunction* function);
 
+  // Bytecode candidates are shared function infos whose bytecode array is
+  // treated weakly. Their code is the interpreter entry trampoline, so the
+  // candidates cannot be linked through the code object.
+  inline void AddBytecodeCandidate(SharedFunctionInfo* shared_info);
+
   void EvictCandidate(SharedFunctionInfo* shared_info);
   void EvictCandidate(JSFunction* function);
 
   void ProcessCandidates() {
     ProcessSharedFunctionInfoCandidates();
+    ProcessBytecodeCandidates();
     ProcessJSFunctionCandidates();
   }
 
@@ -294,6 +300,7 @@ class CodeFlusher {
  private:
   void ProcessJSFunctionCandidates();
   void ProcessSharedFunctionInfoCandidates();
+  void ProcessBytecodeCandidates();
 
   static inline JSFunction** GetNextCandidateSlot(JSFunction* candidate);
   static inline JSFunction* GetNextCandidate(JSFunction* candidate);
@@ -311,6 +318,9 @@ class CodeFlusher {
   Isolate* isolate_;
   JSFunction* jsfunction_candidates_head_;
   SharedFunctionInfo* shared_function_info_candidates_head_;
+  // Shared function infos live in old space, so they do not move before the
+  // candidates are processed.
+  List<SharedFunctionInfo*> bytecode_candidates_;
 
   DISALLOW_COPY_AND_ASSIGN(CodeFlusher);
 };
@@ -17,7 +17,9 @@ class Heap;
 
 // The goal of the MemoryReducer class is to detect transition of the mutator
 // from high allocation phase to low allocation phase and to collect potential
-// garbage created in the high allocation phase.
+// garbage created in the high allocation phase. The GCs started by the
+// MemoryReducer reduce memory, which includes flushing the bytecode of
+// functions that have not been executed recently (see --flush-bytecode).
 //
 // The class implements an automaton with the following states and transitions.
 //
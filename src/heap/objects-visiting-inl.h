@@ -106,10 +106,6 @@ int StaticNewSpaceVisitor<StaticVisitor>::VisitJSArrayBuffer(
   typedef FlexibleBodyVisitor<StaticVisitor, JSArrayBuffer::BodyDescriptor, int>
       JSArrayBufferBodyVisitor;
 
-  if (!JSArrayBuffer::cast(object)->is_external()) {
-    Heap* heap = map->GetHeap();
-    heap->array_buffer_tracker()->MarkLive(JSArrayBuffer::cast(object));
-  }
   return JSArrayBufferBodyVisitor::Visit(map, object);
 }
 
@@ -447,6 +443,11 @@ void StaticMarkingVisitor<StaticVisitor>::VisitCode(Map* map,
   if (FLAG_age_code && !heap->isolate()->serializer_enabled()) {
     code->MakeOlder(heap->mark_compact_collector()->marking_parity());
   }
+  if (FLAG_flush_bytecode &&
+      heap->mark_compact_collector()->is_code_flushing_enabled() &&
+      code->kind() == Code::OPTIMIZED_FUNCTION) {
+    MarkInlinedFunctionsBytecode(heap, code);
+  }
   CodeBodyVisitor::Visit(map, object);
 }
 
@@ -482,6 +483,15 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfo(
       VisitSharedFunctionInfoWeakCode(heap, object);
       return;
     }
+    if (IsFlushableBytecode(heap, shared)) {
+      // This function's bytecode looks flushable. The decision is again
+      // postponed, closures that are optimized or not flushable and
+      // optimized code inlining the function mark the bytecode array.
+      collector->code_flusher()->AddBytecodeCandidate(shared);
+      // Treat the reference to the bytecode array weakly.
+      VisitSharedFunctionInfoWeakBytecode(heap, object);
+      return;
+    }
   }
   VisitSharedFunctionInfoStrongCode(heap, object);
 }
@@ -505,9 +515,21 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSFunction(Map* map,
       // Treat the reference to the code object weakly.
       VisitJSFunctionWeakCode(map, object);
       return;
-    } else {
-      // Visit all unoptimized code objects to prevent flushing them.
-      StaticVisitor::MarkObject(heap, function->shared()->code());
+    }
+    SharedFunctionInfo* shared = function->shared();
+    if (function->code() == shared->code() &&
+        IsFlushableBytecode(heap, shared)) {
+      // The bytecode of this function looks flushable. Remember the closure
+      // so that its code can be reset to the lazy compile builtin together
+      // with the code of its SharedFunctionInfo.
+      collector->code_flusher()->AddCandidate(function);
+      VisitJSFunctionWeakCode(map, object);
+      return;
+    }
+    // Visit all unoptimized code objects to prevent flushing them.
+    StaticVisitor::MarkObject(heap, shared->code());
+    if (shared->HasBytecodeArray()) {
+      StaticVisitor::MarkObject(heap, shared->bytecode_array());
     }
   }
   VisitJSFunctionStrongCode(map, object);
@@ -524,25 +546,22 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSRegExp(Map* map,
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitJSArrayBuffer(
     Map* map, HeapObject* object) {
-  Heap* heap = map->GetHeap();
-
   typedef FlexibleBodyVisitor<StaticVisitor, JSArrayBuffer::BodyDescriptor,
                               void> JSArrayBufferBodyVisitor;
 
   JSArrayBufferBodyVisitor::Visit(map, object);
-
-  if (!JSArrayBuffer::cast(object)->is_external() &&
-      !heap->InNewSpace(object)) {
-    heap->array_buffer_tracker()->MarkLive(JSArrayBuffer::cast(object));
-  }
 }
 
 
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitBytecodeArray(
     Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  if (FLAG_flush_bytecode && !heap->isolate()->serializer_enabled()) {
+    BytecodeArray::cast(object)->MakeOlder();
+  }
   StaticVisitor::VisitPointers(
-      map->GetHeap(), object,
+      heap, object,
       HeapObject::RawField(object, BytecodeArray::kConstantPoolOffset),
       HeapObject::RawField(object, BytecodeArray::kFrameSizeOffset));
 }
@@ -683,6 +702,74 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
 }
 
 
+template <typename StaticVisitor>
+bool StaticMarkingVisitor<StaticVisitor>::IsFlushableBytecode(
+    Heap* heap, SharedFunctionInfo* shared_info) {
+  if (!FLAG_flush_bytecode) return false;
+
+  // Bytecode is only flushed by GCs that try to reduce memory, e.g. the ones
+  // started by the memory reducer. Black allocated closures are not visited,
+  // so their code could not be reset.
+  if (!heap->ShouldReduceMemory() ||
+      heap->incremental_marking()->black_allocation()) {
+    return false;
+  }
+
+  // Only flush bytecode of functions that run in the interpreter.
+  if (!shared_info->HasBytecodeArray() ||
+      !shared_info->code()->is_interpreter_entry_trampoline()) {
+    return false;
+  }
+
+  // Bytecode is either on stack, referenced by an optimized version of the
+  // function or by optimized code the function was inlined into.
+  BytecodeArray* bytecode = shared_info->bytecode_array();
+  if (Marking::IsBlackOrGrey(Marking::MarkBitFrom(bytecode))) {
+    return false;
+  }
+
+  // The function must have the source code available, to be able to
+  // recompile it in case we need the function again.
+  if (!HasSourceCode(heap, shared_info)) {
+    return false;
+  }
+
+  // The same restrictions as for code apply, see above.
+  if (shared_info->IsApiFunction() || !shared_info->allows_lazy_compilation() ||
+      shared_info->is_generator() || shared_info->is_toplevel() ||
+      shared_info->IsBuiltin() || shared_info->dont_flush()) {
+    return false;
+  }
+
+  // The debugger keeps its own copy of the bytecode.
+  if (shared_info->HasDebugInfo()) {
+    return false;
+  }
+
+  return bytecode->IsOld();
+}
+
+
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::MarkInlinedFunctionsBytecode(
+    Heap* heap, Code* code) {
+  // Deoptimization materializes interpreter frames for all functions inlined
+  // into optimized code, so their bytecode has to stay alive. The shared
+  // function infos of those functions are deoptimization literals.
+  FixedArray* raw_data = code->deoptimization_data();
+  if (raw_data->length() == 0) return;
+  FixedArray* literals = DeoptimizationInputData::cast(raw_data)->LiteralArray();
+  for (int i = 0; i < literals->length(); i++) {
+    Object* literal = literals->get(i);
+    if (!literal->IsSharedFunctionInfo()) continue;
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(literal);
+    if (shared->HasBytecodeArray()) {
+      StaticVisitor::MarkObject(heap, shared->bytecode_array());
+    }
+  }
+}
+
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoStrongCode(
     Heap* heap, HeapObject* object) {
@@ -715,6 +802,22 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakCode(
 }
 
 
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakBytecode(
+    Heap* heap, HeapObject* object) {
+  Object** start_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::BodyDescriptor::kStartOffset);
+  Object** function_data_slot =
+      HeapObject::RawField(object, SharedFunctionInfo::kFunctionDataOffset);
+  StaticVisitor::VisitPointers(heap, object, start_slot, function_data_slot);
+
+  // Skip visiting kFunctionDataOffset as it is treated weakly here.
+  Object** end_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::BodyDescriptor::kEndOffset);
+  StaticVisitor::VisitPointers(heap, object, function_data_slot + 1, end_slot);
+}
+
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitJSFunctionStrongCode(
     Map* map, HeapObject* object) {
@@ -27,6 +27,7 @@ class CompactionSpace;
 class CompactionSpaceCollection;
 class FreeList;
 class Isolate;
+class LocalArrayBufferTracker;
 class MemoryAllocator;
 class MemoryChunk;
 class Page;
@@ -521,6 +522,7 @@ class MemoryChunk {
       + 2 * kPointerSize  // AtomicNumber free-list statistics
       + kPointerSize      // AtomicValue next_chunk_
       + kPointerSize      // AtomicValue prev_chunk_
+      + kPointerSize      // LocalArrayBufferTracker* local_tracker_
       // FreeListCategory categories_[kNumberOfCategories]
       + FreeListCategory::kSize * kNumberOfCategories;
 
@@ -636,6 +638,10 @@ class MemoryChunk {
   void AllocateTypedOldToOldSlots();
   void ReleaseTypedOldToOldSlots();
 
+  inline LocalArrayBufferTracker* local_tracker() { return local_tracker_; }
+  LocalArrayBufferTracker* AllocateLocalTracker();
+  void ReleaseLocalTracker();
+
   Address area_start() { return area_start_; }
   Address area_end() { return area_end_; }
   int area_size() { return static_cast<int>(area_end() - area_start()); }
@@ -815,6 +821,9 @@ class MemoryChunk {
   // prev_chunk_ holds a pointer of type MemoryChunk
   base::AtomicValue<MemoryChunk*> prev_chunk_;
 
+  // Backing stores of the array buffers on this chunk, allocated lazily.
+  LocalArrayBufferTracker* local_tracker_;
+
   FreeListCategory categories_[kNumberOfCategories];
 
  private:
@@ -1994,9 +1994,8 @@ MaybeHandle<Object> KeyedStoreIC::Store(Handle<Object> object,
 }
 
 
-void CallIC::HandleMiss(Handle<Object> function) {
-  Handle<Object> name = isolate()->factory()->empty_string();
-  CallICNexus* nexus = casted_nexus<CallICNexus>();
+void CallIC::UpdateFeedback(Isolate* isolate, CallICNexus* nexus,
+                            Handle<Object> function) {
   Object* feedback = nexus->GetFeedback();
 
   // Hand-coded MISS handling is easier if CallIC slots don't contain smis.
@@ -2007,16 +2006,16 @@ void CallIC::HandleMiss(Handle<Object> function) {
     // We are going generic.
     nexus->ConfigureMegamorphic();
   } else {
-    DCHECK(feedback == *TypeFeedbackVector::UninitializedSentinel(isolate()));
+    DCHECK(feedback == *TypeFeedbackVector::UninitializedSentinel(isolate));
     Handle<JSFunction> js_function = Handle<JSFunction>::cast(function);
 
     Handle<JSFunction> array_function =
-        Handle<JSFunction>(isolate()->native_context()->array_function());
+        Handle<JSFunction>(isolate->native_context()->array_function());
     if (array_function.is_identical_to(js_function)) {
       // Alter the slot.
       nexus->ConfigureMonomorphicArray();
     } else if (js_function->context()->native_context() !=
-               *isolate()->native_context()) {
+               *isolate->native_context()) {
       // Don't collect cross-native context feedback for the CallIC.
       // TODO(bmeurer): We should collect the SharedFunctionInfo as
       // feedback in this case instead.
@@ -2025,6 +2024,12 @@ void CallIC::HandleMiss(Handle<Object> function) {
       nexus->ConfigureMonomorphic(js_function);
     }
   }
+}
+
+
+void CallIC::HandleMiss(Handle<Object> function) {
+  Handle<Object> name = isolate()->factory()->empty_string();
+  UpdateFeedback(isolate(), casted_nexus<CallICNexus>(), function);
 
   if (function->IsJSFunction()) {
     Handle<JSFunction> js_function = Handle<JSFunction>::cast(function);
@@ -256,6 +256,11 @@ class CallIC : public IC {
 
   void HandleMiss(Handle<Object> function);
 
+  // Transitions the feedback in |nexus| for a call to |function|. Shared with
+  // the interpreter, which collects call feedback without an IC stub.
+  static void UpdateFeedback(Isolate* isolate, CallICNexus* nexus,
+                             Handle<Object> function);
+
   // Code generator routines.
   static Handle<Code> initialize_stub_in_optimized_code(
       Isolate* isolate, int argc, ConvertReceiverMode mode,
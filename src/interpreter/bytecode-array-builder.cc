@@ -4,6 +4,7 @@
 
 #include "src/interpreter/bytecode-array-builder.h"
 #include "src/compiler.h"
+#include "src/debug/debug.h"
 #include "src/interpreter/interpreter-intrinsics.h"
 
 namespace v8 {
@@ -92,31 +93,38 @@ class BytecodeArrayBuilder::PreviousBytecodeHelper BASE_EMBEDDED {
   DISALLOW_COPY_AND_ASSIGN(PreviousBytecodeHelper);
 };
 
-BytecodeArrayBuilder::BytecodeArrayBuilder(Isolate* isolate, Zone* zone,
-                                           int parameter_count,
-                                           int context_count, int locals_count,
-                                           FunctionLiteral* literal)
+BytecodeArrayBuilder::BytecodeArrayBuilder(
+    Isolate* isolate, Zone* zone, int parameter_count, int context_count,
+    int locals_count, FunctionLiteral* literal,
+    SourcePositionTableBuilder::RecordingMode source_position_mode)
     : isolate_(isolate),
       zone_(zone),
       bytecodes_(zone),
       bytecode_generated_(false),
       constant_array_builder_(isolate, zone),
       handler_table_builder_(isolate, zone),
-      source_position_table_builder_(isolate, zone),
+      source_position_table_builder_(isolate, zone, source_position_mode),
       last_block_end_(0),
       last_bytecode_start_(~0),
       exit_seen_in_block_(false),
+      last_pinned_offset_(0),
       unbound_jumps_(0),
       parameter_count_(parameter_count),
       local_register_count_(locals_count),
       context_register_count_(context_count),
-      temporary_allocator_(zone, fixed_register_count()) {
+      temporary_allocator_(zone, fixed_register_count()),
+      register_optimizer_(nullptr) {
   DCHECK_GE(parameter_count_, 0);
   DCHECK_GE(context_register_count_, 0);
   DCHECK_GE(local_register_count_, 0);
   return_position_ =
       literal ? std::max(literal->start_position(), literal->end_position() - 1)
               : RelocInfo::kNoPosition;
+  // The debugger may change the values of locals, so registers cannot be
+  // assumed to keep their values while it is active.
+  if (FLAG_ignition_reo && !isolate->debug()->is_active()) {
+    register_optimizer_ = new (zone) BytecodeRegisterOptimizer(zone);
+  }
   LOG_CODE_EVENT(isolate_, CodeStartLinePosInfoRecordEvent(
                                source_position_table_builder()));
 }
@@ -154,7 +162,7 @@ Handle<BytecodeArray> BytecodeArrayBuilder::ToBytecodeArray() {
   int frame_size = register_count * kPointerSize;
   Handle<FixedArray> constant_pool = constant_array_builder()->ToFixedArray();
   Handle<FixedArray> handler_table = handler_table_builder()->ToHandlerTable();
-  Handle<ByteArray> source_position_table =
+  Handle<Object> source_position_table =
       source_position_table_builder()->ToSourcePositionTable();
   Handle<BytecodeArray> bytecode_array = isolate_->factory()->NewBytecodeArray(
       bytecode_size, &bytecodes_.front(), frame_size, parameter_count(),
@@ -179,6 +187,7 @@ void BytecodeArrayBuilder::Output(Bytecode bytecode, uint32_t (&operands)[N],
   int operand_count = static_cast<int>(N);
   DCHECK_EQ(Bytecodes::NumberOfOperands(bytecode), operand_count);
 
+  ElideDeadAccumulatorLoad(bytecode);
   last_bytecode_start_ = bytecodes()->size();
   // Emit prefix bytecode for scale if required.
   if (Bytecodes::OperandScaleRequiresPrefixBytecode(operand_scale)) {
@@ -215,6 +224,10 @@ void BytecodeArrayBuilder::Output(Bytecode bytecode, uint32_t (&operands)[N],
       }
     }
   }
+
+  if (register_optimizer_ != nullptr) {
+    register_optimizer_->Update(bytecode, operands, operand_count);
+  }
 }
 
 void BytecodeArrayBuilder::Output(Bytecode bytecode) {
@@ -222,8 +235,13 @@ void BytecodeArrayBuilder::Output(Bytecode bytecode) {
   if (exit_seen_in_block_) return;
 
   DCHECK_EQ(Bytecodes::NumberOfOperands(bytecode), 0);
+  ElideDeadAccumulatorLoad(bytecode);
   last_bytecode_start_ = bytecodes()->size();
   bytecodes()->push_back(Bytecodes::ToByte(bytecode));
+
+  if (register_optimizer_ != nullptr) {
+    register_optimizer_->Update(bytecode, nullptr, 0);
+  }
 }
 
 void BytecodeArrayBuilder::OutputScaled(Bytecode bytecode,
@@ -357,7 +375,7 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StoreAccumulatorInRegister(
     Register reg) {
   if (!IsRegisterInAccumulator(reg)) {
     OperandScale operand_scale = OperandSizesToScale(reg.SizeOfOperand());
-    OutputScaled(Bytecode::kStar, operand_scale, RegisterOperand(reg));
+    OutputScaled(FuseIntoStar(), operand_scale, RegisterOperand(reg));
   }
   return *this;
 }
@@ -366,6 +384,10 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StoreAccumulatorInRegister(
 BytecodeArrayBuilder& BytecodeArrayBuilder::MoveRegister(Register from,
                                                          Register to) {
   DCHECK(from != to);
+  if (register_optimizer_ != nullptr &&
+      register_optimizer_->AreEquivalent(from, to)) {
+    return *this;
+  }
   OperandScale operand_scale =
       OperandSizesToScale(from.SizeOfOperand(), to.SizeOfOperand());
   OutputScaled(Bytecode::kMov, operand_scale, RegisterOperand(from),
@@ -673,6 +695,10 @@ Bytecode BytecodeArrayBuilder::GetJumpWithConstantOperand(
       return Bytecode::kJumpIfNullConstant;
     case Bytecode::kJumpIfUndefined:
       return Bytecode::kJumpIfUndefinedConstant;
+    case Bytecode::kTestEqualStrictJumpIfTrue:
+      return Bytecode::kTestEqualStrictJumpIfTrueConstant;
+    case Bytecode::kTestEqualStrictJumpIfFalse:
+      return Bytecode::kTestEqualStrictJumpIfFalseConstant;
     default:
       UNREACHABLE();
       return Bytecode::kIllegal;
@@ -803,6 +829,9 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::OutputJump(Bytecode jump_bytecode,
     jump_bytecode = GetJumpWithToBoolean(jump_bytecode);
   }
 
+  Register test_register;
+  jump_bytecode = FuseIntoJump(jump_bytecode, &test_register);
+
   if (label->is_bound()) {
     // Label has been bound already so this is a backwards jump.
     CHECK_GE(bytecodes()->size(), label->offset());
@@ -815,8 +844,15 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::OutputJump(Bytecode jump_bytecode,
       DCHECK_LE(delta, 0);
       delta -= 1;
     }
-    OutputScaled(jump_bytecode, OperandSizesToScale(operand_size),
-                 SignedOperand(delta, operand_size));
+    OperandScale operand_scale = OperandSizesToScale(operand_size);
+    if (test_register.is_valid()) {
+      OutputScaled(jump_bytecode, operand_scale,
+                   SignedOperand(delta, operand_size),
+                   RegisterOperand(test_register));
+    } else {
+      OutputScaled(jump_bytecode, operand_scale,
+                   SignedOperand(delta, operand_size));
+    }
   } else {
     // The label has not yet been bound so this is a forward reference
     // that will be patched when the label is bound. We create a
@@ -828,7 +864,13 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::OutputJump(Bytecode jump_bytecode,
     unbound_jumps_++;
     OperandSize reserved_operand_size =
         constant_array_builder()->CreateReservedEntry();
-    OutputScaled(jump_bytecode, OperandSizesToScale(reserved_operand_size), 0);
+    OperandScale operand_scale = OperandSizesToScale(reserved_operand_size);
+    if (test_register.is_valid()) {
+      OutputScaled(jump_bytecode, operand_scale, 0,
+                   RegisterOperand(test_register));
+    } else {
+      OutputScaled(jump_bytecode, operand_scale, 0);
+    }
   }
   LeaveBasicBlock();
   return *this;
@@ -866,6 +908,7 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::StackCheck(int position) {
     // so we simply add it as expression position.
     source_position_table_builder_.AddExpressionPosition(bytecodes_.size(),
                                                          position);
+    PinCurrentOffset();
   }
   Output(Bytecode::kStackCheck);
   return *this;
@@ -968,6 +1011,7 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::MarkHandler(int handler_id,
                                                         bool will_catch) {
   handler_table_builder()->SetHandlerTarget(handler_id, bytecodes()->size());
   handler_table_builder()->SetPrediction(handler_id, will_catch);
+  PinCurrentOffset();
   return *this;
 }
 
@@ -976,12 +1020,14 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::MarkTryBegin(int handler_id,
                                                          Register context) {
   handler_table_builder()->SetTryRegionStart(handler_id, bytecodes()->size());
   handler_table_builder()->SetContextRegister(handler_id, context);
+  PinCurrentOffset();
   return *this;
 }
 
 
 BytecodeArrayBuilder& BytecodeArrayBuilder::MarkTryEnd(int handler_id) {
   handler_table_builder()->SetTryRegionEnd(handler_id, bytecodes()->size());
+  PinCurrentOffset();
   return *this;
 }
 
@@ -989,6 +1035,93 @@ BytecodeArrayBuilder& BytecodeArrayBuilder::MarkTryEnd(int handler_id) {
 void BytecodeArrayBuilder::LeaveBasicBlock() {
   last_block_end_ = bytecodes()->size();
   exit_seen_in_block_ = false;
+  if (register_optimizer_ != nullptr) register_optimizer_->Reset();
+}
+
+void BytecodeArrayBuilder::PinCurrentOffset() {
+  last_pinned_offset_ = bytecodes()->size();
+}
+
+// Removes the previous bytecode if it only loads a value into the accumulator
+// and |bytecode| overwrites that value without reading it.
+void BytecodeArrayBuilder::ElideDeadAccumulatorLoad(Bytecode bytecode) {
+  if (!FLAG_ignition_peephole) return;
+  if (Bytecodes::GetAccumulatorUse(bytecode) != AccumulatorUse::kWrite) return;
+  if (!LastBytecodeInSameBlock()) return;
+  if (last_bytecode_start_ <= last_pinned_offset_) return;
+  PreviousBytecodeHelper previous_bytecode(*this);
+  switch (previous_bytecode.GetBytecode()) {
+    case Bytecode::kLdaZero:
+    case Bytecode::kLdaSmi:
+    case Bytecode::kLdaUndefined:
+    case Bytecode::kLdaNull:
+    case Bytecode::kLdaTheHole:
+    case Bytecode::kLdaTrue:
+    case Bytecode::kLdaFalse:
+    case Bytecode::kLdaConstant:
+    case Bytecode::kLdar:
+      bytecodes()->resize(last_bytecode_start_);
+      break;
+    default:
+      break;
+  }
+}
+
+bool BytecodeArrayBuilder::CanFuseWithPreviousBytecode() const {
+  // The previous bytecode must not start a basic block and no source position
+  // or handler may refer to the offset following it.
+  return FLAG_ignition_superinstructions && LastBytecodeInSameBlock() &&
+         last_pinned_offset_ < bytecodes()->size();
+}
+
+// Returns the superinstruction combining the previous bytecode with a Star,
+// and removes the previous bytecode, or returns Star if there is none.
+Bytecode BytecodeArrayBuilder::FuseIntoStar() {
+  if (!CanFuseWithPreviousBytecode()) return Bytecode::kStar;
+  PreviousBytecodeHelper previous_bytecode(*this);
+  Bytecode fused_bytecode;
+  switch (previous_bytecode.GetBytecode()) {
+    case Bytecode::kLdaZero:
+      fused_bytecode = Bytecode::kLdaZeroStar;
+      break;
+    case Bytecode::kLdaUndefined:
+      fused_bytecode = Bytecode::kLdaUndefinedStar;
+      break;
+    default:
+      return Bytecode::kStar;
+  }
+  bytecodes()->resize(last_bytecode_start_);
+  return fused_bytecode;
+}
+
+// Returns the superinstruction combining a previous TestEqualStrict with
+// |jump_bytecode|, removes the TestEqualStrict and sets |test_register| to its
+// register operand. Returns |jump_bytecode| if there is no such combination.
+Bytecode BytecodeArrayBuilder::FuseIntoJump(Bytecode jump_bytecode,
+                                            Register* test_register) {
+  if (!CanFuseWithPreviousBytecode()) return jump_bytecode;
+  PreviousBytecodeHelper previous_bytecode(*this);
+  if (previous_bytecode.GetBytecode() != Bytecode::kTestEqualStrict) {
+    return jump_bytecode;
+  }
+  // The register operand is scaled with the jump offset, whose scale is fixed
+  // when the jump is emitted, so only registers that fit any scale are fused.
+  Register reg = previous_bytecode.GetRegisterOperand(0);
+  if (reg.SizeOfOperand() != OperandSize::kByte) return jump_bytecode;
+  Bytecode fused_bytecode;
+  switch (jump_bytecode) {
+    case Bytecode::kJumpIfTrue:
+      fused_bytecode = Bytecode::kTestEqualStrictJumpIfTrue;
+      break;
+    case Bytecode::kJumpIfFalse:
+      fused_bytecode = Bytecode::kTestEqualStrictJumpIfFalse;
+      break;
+    default:
+      return jump_bytecode;
+  }
+  bytecodes()->resize(last_bytecode_start_);
+  *test_register = reg;
+  return fused_bytecode;
 }
 
 void BytecodeArrayBuilder::EnsureReturn() {
@@ -1098,6 +1231,7 @@ void BytecodeArrayBuilder::SetReturnPosition() {
   if (exit_seen_in_block_) return;
   source_position_table_builder_.AddStatementPosition(bytecodes_.size(),
                                                       return_position_);
+  PinCurrentOffset();
 }
 
 void BytecodeArrayBuilder::SetStatementPosition(Statement* stmt) {
@@ -1105,6 +1239,7 @@ void BytecodeArrayBuilder::SetStatementPosition(Statement* stmt) {
   if (exit_seen_in_block_) return;
   source_position_table_builder_.AddStatementPosition(bytecodes_.size(),
                                                       stmt->position());
+  PinCurrentOffset();
 }
 
 void BytecodeArrayBuilder::SetExpressionPosition(Expression* expr) {
@@ -1112,6 +1247,7 @@ void BytecodeArrayBuilder::SetExpressionPosition(Expression* expr) {
   if (exit_seen_in_block_) return;
   source_position_table_builder_.AddExpressionPosition(bytecodes_.size(),
                                                        expr->position());
+  PinCurrentOffset();
 }
 
 void BytecodeArrayBuilder::SetExpressionAsStatementPosition(Expression* expr) {
@@ -1119,6 +1255,7 @@ void BytecodeArrayBuilder::SetExpressionAsStatementPosition(Expression* expr) {
   if (exit_seen_in_block_) return;
   source_position_table_builder_.AddStatementPosition(bytecodes_.size(),
                                                       expr->position());
+  PinCurrentOffset();
 }
 
 bool BytecodeArrayBuilder::TemporaryRegisterIsLive(Register reg) const {
@@ -1215,10 +1352,15 @@ bool BytecodeArrayBuilder::LastBytecodeInSameBlock() const {
 
 
 bool BytecodeArrayBuilder::IsRegisterInAccumulator(Register reg) {
+  if (register_optimizer_ != nullptr) {
+    return register_optimizer_->IsAccumulatorEquivalent(reg);
+  }
   if (LastBytecodeInSameBlock()) {
     PreviousBytecodeHelper previous_bytecode(*this);
     Bytecode bytecode = previous_bytecode.GetBytecode();
-    if (bytecode == Bytecode::kLdar || bytecode == Bytecode::kStar) {
+    if (bytecode == Bytecode::kLdar || bytecode == Bytecode::kStar ||
+        bytecode == Bytecode::kLdaZeroStar ||
+        bytecode == Bytecode::kLdaUndefinedStar) {
       return previous_bytecode.GetRegisterOperand(0) == reg;
     }
   }
@@ -7,6 +7,7 @@
 
 #include "src/ast/ast.h"
 #include "src/interpreter/bytecode-register-allocator.h"
+#include "src/interpreter/bytecode-register-optimizer.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/interpreter/constant-array-builder.h"
 #include "src/interpreter/handler-table-builder.h"
@@ -25,9 +26,11 @@ class Register;
 
 class BytecodeArrayBuilder final : public ZoneObject {
  public:
-  BytecodeArrayBuilder(Isolate* isolate, Zone* zone, int parameter_count,
-                       int context_count, int locals_count,
-                       FunctionLiteral* literal = nullptr);
+  BytecodeArrayBuilder(
+      Isolate* isolate, Zone* zone, int parameter_count, int context_count,
+      int locals_count, FunctionLiteral* literal = nullptr,
+      SourcePositionTableBuilder::RecordingMode source_position_mode =
+          SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS);
 
   Handle<BytecodeArray> ToBytecodeArray();
 
@@ -333,6 +336,11 @@ class BytecodeArrayBuilder final : public ZoneObject {
       const ZoneVector<uint8_t>::iterator& jump_location, int delta);
 
   void LeaveBasicBlock();
+  void PinCurrentOffset();
+  void ElideDeadAccumulatorLoad(Bytecode bytecode);
+  bool CanFuseWithPreviousBytecode() const;
+  Bytecode FuseIntoStar();
+  Bytecode FuseIntoJump(Bytecode jump_bytecode, Register* test_register);
 
   bool OperandIsValid(Bytecode bytecode, OperandScale operand_scale,
                       int operand_index, uint32_t operand_value) const;
@@ -374,12 +382,16 @@ class BytecodeArrayBuilder final : public ZoneObject {
   size_t last_block_end_;
   size_t last_bytecode_start_;
   bool exit_seen_in_block_;
+  // The most recent offset recorded in the source position or handler table.
+  // Bytecodes at or after it must not be moved by the peephole optimizer.
+  size_t last_pinned_offset_;
   int unbound_jumps_;
   int parameter_count_;
   int local_register_count_;
   int context_register_count_;
   int return_position_;
   TemporaryRegisterAllocator temporary_allocator_;
+  BytecodeRegisterOptimizer* register_optimizer_;
 
   DISALLOW_COPY_AND_ASSIGN(BytecodeArrayBuilder);
 };
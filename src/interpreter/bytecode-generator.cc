@@ -7,11 +7,13 @@
 #include "src/ast/scopes.h"
 #include "src/code-stubs.h"
 #include "src/compiler.h"
+#include "src/debug/debug.h"
 #include "src/interpreter/bytecode-register-allocator.h"
 #include "src/interpreter/control-flow-builders.h"
 #include "src/objects.h"
 #include "src/parsing/parser.h"
 #include "src/parsing/token.h"
+#include "src/profiler/cpu-profiler.h"
 
 namespace v8 {
 namespace internal {
@@ -555,13 +557,35 @@ class BytecodeGenerator::RegisterResultScope final
   Register result_register_;
 };
 
+namespace {
+
+// Source positions may only be omitted for functions that can be reparsed on
+// their own later, and only while no debugger or profiler needs them at
+// compile time.
+SourcePositionTableBuilder::RecordingMode SourcePositionRecordingMode(
+    CompilationInfo* info) {
+  Isolate* isolate = info->isolate();
+  if (!FLAG_lazy_source_positions || info->is_source_positions_enabled() ||
+      !info->scope()->is_function_scope() ||
+      !info->literal()->AllowsLazyCompilation() ||
+      isolate->debug()->is_active() ||
+      isolate->logger()->is_logging_code_events() ||
+      isolate->cpu_profiler()->is_profiling()) {
+    return SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS;
+  }
+  return SourcePositionTableBuilder::OMIT_SOURCE_POSITIONS;
+}
+
+}  // namespace
+
 BytecodeGenerator::BytecodeGenerator(CompilationInfo* info)
     : isolate_(info->isolate()),
       zone_(info->zone()),
       builder_(new (zone()) BytecodeArrayBuilder(
           info->isolate(), info->zone(), info->num_parameters_including_this(),
           info->scope()->MaxNestedContextChainLength(),
-          info->scope()->num_stack_slots(), info->literal())),
+          info->scope()->num_stack_slots(), info->literal(),
+          SourcePositionRecordingMode(info))),
       info_(info),
       scope_(info->scope()),
       globals_(0, info->zone()),
@@ -0,0 +1,140 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/interpreter/bytecode-register-optimizer.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+BytecodeRegisterOptimizer::BytecodeRegisterOptimizer(Zone* zone)
+    : register_values_(zone),
+      accumulator_value_(kUnknownValue),
+      next_value_(0) {}
+
+void BytecodeRegisterOptimizer::Reset() {
+  register_values_.clear();
+  accumulator_value_ = kUnknownValue;
+}
+
+bool BytecodeRegisterOptimizer::IsAccumulatorEquivalent(Register reg) const {
+  return accumulator_value_ != kUnknownValue &&
+         ValueOf(reg) == accumulator_value_;
+}
+
+bool BytecodeRegisterOptimizer::AreEquivalent(Register reg0,
+                                              Register reg1) const {
+  if (reg0 == reg1) return true;
+  int value = ValueOf(reg0);
+  return value != kUnknownValue && ValueOf(reg1) == value;
+}
+
+void BytecodeRegisterOptimizer::Update(Bytecode bytecode,
+                                       const uint32_t* operands,
+                                       int operand_count) {
+  DCHECK_EQ(Bytecodes::NumberOfOperands(bytecode), operand_count);
+  switch (bytecode) {
+    case Bytecode::kLdar:
+      accumulator_value_ =
+          EnsureValueOf(Register::FromOperand(static_cast<int>(operands[0])));
+      return;
+    case Bytecode::kStar: {
+      int value = EnsureAccumulatorValue();
+      register_values_[Register::FromOperand(static_cast<int>(operands[0]))
+                           .index()] = value;
+      return;
+    }
+    case Bytecode::kLdaZeroStar:
+    case Bytecode::kLdaUndefinedStar:
+      accumulator_value_ = NewValue();
+      register_values_[Register::FromOperand(static_cast<int>(operands[0]))
+                           .index()] = accumulator_value_;
+      return;
+    case Bytecode::kMov: {
+      Register from = Register::FromOperand(static_cast<int>(operands[0]));
+      Register to = Register::FromOperand(static_cast<int>(operands[1]));
+      int value = EnsureValueOf(from);
+      register_values_[to.index()] = value;
+      return;
+    }
+    case Bytecode::kPushContext:
+      // Saves the current context in its register operand, which is not
+      // marked as an output operand.
+      Kill(Register::FromOperand(static_cast<int>(operands[0])));
+      Kill(Register::current_context());
+      break;
+    case Bytecode::kPopContext:
+      Kill(Register::current_context());
+      break;
+    case Bytecode::kCallRuntime:
+    case Bytecode::kCallRuntimeForPair:
+    case Bytecode::kInvokeIntrinsic:
+      // Runtime functions receive their arguments in place and may write to
+      // them.
+    case Bytecode::kResumeGenerator:
+      // Restores the whole register file.
+    case Bytecode::kDebugger:
+      // The debugger may change the values of locals.
+      Reset();
+      return;
+    default:
+      break;
+  }
+  if (Bytecodes::WritesAccumulator(bytecode)) {
+    accumulator_value_ = kUnknownValue;
+  }
+  KillOutputs(bytecode, operands, operand_count);
+}
+
+int BytecodeRegisterOptimizer::ValueOf(Register reg) const {
+  auto it = register_values_.find(reg.index());
+  return it == register_values_.end() ? kUnknownValue : it->second;
+}
+
+int BytecodeRegisterOptimizer::EnsureValueOf(Register reg) {
+  int value = ValueOf(reg);
+  if (value == kUnknownValue) {
+    value = NewValue();
+    register_values_[reg.index()] = value;
+  }
+  return value;
+}
+
+int BytecodeRegisterOptimizer::EnsureAccumulatorValue() {
+  if (accumulator_value_ == kUnknownValue) accumulator_value_ = NewValue();
+  return accumulator_value_;
+}
+
+void BytecodeRegisterOptimizer::Kill(Register reg) {
+  register_values_.erase(reg.index());
+}
+
+void BytecodeRegisterOptimizer::KillOutputs(Bytecode bytecode,
+                                            const uint32_t* operands,
+                                            int operand_count) {
+  for (int i = 0; i < operand_count; i++) {
+    int count;
+    switch (Bytecodes::GetOperandType(bytecode, i)) {
+      case OperandType::kRegOut:
+        count = 1;
+        break;
+      case OperandType::kRegOutPair:
+        count = 2;
+        break;
+      case OperandType::kRegOutTriple:
+        count = 3;
+        break;
+      default:
+        continue;
+    }
+    Register reg = Register::FromOperand(static_cast<int>(operands[i]));
+    for (int j = 0; j < count; j++) {
+      Kill(Register(reg.index() + j));
+    }
+  }
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,61 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_BYTECODE_REGISTER_OPTIMIZER_H_
+#define V8_INTERPRETER_BYTECODE_REGISTER_OPTIMIZER_H_
+
+#include "src/interpreter/bytecodes.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+// Tracks which registers and the accumulator are known to hold the same value
+// within a basic block, so that BytecodeArrayBuilder can elide register
+// transfers (Ldar, Star and Mov) that would not change any value. Each
+// register and the accumulator is assigned a value number; transfers copy
+// value numbers and every other write gives its target a fresh, unknown value.
+class BytecodeRegisterOptimizer final : public ZoneObject {
+ public:
+  explicit BytecodeRegisterOptimizer(Zone* zone);
+
+  // Forgets all equivalences, e.g. at the start of a basic block.
+  void Reset();
+
+  // Returns true if |reg| is known to hold the value in the accumulator.
+  bool IsAccumulatorEquivalent(Register reg) const;
+
+  // Returns true if |reg0| and |reg1| are known to hold the same value.
+  bool AreEquivalent(Register reg0, Register reg1) const;
+
+  // Updates the equivalences for a |bytecode| with |operands| that has been
+  // emitted.
+  void Update(Bytecode bytecode, const uint32_t* operands, int operand_count);
+
+ private:
+  static const int kUnknownValue = -1;
+
+  int ValueOf(Register reg) const;
+  int EnsureValueOf(Register reg);
+  int EnsureAccumulatorValue();
+  void Kill(Register reg);
+  void KillOutputs(Bytecode bytecode, const uint32_t* operands,
+                   int operand_count);
+
+  int NewValue() { return next_value_++; }
+
+  // The value number of each register with a known value, by register index.
+  ZoneMap<int, int> register_values_;
+  int accumulator_value_;
+  int next_value_;
+
+  DISALLOW_COPY_AND_ASSIGN(BytecodeRegisterOptimizer);
+};
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_INTERPRETER_BYTECODE_REGISTER_OPTIMIZER_H_
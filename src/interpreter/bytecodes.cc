@@ -304,7 +304,9 @@ bool Bytecodes::IsConditionalJumpImmediate(Bytecode bytecode) {
          bytecode == Bytecode::kJumpIfToBooleanFalse ||
          bytecode == Bytecode::kJumpIfNotHole ||
          bytecode == Bytecode::kJumpIfNull ||
-         bytecode == Bytecode::kJumpIfUndefined;
+         bytecode == Bytecode::kJumpIfUndefined ||
+         bytecode == Bytecode::kTestEqualStrictJumpIfTrue ||
+         bytecode == Bytecode::kTestEqualStrictJumpIfFalse;
 }
 
 
@@ -316,7 +318,9 @@ bool Bytecodes::IsConditionalJumpConstant(Bytecode bytecode) {
          bytecode == Bytecode::kJumpIfToBooleanFalseConstant ||
          bytecode == Bytecode::kJumpIfNotHoleConstant ||
          bytecode == Bytecode::kJumpIfNullConstant ||
-         bytecode == Bytecode::kJumpIfUndefinedConstant;
+         bytecode == Bytecode::kJumpIfUndefinedConstant ||
+         bytecode == Bytecode::kTestEqualStrictJumpIfTrueConstant ||
+         bytecode == Bytecode::kTestEqualStrictJumpIfFalseConstant;
 }
 
 // static
@@ -245,6 +245,18 @@ namespace interpreter {
   V(SuspendGenerator, AccumulatorUse::kRead, OperandType::kReg)               \
   V(ResumeGenerator, AccumulatorUse::kWrite, OperandType::kReg)               \
                                                                               \
+  /* Superinstructions */                                                     \
+  V(LdaZeroStar, AccumulatorUse::kWrite, OperandType::kRegOut)                \
+  V(LdaUndefinedStar, AccumulatorUse::kWrite, OperandType::kRegOut)           \
+  V(TestEqualStrictJumpIfTrue, AccumulatorUse::kReadWrite, OperandType::kImm, \
+    OperandType::kReg)                                                        \
+  V(TestEqualStrictJumpIfTrueConstant, AccumulatorUse::kReadWrite,            \
+    OperandType::kIdx, OperandType::kReg)                                     \
+  V(TestEqualStrictJumpIfFalse, AccumulatorUse::kReadWrite,                   \
+    OperandType::kImm, OperandType::kReg)                                     \
+  V(TestEqualStrictJumpIfFalseConstant, AccumulatorUse::kReadWrite,           \
+    OperandType::kIdx, OperandType::kReg)                                     \
+                                                                              \
   /* Debugger */                                                              \
   V(Debugger, AccumulatorUse::kNone)                                          \
   DEBUG_BREAK_BYTECODE_LIST(V)                                                \
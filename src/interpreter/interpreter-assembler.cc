@@ -430,6 +430,75 @@ Node* InterpreterAssembler::CallJS(Node* function, Node* context,
                   first_arg, function);
 }
 
+Node* InterpreterAssembler::CallJSWithFeedback(Node* function, Node* context,
+                                               Node* first_arg,
+                                               Node* arg_count, Node* slot_id,
+                                               Node* type_feedback_vector,
+                                               TailCallMode tail_call_mode) {
+  CodeStubAssembler::Label call(this);
+  CodeStubAssembler::Label collect(this);
+  CodeStubAssembler::Label check_weak_cell(this);
+  CodeStubAssembler::Label weak_cell(this);
+  CodeStubAssembler::Label allocation_site(this);
+  CodeStubAssembler::Label monomorphic(this);
+  CodeStubAssembler::Label miss(this, CodeStubAssembler::Label::kDeferred);
+  Branch(Word32Equal(slot_id, Int32Constant(0)), &call, &collect);
+
+  Bind(&collect);
+  Node* feedback_element =
+      LoadFixedArrayElementInt32Index(type_feedback_vector, slot_id);
+  GotoIf(WordEqual(feedback_element,
+                   LoadRoot(Heap::kmegamorphic_symbolRootIndex)),
+         &call);
+  Branch(WordEqual(feedback_element,
+                   LoadRoot(Heap::kuninitialized_symbolRootIndex)),
+         &miss, &check_weak_cell);
+
+  // Monomorphic feedback is either a WeakCell holding the target, or an
+  // AllocationSite for calls to the Array function.
+  Bind(&check_weak_cell);
+  Branch(WordEqual(LoadMap(feedback_element),
+                   LoadRoot(Heap::kWeakCellMapRootIndex)),
+         &weak_cell, &allocation_site);
+
+  Bind(&weak_cell);
+  Branch(WordEqual(function, LoadObjectField(feedback_element,
+                                             WeakCell::kValueOffset)),
+         &monomorphic, &miss);
+
+  Bind(&allocation_site);
+  {
+    Node* array_function = LoadFixedArrayElementConstantIndex(
+        LoadNativeContext(context), Context::ARRAY_FUNCTION_INDEX);
+    Branch(WordEqual(function, array_function), &monomorphic, &miss);
+  }
+
+  // Monomorphic hit: count the call.
+  Bind(&monomorphic);
+  {
+    Node* call_count_slot = Int32Add(slot_id, Int32Constant(1));
+    Node* call_count =
+        LoadFixedArrayElementInt32Index(type_feedback_vector, call_count_slot);
+    Node* new_count =
+        SmiAdd(call_count, SmiConstant(Smi::FromInt(
+                               CallICNexus::kCallCountIncrement)));
+    StoreFixedArrayElementNoWriteBarrier(type_feedback_vector,
+                                         call_count_slot, new_count);
+    Goto(&call);
+  }
+
+  // Any other state transitions in the runtime.
+  Bind(&miss);
+  {
+    CallRuntime(Runtime::kInterpreterCallFeedbackMiss, context, function,
+                type_feedback_vector, SmiTag(slot_id));
+    Goto(&call);
+  }
+
+  Bind(&call);
+  return CallJS(function, context, first_arg, arg_count, tail_call_mode);
+}
+
 Node* InterpreterAssembler::CallConstruct(Node* constructor, Node* context,
                                           Node* new_target, Node* first_arg,
                                           Node* arg_count) {
@@ -637,6 +706,13 @@ void InterpreterAssembler::StackCheck() {
   Bind(&end);
 }
 
+void InterpreterAssembler::ResetBytecodeAge() {
+  StoreNoWriteBarrier(
+      MachineRepresentation::kWord8, BytecodeArrayTaggedPointer(),
+      IntPtrConstant(BytecodeArray::kBytecodeAgeOffset - kHeapObjectTag),
+      Int32Constant(BytecodeArray::kNoAgeBytecodeAge));
+}
+
 void InterpreterAssembler::Abort(BailoutReason bailout_reason) {
   disable_stack_check_across_call_ = true;
   Node* abort_id = SmiTag(Int32Constant(bailout_reason));
@@ -93,6 +93,17 @@ class InterpreterAssembler : public CodeStubAssembler {
                          compiler::Node* first_arg, compiler::Node* arg_count,
                          TailCallMode tail_call_mode);
 
+  // Call JSFunction or Callable |function| as CallJS does, first recording
+  // the call in the CallIC feedback at |slot_id| of |type_feedback_vector|.
+  // A |slot_id| of zero denotes a call site without feedback.
+  compiler::Node* CallJSWithFeedback(compiler::Node* function,
+                                     compiler::Node* context,
+                                     compiler::Node* first_arg,
+                                     compiler::Node* arg_count,
+                                     compiler::Node* slot_id,
+                                     compiler::Node* type_feedback_vector,
+                                     TailCallMode tail_call_mode);
+
   // Call constructor |constructor| with |arg_count| arguments (not
   // including receiver) and the first argument located at
   // |first_arg|. The |new_target| is the same as the
@@ -132,6 +143,9 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Perform a stack guard check.
   void StackCheck();
 
+  // Marks the bytecode array as recently executed so that it is not flushed.
+  void ResetBytecodeAge();
+
   // Returns from the function.
   compiler::Node* InterpreterReturn();
 
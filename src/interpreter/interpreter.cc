@@ -169,10 +169,11 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
 
 bool Interpreter::IsDispatchTableInitialized() {
   if (FLAG_trace_ignition || FLAG_trace_ignition_codegen ||
-      FLAG_trace_ignition_dispatches) {
+      FLAG_trace_ignition_dispatches || FLAG_flush_bytecode) {
     // Regenerate table to add bytecode tracing operations,
     // print the assembly code generated by TurboFan,
-    // or instrument handlers with dispatch counters.
+    // instrument handlers with dispatch counters,
+    // or reset the bytecode age on function entry.
     return false;
   }
   return dispatch_table_[0] != nullptr;
@@ -924,27 +925,31 @@ void Interpreter::DoJSCall(InterpreterAssembler* assembler,
   Node* receiver_args_count = __ BytecodeOperandCount(2);
   Node* receiver_count = __ Int32Constant(1);
   Node* args_count = __ Int32Sub(receiver_args_count, receiver_count);
+  Node* slot_id = __ BytecodeOperandIdx(3);
+  Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   Node* context = __ GetContext();
-  // TODO(rmcilroy): Use the call type feedback slot to call via CallStub.
   Node* result =
-      __ CallJS(function, context, receiver_arg, args_count, tail_call_mode);
+      __ CallJSWithFeedback(function, context, receiver_arg, args_count,
+                            slot_id, type_feedback_vector, tail_call_mode);
   __ SetAccumulator(result);
   __ Dispatch();
 }
 
 
-// Call <callable> <receiver> <arg_count>
+// Call <callable> <receiver> <arg_count> <feedback_slot_id>
 //
 // Call a JSfunction or Callable in |callable| with the |receiver| and
-// |arg_count| arguments in subsequent registers.
+// |arg_count| arguments in subsequent registers. Collect type feedback
+// into |feedback_slot_id|.
 void Interpreter::DoCall(InterpreterAssembler* assembler) {
   DoJSCall(assembler, TailCallMode::kDisallow);
 }
 
-// TailCall <callable> <receiver> <arg_count>
+// TailCall <callable> <receiver> <arg_count> <feedback_slot_id>
 //
 // Tail call a JSfunction or Callable in |callable| with the |receiver| and
-// |arg_count| arguments in subsequent registers.
+// |arg_count| arguments in subsequent registers. Collect type feedback
+// into |feedback_slot_id|.
 void Interpreter::DoTailCall(InterpreterAssembler* assembler) {
   DoJSCall(assembler, TailCallMode::kAllow);
 }
@@ -1578,8 +1583,10 @@ void Interpreter::DoCreateRestParameter(InterpreterAssembler* assembler) {
 
 // StackCheck
 //
-// Performs a stack guard check.
+// Performs a stack guard check. Every function starts with a StackCheck, so
+// with --flush-bytecode this also resets the age of the bytecode array.
 void Interpreter::DoStackCheck(InterpreterAssembler* assembler) {
+  if (FLAG_flush_bytecode) __ ResetBytecodeAge();
   __ StackCheck();
   __ Dispatch();
 }
@@ -1615,6 +1622,91 @@ void Interpreter::DoReturn(InterpreterAssembler* assembler) {
   __ InterpreterReturn();
 }
 
+// LdaZeroStar <dst>
+//
+// Load literal '0' into the accumulator and store it to register <dst>.
+void Interpreter::DoLdaZeroStar(InterpreterAssembler* assembler) {
+  Node* zero_value = __ NumberConstant(0.0);
+  Node* reg_index = __ BytecodeOperandReg(0);
+  __ SetAccumulator(zero_value);
+  __ StoreRegister(zero_value, reg_index);
+  __ Dispatch();
+}
+
+// LdaUndefinedStar <dst>
+//
+// Load Undefined into the accumulator and store it to register <dst>.
+void Interpreter::DoLdaUndefinedStar(InterpreterAssembler* assembler) {
+  Node* undefined_value =
+      __ HeapConstant(isolate_->factory()->undefined_value());
+  Node* reg_index = __ BytecodeOperandReg(0);
+  __ SetAccumulator(undefined_value);
+  __ StoreRegister(undefined_value, reg_index);
+  __ Dispatch();
+}
+
+void Interpreter::DoTestEqualStrictJump(bool condition, bool constant_operand,
+                                        InterpreterAssembler* assembler) {
+  Callable callable = CodeFactory::StrictEqual(isolate_);
+  Node* target = __ HeapConstant(callable.code());
+  Node* reg_index = __ BytecodeOperandReg(1);
+  Node* lhs = __ LoadRegister(reg_index);
+  Node* rhs = __ GetAccumulator();
+  Node* context = __ GetContext();
+  Node* result = __ CallStub(callable.descriptor(), target, context, lhs, rhs);
+  __ SetAccumulator(result);
+  Node* relative_jump;
+  if (constant_operand) {
+    Node* index = __ BytecodeOperandIdx(0);
+    Node* constant = __ LoadConstantPoolEntry(index);
+    relative_jump = __ SmiUntag(constant);
+  } else {
+    relative_jump = __ BytecodeOperandImm(0);
+  }
+  Node* condition_value = __ BooleanConstant(condition);
+  __ JumpIfWordEqual(result, condition_value, relative_jump);
+}
+
+// TestEqualStrictJumpIfTrue <imm> <src>
+//
+// Test if the value in the <src> register is strictly equal to the
+// accumulator, and jump by number of bytes represented by the immediate operand
+// |imm| if it is. Equivalent to TestEqualStrict <src> followed by JumpIfTrue.
+void Interpreter::DoTestEqualStrictJumpIfTrue(InterpreterAssembler* assembler) {
+  DoTestEqualStrictJump(true, false, assembler);
+}
+
+// TestEqualStrictJumpIfTrueConstant <idx> <src>
+//
+// Test if the value in the <src> register is strictly equal to the
+// accumulator, and jump by number of bytes in the Smi in the |idx| entry in the
+// constant pool if it is.
+void Interpreter::DoTestEqualStrictJumpIfTrueConstant(
+    InterpreterAssembler* assembler) {
+  DoTestEqualStrictJump(true, true, assembler);
+}
+
+// TestEqualStrictJumpIfFalse <imm> <src>
+//
+// Test if the value in the <src> register is strictly equal to the
+// accumulator, and jump by number of bytes represented by the immediate operand
+// |imm| if it is not. Equivalent to TestEqualStrict <src> followed by
+// JumpIfFalse.
+void Interpreter::DoTestEqualStrictJumpIfFalse(
+    InterpreterAssembler* assembler) {
+  DoTestEqualStrictJump(false, false, assembler);
+}
+
+// TestEqualStrictJumpIfFalseConstant <idx> <src>
+//
+// Test if the value in the <src> register is strictly equal to the
+// accumulator, and jump by number of bytes in the Smi in the |idx| entry in the
+// constant pool if it is not.
+void Interpreter::DoTestEqualStrictJumpIfFalseConstant(
+    InterpreterAssembler* assembler) {
+  DoTestEqualStrictJump(false, true, assembler);
+}
+
 // Debugger
 //
 // Call runtime to handle debugger statement.
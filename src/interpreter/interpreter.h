@@ -80,6 +80,13 @@ class Interpreter {
   // |compare_op|.
   void DoCompareOp(Token::Value compare_op, InterpreterAssembler* assembler);
 
+  // Generates code to perform a strict equality test whose result is left in
+  // the accumulator, followed by a jump taken if the result is |condition|.
+  // The jump offset is an immediate or, if |constant_operand|, a constant pool
+  // entry.
+  void DoTestEqualStrictJump(bool condition, bool constant_operand,
+                             InterpreterAssembler* assembler);
+
   // Generates code to load a constant from the constant pool.
   void DoLoadConstant(InterpreterAssembler* assembler);
 
@@ -117,12 +117,14 @@ void DecodeEntry(ByteArray* bytes, int* index, PositionTableEntry* entry) {
 
 void SourcePositionTableBuilder::AddStatementPosition(size_t bytecode_offset,
                                                       int source_position) {
+  if (Omit()) return;
   int offset = static_cast<int>(bytecode_offset);
   AddEntry({offset, source_position, true});
 }
 
 void SourcePositionTableBuilder::AddExpressionPosition(size_t bytecode_offset,
                                                        int source_position) {
+  if (Omit()) return;
   int offset = static_cast<int>(bytecode_offset);
   AddEntry({offset, source_position, false});
 }
@@ -160,7 +162,8 @@ void SourcePositionTableBuilder::CommitEntry() {
 #endif
 }
 
-Handle<ByteArray> SourcePositionTableBuilder::ToSourcePositionTable() {
+Handle<Object> SourcePositionTableBuilder::ToSourcePositionTable() {
+  if (Omit()) return isolate_->factory()->undefined_value();
   CommitEntry();
   if (bytes_.empty()) return isolate_->factory()->empty_byte_array();
 
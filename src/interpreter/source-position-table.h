@@ -36,8 +36,14 @@ struct PositionTableEntry {
 
 class SourcePositionTableBuilder : public PositionsRecorder {
  public:
-  SourcePositionTableBuilder(Isolate* isolate, Zone* zone)
+  // With OMIT_SOURCE_POSITIONS no positions are recorded, and the table is
+  // regenerated on demand by Compiler::CollectSourcePositions.
+  enum RecordingMode { OMIT_SOURCE_POSITIONS, RECORD_SOURCE_POSITIONS };
+
+  SourcePositionTableBuilder(Isolate* isolate, Zone* zone,
+                             RecordingMode mode = RECORD_SOURCE_POSITIONS)
       : isolate_(isolate),
+        mode_(mode),
         bytes_(zone),
 #ifdef ENABLE_SLOW_DCHECKS
         raw_entries_(zone),
@@ -47,7 +53,11 @@ class SourcePositionTableBuilder : public PositionsRecorder {
 
   void AddStatementPosition(size_t bytecode_offset, int source_position);
   void AddExpressionPosition(size_t bytecode_offset, int source_position);
-  Handle<ByteArray> ToSourcePositionTable();
+
+  // Returns the encoded table, or undefined if positions were omitted.
+  Handle<Object> ToSourcePositionTable();
+
+  bool Omit() const { return mode_ == OMIT_SOURCE_POSITIONS; }
 
  private:
   static const int kUninitializedCandidateOffset = -1;
@@ -56,6 +66,7 @@ class SourcePositionTableBuilder : public PositionsRecorder {
   void CommitEntry();
 
   Isolate* isolate_;
+  RecordingMode mode_;
   ZoneVector<byte> bytes_;
 #ifdef ENABLE_SLOW_DCHECKS
   ZoneVector<PositionTableEntry> raw_entries_;
@@ -406,6 +406,9 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
           }
           elements = MaybeGrow(this, elements, cursor, cursor + 4);
 
+          // Positions are only computed when the stack is formatted, by then
+          // the frames are gone.
+          frames[i].EnsureSourcePositionsAvailable();
           Handle<AbstractCode> abstract_code = frames[i].abstract_code();
 
           Handle<Smi> offset(Smi::FromInt(frames[i].code_offset()), this);
@@ -542,6 +545,7 @@ class CaptureStackTraceHelper {
   }
 
   Handle<JSObject> NewStackFrameObject(FrameSummary& summ) {
+    summ.EnsureSourcePositionsAvailable();
     int position = summ.abstract_code()->SourcePosition(summ.code_offset());
     return NewStackFrameObject(summ.function(), position,
                                summ.is_constructor());
@@ -1398,7 +1402,7 @@ bool Isolate::ComputeLocation(MessageLocation* target) {
   StandardFrame* frame = it.frame();
   // TODO(clemensh): handle wasm frames
   if (!frame->is_java_script()) return false;
-  JSFunction* fun = JavaScriptFrame::cast(frame)->function();
+  Handle<JSFunction> fun(JavaScriptFrame::cast(frame)->function(), this);
   Object* script = fun->shared()->script();
   if (!script->IsScript() || (Script::cast(script)->source()->IsUndefined())) {
     return false;
@@ -1410,8 +1414,9 @@ bool Isolate::ComputeLocation(MessageLocation* target) {
   List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
   JavaScriptFrame::cast(frame)->Summarize(&frames);
   FrameSummary& summary = frames.last();
+  summary.EnsureSourcePositionsAvailable();
   int pos = summary.abstract_code()->SourcePosition(summary.code_offset());
-  *target = MessageLocation(casted_script, pos, pos + 1, handle(fun));
+  *target = MessageLocation(casted_script, pos, pos + 1, fun);
   return true;
 }
 
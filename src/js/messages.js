@@ -829,7 +829,7 @@ function GetStackFrames(raw_stack) {
     // For traps in wasm, the bytecode offset is passed as (-1 - offset).
     // Otherwise, lookup the position from the pc.
     var pos = IS_NUMBER(fun) && pc < 0 ? (-1 - pc) :
-      %FunctionGetPositionForOffset(code, pc);
+      %FunctionGetPositionForOffset(code, pc, fun);
     sloppy_frames--;
     frames.push(new CallSite(recv, fun, pos, (sloppy_frames < 0)));
   }
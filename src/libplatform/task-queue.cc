@@ -4,52 +4,175 @@
 
 #include "src/libplatform/task-queue.h"
 
+#include <algorithm>
+
 #include "src/base/logging.h"
+#include "src/base/platform/time.h"
 
 namespace v8 {
 namespace platform {
 
-TaskQueue::TaskQueue() : process_queue_semaphore_(0), terminated_(false) {}
+namespace {
+
+double MonotonicallyIncreasingTime() {
+  return base::TimeTicks::HighResolutionNow().ToInternalValue() /
+         static_cast<double>(base::Time::kMicrosecondsPerSecond);
+}
+
+}  // namespace
+
+
+TaskQueue::TaskQueue(int num_workers)
+    : process_queue_semaphore_(0),
+      max_long_running_tasks_(std::max(num_workers - 1, 1)),
+      terminated_(false) {
+  DCHECK_LT(0, num_workers);
+  for (int i = 0; i < num_workers; ++i) {
+    queues_.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+  }
+}
 
 
 TaskQueue::~TaskQueue() {
-  base::LockGuard<base::Mutex> guard(&lock_);
-  DCHECK(terminated_);
-  DCHECK(task_queue_.empty());
+  DCHECK(terminated_.Value());
+  for (auto& queue : queues_) {
+    base::LockGuard<base::Mutex> guard(&queue->lock);
+    for (int priority = 0; priority < kNumberOfPriorities; ++priority) {
+      DCHECK(queue->tasks[priority].empty());
+    }
+  }
+  base::LockGuard<base::Mutex> guard(&delayed_lock_);
+  while (!delayed_tasks_.empty()) {
+    delete delayed_tasks_.top().second;
+    delayed_tasks_.pop();
+  }
 }
 
 
-void TaskQueue::Append(Task* task) {
-  base::LockGuard<base::Mutex> guard(&lock_);
-  DCHECK(!terminated_);
-  task_queue_.push(task);
+void TaskQueue::Append(Task* task, Platform::ExpectedRuntime expected_runtime) {
+  DCHECK(!terminated_.Value());
+  Priority priority = expected_runtime == Platform::kLongRunningTask
+                          ? kLongRunning
+                          : kShortRunning;
+  WorkerQueue* queue = queues_[next_queue_.Increment(1) % queues_.size()].get();
+  {
+    base::LockGuard<base::Mutex> guard(&queue->lock);
+    queue->tasks[priority].push_back(task);
+  }
+  pending_tasks_[priority].Increment(1);
   process_queue_semaphore_.Signal();
 }
 
 
-Task* TaskQueue::GetNext() {
+void TaskQueue::AppendDelayed(Task* task, double delay_in_seconds) {
+  DCHECK(!terminated_.Value());
+  {
+    base::LockGuard<base::Mutex> guard(&delayed_lock_);
+    double deadline = MonotonicallyIncreasingTime() + delay_in_seconds;
+    delayed_tasks_.push(std::make_pair(deadline, task));
+  }
+  pending_delayed_tasks_.Increment(1);
+  // Wake up a worker, so that it waits for the new deadline.
+  process_queue_semaphore_.Signal();
+}
+
+
+bool TaskQueue::PromoteDelayedTasks(double* next_deadline) {
+  if (pending_delayed_tasks_.Value() <= 0) return false;
+  if (terminated_.Value()) return false;
+  base::LockGuard<base::Mutex> guard(&delayed_lock_);
+  double now = MonotonicallyIncreasingTime();
+  while (!delayed_tasks_.empty() && delayed_tasks_.top().first <= now) {
+    Append(delayed_tasks_.top().second);
+    delayed_tasks_.pop();
+    pending_delayed_tasks_.Increment(-1);
+  }
+  if (delayed_tasks_.empty()) return false;
+  *next_deadline = delayed_tasks_.top().first;
+  return true;
+}
+
+
+Task* TaskQueue::Steal(int worker_index, Priority priority) {
+  if (pending_tasks_[priority].Value() <= 0) return NULL;
+  size_t num_queues = queues_.size();
+  for (size_t i = 0; i < num_queues; ++i) {
+    WorkerQueue* queue = queues_[(worker_index + i) % num_queues].get();
+    base::LockGuard<base::Mutex> guard(&queue->lock);
+    std::deque<Task*>& tasks = queue->tasks[priority];
+    if (!tasks.empty()) {
+      Task* result = tasks.front();
+      tasks.pop_front();
+      pending_tasks_[priority].Increment(-1);
+      return result;
+    }
+  }
+  return NULL;
+}
+
+
+Task* TaskQueue::TryGetNext(int worker_index) {
+  Task* result = Steal(worker_index, kShortRunning);
+  if (result != NULL) return result;
+  if (pending_tasks_[kLongRunning].Value() <= 0) return NULL;
+  // Reserve a slot for a long running task before looking for one.
+  if (running_long_running_tasks_.Increment(1) <= max_long_running_tasks_) {
+    result = Steal(worker_index, kLongRunning);
+    if (result != NULL) {
+      queues_[worker_index]->running_long_running_task = true;
+      return result;
+    }
+  }
+  running_long_running_tasks_.Increment(-1);
+  return NULL;
+}
+
+
+void TaskQueue::FinishTask(int worker_index) {
+  WorkerQueue* queue = queues_[worker_index].get();
+  if (!queue->running_long_running_task) return;
+  queue->running_long_running_task = false;
+  running_long_running_tasks_.Increment(-1);
+  // Waiting workers may have skipped long running tasks because all slots
+  // were taken.
+  if (pending_tasks_[kLongRunning].Value() > 0) {
+    process_queue_semaphore_.Signal();
+  }
+}
+
+
+Task* TaskQueue::GetNext(int worker_index) {
+  DCHECK_LE(0, worker_index);
+  DCHECK_LT(static_cast<size_t>(worker_index), queues_.size());
+  FinishTask(worker_index);
   for (;;) {
-    {
-      base::LockGuard<base::Mutex> guard(&lock_);
-      if (!task_queue_.empty()) {
-        Task* result = task_queue_.front();
-        task_queue_.pop();
-        return result;
-      }
-      if (terminated_) {
-        process_queue_semaphore_.Signal();
-        return NULL;
+    double next_deadline;
+    bool has_delayed_tasks = PromoteDelayedTasks(&next_deadline);
+    Task* result = TryGetNext(worker_index);
+    if (result != NULL) return result;
+    if (terminated_.Value()) {
+      process_queue_semaphore_.Signal();
+      return NULL;
+    }
+    if (has_delayed_tasks) {
+      double timeout = next_deadline - MonotonicallyIncreasingTime();
+      if (timeout > 0) {
+        // Round up, so that the deadline has passed when the wait times out.
+        int64_t timeout_in_microseconds = static_cast<int64_t>(
+            timeout * base::Time::kMicrosecondsPerSecond + 1);
+        USE(process_queue_semaphore_.WaitFor(
+            base::TimeDelta::FromMicroseconds(timeout_in_microseconds)));
       }
+    } else {
+      process_queue_semaphore_.Wait();
     }
-    process_queue_semaphore_.Wait();
   }
 }
 
 
 void TaskQueue::Terminate() {
-  base::LockGuard<base::Mutex> guard(&lock_);
-  DCHECK(!terminated_);
-  terminated_ = true;
+  DCHECK(!terminated_.Value());
+  terminated_.SetValue(true);
   process_queue_semaphore_.Signal();
 }
 
@@ -5,8 +5,15 @@
 #ifndef V8_LIBPLATFORM_TASK_QUEUE_H_
 #define V8_LIBPLATFORM_TASK_QUEUE_H_
 
+#include <deque>
+#include <functional>
+#include <memory>
 #include <queue>
+#include <utility>
+#include <vector>
 
+#include "include/v8-platform.h"
+#include "src/base/atomic-utils.h"
 #include "src/base/macros.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/semaphore.h"
@@ -17,26 +24,71 @@ class Task;
 
 namespace platform {
 
+// A queue of background tasks that is split into one sub-queue per worker, so
+// that posting and fetching tasks does not contend on a single lock. Tasks
+// are distributed round-robin; a worker without local work steals from the
+// other sub-queues. Short running tasks are always preferred over long running
+// ones, and at least one worker is kept free of long running tasks (if there
+// is more than one worker), so that short tasks are never stuck behind them.
+// Delayed tasks are kept in a timer heap and are moved to the queue by the
+// workers once their deadline has passed.
 class TaskQueue {
  public:
-  TaskQueue();
+  explicit TaskQueue(int num_workers = 1);
   ~TaskQueue();
 
   // Appends a task to the queue. The queue takes ownership of |task|.
-  void Append(Task* task);
+  void Append(Task* task, Platform::ExpectedRuntime expected_runtime =
+                              Platform::kShortRunningTask);
 
-  // Returns the next task to process. Blocks if no task is available. Returns
-  // NULL if the queue is terminated.
-  Task* GetNext();
+  // Appends a task that becomes available after |delay_in_seconds|. The queue
+  // takes ownership of |task|.
+  void AppendDelayed(Task* task, double delay_in_seconds);
 
-  // Terminate the queue.
+  // Returns the next task to process for the worker with index
+  // |worker_index|. Blocks if no task is available. Returns NULL if the queue
+  // is terminated. A worker calling GetNext() again signals that it finished
+  // the previously returned task.
+  Task* GetNext(int worker_index = 0);
+
+  // Terminate the queue. Delayed tasks that are not due yet are dropped.
   void Terminate();
 
  private:
+  typedef std::pair<double, Task*> DelayedEntry;
+  enum Priority { kShortRunning, kLongRunning, kNumberOfPriorities };
+
+  struct WorkerQueue {
+    WorkerQueue() : running_long_running_task(false) {}
+
+    base::Mutex lock;
+    std::deque<Task*> tasks[kNumberOfPriorities];
+    // Only accessed by the worker owning this queue.
+    bool running_long_running_task;
+  };
+
+  // Takes a task of the given priority, starting with the worker's own queue.
+  Task* Steal(int worker_index, Priority priority);
+  Task* TryGetNext(int worker_index);
+  void FinishTask(int worker_index);
+  // Appends all delayed tasks whose deadline has passed. Returns false if no
+  // delayed tasks are left, otherwise the deadline of the next one is stored
+  // in |next_deadline|.
+  bool PromoteDelayedTasks(double* next_deadline);
+
   base::Semaphore process_queue_semaphore_;
-  base::Mutex lock_;
-  std::queue<Task*> task_queue_;
-  bool terminated_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  const int max_long_running_tasks_;
+  base::AtomicNumber<size_t> next_queue_;
+  base::AtomicNumber<int> pending_tasks_[kNumberOfPriorities];
+  base::AtomicNumber<int> running_long_running_tasks_;
+  base::AtomicValue<bool> terminated_;
+
+  base::Mutex delayed_lock_;
+  std::priority_queue<DelayedEntry, std::vector<DelayedEntry>,
+                      std::greater<DelayedEntry> >
+      delayed_tasks_;
+  base::AtomicNumber<int> pending_delayed_tasks_;
 
   DISALLOW_COPY_AND_ASSIGN(TaskQueue);
 };
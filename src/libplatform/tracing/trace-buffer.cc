@@ -0,0 +1,194 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/libplatform/tracing/trace-buffer.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+TraceBufferRingBuffer::TraceBufferRingBuffer(size_t max_chunks,
+                                             TraceWriter* trace_writer)
+    : thread_local_key_(base::Thread::CreateThreadLocalKey()),
+      max_chunks_(max_chunks),
+      trace_writer_(trace_writer),
+      chunks_(max_chunks) {}
+
+TraceBufferRingBuffer::~TraceBufferRingBuffer() {
+  base::Thread::DeleteThreadLocalKey(thread_local_key_);
+}
+
+TraceObject* TraceBufferRingBuffer::AddTraceEvent(uint64_t* handle) {
+  size_t chunk_index = static_cast<size_t>(
+      reinterpret_cast<intptr_t>(base::Thread::GetThreadLocal(
+          thread_local_key_)));
+  TraceBufferChunk* chunk = nullptr;
+  TraceObject* trace_object = nullptr;
+  // The sequence number is read before a slot is taken. If the chunk is
+  // recycled in between, the handle is stale instead of naming another
+  // thread's event.
+  uint32_t chunk_seq = 0;
+  size_t event_index;
+  if (chunk_index != 0) {
+    chunk_index--;
+    chunk = chunks_[chunk_index].get();
+    chunk_seq = chunk->seq();
+    trace_object = chunk->AddTraceEvent(&event_index);
+  }
+  if (trace_object == nullptr) {
+    // The chunk has been filled up, possibly by another thread it was handed
+    // out to after being recycled.
+    chunk = AcquireChunk(&chunk_index);
+    if (chunk == nullptr) {
+      base::Thread::SetThreadLocal(thread_local_key_, nullptr);
+      return nullptr;
+    }
+    base::Thread::SetThreadLocal(
+        thread_local_key_,
+        reinterpret_cast<void*>(static_cast<intptr_t>(chunk_index + 1)));
+    chunk_seq = chunk->seq();
+    trace_object = chunk->AddTraceEvent(&event_index);
+    if (trace_object == nullptr) return nullptr;
+  }
+  *handle = MakeHandle(chunk_index, chunk_seq, event_index);
+  if (event_index == TraceBufferChunk::kChunkSize - 1) {
+    // Only one thread takes the last slot of a chunk, so the chunk is queued
+    // for recycling exactly once.
+    ReleaseChunk(chunk_index);
+    base::Thread::SetThreadLocal(thread_local_key_, nullptr);
+  }
+  return trace_object;
+}
+
+TraceObject* TraceBufferRingBuffer::GetEventByHandle(uint64_t handle) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return GetEventByHandleLocked(handle);
+}
+
+void TraceBufferRingBuffer::UpdateEventDuration(uint64_t handle) {
+  // Chunks are only recycled while holding the mutex, so the event cannot be
+  // reset by another thread while the duration is written.
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  TraceObject* trace_object = GetEventByHandleLocked(handle);
+  if (trace_object) trace_object->UpdateDuration();
+}
+
+TraceObject* TraceBufferRingBuffer::GetEventByHandleLocked(uint64_t handle) {
+  size_t chunk_index, event_index;
+  uint32_t chunk_seq;
+  ExtractHandle(handle, &chunk_index, &chunk_seq, &event_index);
+  if (chunk_index >= max_chunks_) return nullptr;
+  TraceBufferChunk* chunk = chunks_[chunk_index].get();
+  if (!chunk || chunk->seq() != chunk_seq || event_index >= chunk->size()) {
+    return nullptr;
+  }
+  return chunk->GetEventAt(event_index);
+}
+
+bool TraceBufferRingBuffer::Flush() {
+  // Chunks are filled without holding the mutex, so the events are only
+  // complete if no thread is recording anymore.
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  for (size_t i = 0; i < next_chunk_index_; ++i) {
+    TraceBufferChunk* chunk = chunks_[i].get();
+    for (size_t j = 0; j < chunk->size(); ++j) {
+      trace_writer_->AppendTraceEvent(chunk->GetEventAt(j));
+    }
+  }
+  trace_writer_->Flush();
+  return true;
+}
+
+TraceBufferChunk* TraceBufferRingBuffer::AcquireChunk(size_t* chunk_index) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  if (next_chunk_index_ < max_chunks_) {
+    *chunk_index = next_chunk_index_++;
+    chunks_[*chunk_index].reset(new TraceBufferChunk(current_chunk_seq_++));
+  } else if (!full_chunks_.empty()) {
+    *chunk_index = full_chunks_.front();
+    full_chunks_.pop_front();
+    chunks_[*chunk_index]->Reset(current_chunk_seq_++);
+  } else if (SealOldestChunk(chunk_index)) {
+    chunks_[*chunk_index]->Reset(current_chunk_seq_++);
+  } else {
+    return nullptr;
+  }
+  return chunks_[*chunk_index].get();
+}
+
+bool TraceBufferRingBuffer::SealOldestChunk(size_t* chunk_index) {
+  // Every chunk has been handed out to a thread that has not filled it up,
+  // e.g. because the thread exited or records into another buffer now. The
+  // chunk with the smallest sequence number was handed out first. Sealing
+  // fails for a chunk whose last slot has just been taken, because that
+  // chunk is about to be released.
+  std::vector<bool> skip(max_chunks_, false);
+  for (size_t attempt = 0; attempt < max_chunks_; ++attempt) {
+    size_t oldest = max_chunks_;
+    for (size_t i = 0; i < max_chunks_; ++i) {
+      if (skip[i]) continue;
+      if (oldest == max_chunks_ || chunks_[i]->seq() < chunks_[oldest]->seq()) {
+        oldest = i;
+      }
+    }
+    if (oldest == max_chunks_) break;
+    if (chunks_[oldest]->Seal()) {
+      *chunk_index = oldest;
+      return true;
+    }
+    skip[oldest] = true;
+  }
+  return false;
+}
+
+void TraceBufferRingBuffer::ReleaseChunk(size_t chunk_index) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  full_chunks_.push_back(chunk_index);
+}
+
+uint64_t TraceBufferRingBuffer::MakeHandle(size_t chunk_index,
+                                           uint32_t chunk_seq,
+                                           size_t event_index) const {
+  return static_cast<uint64_t>(chunk_seq) * Capacity() +
+         chunk_index * TraceBufferChunk::kChunkSize + event_index;
+}
+
+void TraceBufferRingBuffer::ExtractHandle(uint64_t handle, size_t* chunk_index,
+                                          uint32_t* chunk_seq,
+                                          size_t* event_index) const {
+  *chunk_seq = static_cast<uint32_t>(handle / Capacity());
+  size_t indices = handle % Capacity();
+  *chunk_index = indices / TraceBufferChunk::kChunkSize;
+  *event_index = indices % TraceBufferChunk::kChunkSize;
+}
+
+TraceBufferChunk::TraceBufferChunk(uint32_t seq) : next_free_(0), seq_(seq) {}
+
+void TraceBufferChunk::Reset(uint32_t new_seq) {
+  // Publish the new sequence number before any slot can be taken again, so
+  // that handles of new events carry it.
+  seq_.store(new_seq, std::memory_order_release);
+  next_free_.store(0);
+}
+
+TraceObject* TraceBufferChunk::AddTraceEvent(size_t* event_index) {
+  size_t index = next_free_.fetch_add(1);
+  if (index >= kChunkSize) return nullptr;
+  *event_index = index;
+  return &chunk_[index];
+}
+
+void TraceBuffer::UpdateEventDuration(uint64_t handle) {
+  TraceObject* trace_object = GetEventByHandle(handle);
+  if (trace_object) trace_object->UpdateDuration();
+}
+
+TraceBuffer* TraceBuffer::CreateTraceBufferRingBuffer(
+    size_t max_chunks, TraceWriter* trace_writer) {
+  return new TraceBufferRingBuffer(max_chunks, trace_writer);
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
@@ -0,0 +1,70 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
+#define V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "include/libplatform/v8-tracing.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+// A ring buffer of trace event chunks. Every thread fills the chunk it was
+// handed out last, so recording an event only touches thread-local state and
+// the chunk's atomic slot counter. The mutex is taken when a thread needs a
+// new chunk, i.e., once every TraceBufferChunk::kChunkSize events. A chunk is
+// queued for recycling as soon as its last slot is taken, and full chunks are
+// recycled oldest first. If no chunk is full, the chunk that was handed out
+// first is sealed and recycled.
+class TraceBufferRingBuffer : public TraceBuffer {
+ public:
+  TraceBufferRingBuffer(size_t max_chunks, TraceWriter* trace_writer);
+  ~TraceBufferRingBuffer();
+
+  TraceObject* AddTraceEvent(uint64_t* handle) override;
+  TraceObject* GetEventByHandle(uint64_t handle) override;
+  void UpdateEventDuration(uint64_t handle) override;
+  // Must not be called while other threads add events.
+  bool Flush() override;
+
+ private:
+  // Hands out a fresh or recycled chunk. Returns nullptr only if the last
+  // slot of every chunk has been taken, but none of them has been released
+  // yet.
+  TraceBufferChunk* AcquireChunk(size_t* chunk_index);
+  bool SealOldestChunk(size_t* chunk_index);
+  void ReleaseChunk(size_t chunk_index);
+
+  uint64_t MakeHandle(size_t chunk_index, uint32_t chunk_seq,
+                      size_t event_index) const;
+  void ExtractHandle(uint64_t handle, size_t* chunk_index, uint32_t* chunk_seq,
+                     size_t* event_index) const;
+  size_t Capacity() const { return max_chunks_ * TraceBufferChunk::kChunkSize; }
+  TraceObject* GetEventByHandleLocked(uint64_t handle);
+
+  base::Mutex mutex_;
+  // Holds 1 + the index of the chunk the current thread fills, or 0.
+  const base::Thread::LocalStorageKey thread_local_key_;
+  const size_t max_chunks_;
+  std::unique_ptr<TraceWriter> trace_writer_;
+  // Sized to |max_chunks_| up front, so that slots never move.
+  std::vector<std::unique_ptr<TraceBufferChunk>> chunks_;
+  size_t next_chunk_index_ = 0;
+  // Full chunks in the order they were filled up.
+  std::deque<size_t> full_chunks_;
+  uint32_t current_chunk_seq_ = 1;
+};
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
+
+#endif  // V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
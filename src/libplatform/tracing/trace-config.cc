@@ -0,0 +1,58 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include "include/libplatform/v8-tracing.h"
+#include "src/base/logging.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+static const char kDisabledByDefaultPrefix[] = "disabled-by-default-";
+
+TraceConfig* TraceConfig::CreateDefaultTraceConfig() {
+  TraceConfig* trace_config = new TraceConfig();
+  trace_config->included_categories_.push_back("v8");
+  return trace_config;
+}
+
+void TraceConfig::AddIncludedCategory(const char* included_category) {
+  DCHECK(included_category != NULL && strlen(included_category) > 0);
+  included_categories_.push_back(included_category);
+}
+
+void TraceConfig::AddIncludedCategories(const char* included_categories) {
+  const char* start = included_categories;
+  while (*start != '\0') {
+    const char* end = strchr(start, ',');
+    if (end == nullptr) end = start + strlen(start);
+    if (end > start) included_categories_.push_back(std::string(start, end));
+    start = *end == ',' ? end + 1 : end;
+  }
+}
+
+bool TraceConfig::IsCategoryGroupEnabled(const char* category_group) const {
+  const char* start = category_group;
+  while (*start != '\0') {
+    const char* end = strchr(start, ',');
+    if (end == nullptr) end = start + strlen(start);
+    std::string category(start, end);
+    // The wildcard does not match categories that are disabled by default.
+    bool matches_wildcard =
+        category.compare(0, strlen(kDisabledByDefaultPrefix),
+                         kDisabledByDefaultPrefix) != 0;
+    for (const std::string& included : included_categories_) {
+      if (included == category) return true;
+      if (included == "*" && matches_wildcard) return true;
+    }
+    start = *end == ',' ? end + 1 : end;
+  }
+  return false;
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
@@ -0,0 +1,165 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/libplatform/tracing/trace-writer.h"
+
+#include <string.h>
+
+#include <cmath>
+
+#include "base/trace_event/common/trace_event_common.h"
+#include "src/base/format-macros.h"
+#include "src/base/platform/platform.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+// Writes the given string to a stream, taking care to escape characters
+// when necessary.
+V8_INLINE static void WriteJSONStringToStream(const char* str,
+                                              std::ostream& stream) {
+  size_t len = strlen(str);
+  stream << "\"";
+  for (size_t i = 0; i < len; ++i) {
+    // All of the permitted escape sequences in JSON strings, as per
+    // https://mathiasbynens.be/notes/javascript-escapes
+    switch (str[i]) {
+      case '\b':
+        stream << "\\b";
+        break;
+      case '\f':
+        stream << "\\f";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      case '\r':
+        stream << "\\r";
+        break;
+      case '\t':
+        stream << "\\t";
+        break;
+      case '\"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      // Note that because we use double quotes for JSON strings,
+      // we don't need to escape single quotes.
+      default:
+        if (static_cast<unsigned char>(str[i]) < 0x20) {
+          char buffer[8];
+          base::OS::SNPrintF(buffer, sizeof(buffer), "\\u%04x",
+                             static_cast<unsigned char>(str[i]));
+          stream << buffer;
+        } else {
+          stream << str[i];
+        }
+        break;
+    }
+  }
+  stream << "\"";
+}
+
+void JSONTraceWriter::AppendArgValue(uint8_t type,
+                                     TraceObject::ArgValue value) {
+  switch (type) {
+    case TRACE_VALUE_TYPE_BOOL:
+      stream_ << (value.as_bool ? "true" : "false");
+      break;
+    case TRACE_VALUE_TYPE_UINT:
+      stream_ << value.as_uint;
+      break;
+    case TRACE_VALUE_TYPE_INT:
+      stream_ << value.as_int;
+      break;
+    case TRACE_VALUE_TYPE_DOUBLE: {
+      double val = value.as_double;
+      if (std::isfinite(val)) {
+        stream_ << val;
+      } else if (std::isnan(val)) {
+        // JSON has no representation for NaN and infinities, use strings.
+        stream_ << "\"NaN\"";
+      } else {
+        stream_ << (val < 0 ? "\"-Infinity\"" : "\"Infinity\"");
+      }
+      break;
+    }
+    case TRACE_VALUE_TYPE_POINTER: {
+      char buffer[32];
+      base::OS::SNPrintF(buffer, sizeof(buffer), "\"%p\"", value.as_pointer);
+      stream_ << buffer;
+      break;
+    }
+    case TRACE_VALUE_TYPE_STRING:
+    case TRACE_VALUE_TYPE_COPY_STRING:
+      if (value.as_string == nullptr) {
+        stream_ << "\"NULL\"";
+      } else {
+        WriteJSONStringToStream(value.as_string, stream_);
+      }
+      break;
+    default:
+      // Convertable values are not supported by this writer.
+      stream_ << "\"\"";
+      break;
+  }
+}
+
+JSONTraceWriter::JSONTraceWriter(std::ostream& stream) : stream_(stream) {
+  stream_ << "{\"traceEvents\":[";
+}
+
+JSONTraceWriter::~JSONTraceWriter() { stream_ << "]}"; }
+
+void JSONTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
+  if (append_comma_) stream_ << ",";
+  append_comma_ = true;
+  stream_ << "{\"pid\":" << trace_event->pid()
+          << ",\"tid\":" << trace_event->tid()
+          << ",\"ts\":" << trace_event->ts()
+          << ",\"tts\":" << trace_event->tts() << ",\"ph\":\""
+          << trace_event->phase() << "\",\"cat\":";
+  WriteJSONStringToStream(TracingController::GetCategoryGroupName(
+                              trace_event->category_enabled_flag()),
+                          stream_);
+  stream_ << ",\"name\":";
+  WriteJSONStringToStream(trace_event->name(), stream_);
+  stream_ << ",\"dur\":" << trace_event->duration()
+          << ",\"tdur\":" << trace_event->cpu_duration();
+  if (trace_event->flags() & TRACE_EVENT_FLAG_HAS_ID) {
+    if (trace_event->scope() != nullptr) {
+      stream_ << ",\"scope\":";
+      WriteJSONStringToStream(trace_event->scope(), stream_);
+    }
+    // So as not to lose bits from a 64-bit integer, output as a hex string.
+    char buffer[24];
+    base::OS::SNPrintF(buffer, sizeof(buffer), "\"0x%" PRIx64 "\"",
+                       trace_event->id());
+    stream_ << ",\"id\":" << buffer;
+  }
+  stream_ << ",\"args\":{";
+  const char** arg_names = trace_event->arg_names();
+  const uint8_t* arg_types = trace_event->arg_types();
+  TraceObject::ArgValue* arg_values = trace_event->arg_values();
+  for (int i = 0; i < trace_event->num_args(); ++i) {
+    if (i > 0) stream_ << ",";
+    WriteJSONStringToStream(arg_names[i], stream_);
+    stream_ << ":";
+    AppendArgValue(arg_types[i], arg_values[i]);
+  }
+  stream_ << "}}";
+}
+
+void JSONTraceWriter::Flush() { stream_.flush(); }
+
+TraceWriter* TraceWriter::CreateJSONTraceWriter(std::ostream& stream) {
+  return new JSONTraceWriter(stream);
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
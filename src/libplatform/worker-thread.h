@@ -18,7 +18,8 @@ class TaskQueue;
 
 class WorkerThread : public base::Thread {
  public:
-  explicit WorkerThread(TaskQueue* queue);
+  // |index| selects the sub-queue of |queue| this worker prefers.
+  explicit WorkerThread(TaskQueue* queue, int index = 0);
   virtual ~WorkerThread();
 
   // Thread implementation.
@@ -28,6 +29,7 @@ class WorkerThread : public base::Thread {
   friend class QuitTask;
 
   TaskQueue* queue_;
+  int index_;
 
   DISALLOW_COPY_AND_ASSIGN(WorkerThread);
 };
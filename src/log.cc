@@ -1601,6 +1601,10 @@ void Logger::LogBytecodeHandlers() {
 
 void Logger::LogExistingFunction(Handle<SharedFunctionInfo> shared,
                                  Handle<AbstractCode> code) {
+  // Profilers build their line tables from the logged code's positions.
+  if (code->IsBytecodeArray()) {
+    SharedFunctionInfo::EnsureSourcePositionsAvailable(shared);
+  }
   Handle<String> func_name(shared->DebugName());
   if (shared->script()->IsScript()) {
     Handle<Script> script(Script::cast(shared->script()));
@@ -4001,6 +4001,25 @@ void BytecodeArray::set_interrupt_budget(int interrupt_budget) {
   WRITE_INT_FIELD(this, kInterruptBudgetOffset, interrupt_budget);
 }
 
+int BytecodeArray::bytecode_age() const {
+  return READ_INT8_FIELD(this, kBytecodeAgeOffset);
+}
+
+void BytecodeArray::set_bytecode_age(int age) {
+  DCHECK_GE(age, kNoAgeBytecodeAge);
+  DCHECK_LE(age, kIsOldBytecodeAge);
+  WRITE_INT8_FIELD(this, kBytecodeAgeOffset, static_cast<int8_t>(age));
+}
+
+void BytecodeArray::MakeOlder() {
+  int age = bytecode_age();
+  if (age < kIsOldBytecodeAge) set_bytecode_age(age + 1);
+}
+
+bool BytecodeArray::IsOld() const {
+  return bytecode_age() >= kIsOldBytecodeAge;
+}
+
 int BytecodeArray::parameter_count() const {
   // Parameter count is stored as the size on stack of the parameters to allow
   // it to be used directly by generated code.
@@ -4010,9 +4029,20 @@ int BytecodeArray::parameter_count() const {
 
 ACCESSORS(BytecodeArray, constant_pool, FixedArray, kConstantPoolOffset)
 ACCESSORS(BytecodeArray, handler_table, FixedArray, kHandlerTableOffset)
-ACCESSORS(BytecodeArray, source_position_table, ByteArray,
+ACCESSORS(BytecodeArray, source_position_table, Object,
           kSourcePositionTableOffset)
 
+ByteArray* BytecodeArray::SourcePositionTable() {
+  Object* table = source_position_table();
+  if (table->IsByteArray()) return ByteArray::cast(table);
+  DCHECK(table->IsUndefined());
+  return GetHeap()->empty_byte_array();
+}
+
+bool BytecodeArray::HasSourcePositionTable() {
+  return source_position_table()->IsByteArray();
+}
+
 Address BytecodeArray::GetFirstBytecodeAddress() {
   return reinterpret_cast<Address>(this) - kHeapObjectTag + kHeaderSize;
 }
@@ -4913,6 +4943,10 @@ void Code::set_has_debug_break_slots(bool value) {
 
 
 bool Code::has_reloc_info_for_serialization() {
+  if (kind() == OPTIMIZED_FUNCTION) {
+    return HasRelocInfoForSerializationField::decode(
+        READ_UINT32_FIELD(this, kKindSpecificFlags1Offset));
+  }
   DCHECK_EQ(FUNCTION, kind());
   unsigned flags = READ_UINT32_FIELD(this, kFullCodeFlags);
   return FullCodeFlagsHasRelocInfoForSerialization::decode(flags);
@@ -4920,6 +4954,12 @@ bool Code::has_reloc_info_for_serialization() {
 
 
 void Code::set_has_reloc_info_for_serialization(bool value) {
+  if (kind() == OPTIMIZED_FUNCTION) {
+    int previous = READ_UINT32_FIELD(this, kKindSpecificFlags1Offset);
+    int updated = HasRelocInfoForSerializationField::update(previous, value);
+    WRITE_UINT32_FIELD(this, kKindSpecificFlags1Offset, updated);
+    return;
+  }
   DCHECK_EQ(FUNCTION, kind());
   unsigned flags = READ_UINT32_FIELD(this, kFullCodeFlags);
   flags = FullCodeFlagsHasRelocInfoForSerialization::update(flags, value);
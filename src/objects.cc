@@ -11245,6 +11245,15 @@ void SharedFunctionInfo::AddSharedCodeToOptimizedCodeMap(
   }
 }
 
+// static
+void SharedFunctionInfo::EnsureSourcePositionsAvailable(
+    Handle<SharedFunctionInfo> shared) {
+  if (shared->HasBytecodeArray() &&
+      !shared->bytecode_array()->HasSourcePositionTable()) {
+    Compiler::CollectSourcePositions(shared);
+  }
+}
+
 // static
 void SharedFunctionInfo::AddToOptimizedCodeMap(
     Handle<SharedFunctionInfo> shared, Handle<Context> native_context,
@@ -12235,6 +12244,9 @@ void Script::SetEvalOrigin(Handle<Script> script,
     StackTraceFrameIterator it(script->GetIsolate());
     if (!it.done() && it.is_javascript()) {
       FrameSummary summary = FrameSummary::GetFirst(it.javascript_frame());
+      // The offset is translated later, when GetEvalPosition must not
+      // allocate, so collect lazy source positions now.
+      summary.EnsureSourcePositionsAvailable();
       script->set_eval_from_shared(summary.function()->shared());
       script->set_eval_from_position(-summary.code_offset());
       return;
@@ -13869,7 +13881,7 @@ void Code::Disassemble(const char* name, std::ostream& os) {  // NOLINT
 int BytecodeArray::SourcePosition(int offset) {
   int last_position = 0;
   for (interpreter::SourcePositionTableIterator iterator(
-           source_position_table());
+           SourcePositionTable());
        !iterator.done() && iterator.bytecode_offset() <= offset;
        iterator.Advance()) {
     last_position = iterator.source_position();
@@ -13883,7 +13895,7 @@ int BytecodeArray::SourceStatementPosition(int offset) {
   int position = SourcePosition(offset);
   // Now find the closest statement position before the position.
   int statement_position = 0;
-  interpreter::SourcePositionTableIterator iterator(source_position_table());
+  interpreter::SourcePositionTableIterator iterator(SourcePositionTable());
   while (!iterator.done()) {
     if (iterator.is_statement()) {
       int p = iterator.source_position();
@@ -13902,7 +13914,7 @@ void BytecodeArray::Disassemble(std::ostream& os) {
 
   const uint8_t* base_address = GetFirstBytecodeAddress();
   interpreter::SourcePositionTableIterator source_positions(
-      source_position_table());
+      SourcePositionTable());
 
   interpreter::BytecodeArrayIterator iterator(handle(this));
   while (!iterator.done()) {
@@ -4423,6 +4423,17 @@ class BytecodeArray : public FixedArrayBase {
   inline int interrupt_budget() const;
   inline void set_interrupt_budget(int interrupt_budget);
 
+  // Accessors for the bytecode age. The age is incremented by every
+  // mark-compact that visits the array and reset to kNoAgeBytecodeAge when
+  // the function is entered; old bytecode can be flushed (see
+  // --flush-bytecode).
+  static const int kNoAgeBytecodeAge = 0;
+  static const int kIsOldBytecodeAge = 3;
+  inline int bytecode_age() const;
+  inline void set_bytecode_age(int age);
+  inline void MakeOlder();
+  inline bool IsOld() const;
+
   // Accessors for the constant pool.
   DECL_ACCESSORS(constant_pool, FixedArray)
 
@@ -4430,8 +4441,14 @@ class BytecodeArray : public FixedArrayBase {
   DECL_ACCESSORS(handler_table, FixedArray)
 
   // Accessors for source position table containing mappings between byte code
-  // offset and source position.
-  DECL_ACCESSORS(source_position_table, ByteArray)
+  // offset and source position. Holds undefined if the positions have not
+  // been collected yet (see --lazy-source-positions).
+  DECL_ACCESSORS(source_position_table, Object)
+
+  // Returns the source position table, or the empty byte array if the
+  // positions have not been collected yet.
+  inline ByteArray* SourcePositionTable();
+  inline bool HasSourcePositionTable();
 
   DECLARE_CAST(BytecodeArray)
 
@@ -4458,7 +4475,8 @@ class BytecodeArray : public FixedArrayBase {
   static const int kFrameSizeOffset = kSourcePositionTableOffset + kPointerSize;
   static const int kParameterSizeOffset = kFrameSizeOffset + kIntSize;
   static const int kInterruptBudgetOffset = kParameterSizeOffset + kIntSize;
-  static const int kHeaderSize = kInterruptBudgetOffset + kIntSize;
+  static const int kBytecodeAgeOffset = kInterruptBudgetOffset + kIntSize;
+  static const int kHeaderSize = kBytecodeAgeOffset + kCharSize;
 
   // Maximal memory consumption for a single BytecodeArray.
   static const int kMaxSize = 512 * MB;
@@ -4998,9 +5016,9 @@ class Code: public HeapObject {
   inline bool has_debug_break_slots();
   inline void set_has_debug_break_slots(bool value);
 
-  // [has_reloc_info_for_serialization]: For FUNCTION kind, tells if its
-  // reloc info includes runtime and external references to support
-  // serialization/deserialization.
+  // [has_reloc_info_for_serialization]: For FUNCTION and OPTIMIZED_FUNCTION
+  // kind, tells if its reloc info includes runtime and external references to
+  // support serialization/deserialization.
   inline bool has_reloc_info_for_serialization();
   inline void set_has_reloc_info_for_serialization(bool value);
 
@@ -5277,9 +5295,10 @@ class Code: public HeapObject {
       kStackSlotsFirstBit + kStackSlotsBitCount;
   static const int kIsTurbofannedBit = kMarkedForDeoptimizationBit + 1;
   static const int kCanHaveWeakObjects = kIsTurbofannedBit + 1;
+  static const int kHasRelocInfoForSerializationBit = kCanHaveWeakObjects + 1;
 
   STATIC_ASSERT(kStackSlotsFirstBit + kStackSlotsBitCount <= 32);
-  STATIC_ASSERT(kCanHaveWeakObjects + 1 <= 32);
+  STATIC_ASSERT(kHasRelocInfoForSerializationBit + 1 <= 32);
 
   class StackSlotsField: public BitField<int,
       kStackSlotsFirstBit, kStackSlotsBitCount> {};  // NOLINT
@@ -5289,6 +5308,9 @@ class Code: public HeapObject {
   };  // NOLINT
   class CanHaveWeakObjectsField
       : public BitField<bool, kCanHaveWeakObjects, 1> {};  // NOLINT
+  class HasRelocInfoForSerializationField
+      : public BitField<bool, kHasRelocInfoForSerializationBit, 1> {
+  };  // NOLINT
 
   // KindSpecificFlags2 layout (ALL)
   static const int kIsCrankshaftedBit = 0;
@@ -6706,6 +6728,11 @@ class SharedFunctionInfo: public HeapObject {
   inline void set_bytecode_array(BytecodeArray* bytecode);
   inline void ClearBytecodeArray();
 
+  // Collects the source positions of the bytecode if they were omitted when
+  // it was compiled. Call before reading positions that must be accurate.
+  static void EnsureSourcePositionsAvailable(
+      Handle<SharedFunctionInfo> shared);
+
   // [function identifier]: This field holds an additional identifier for the
   // function.
   //  - a Smi identifying a builtin function [HasBuiltinFunctionId()].
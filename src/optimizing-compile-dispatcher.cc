@@ -71,6 +71,25 @@ class OptimizingCompileDispatcher::CompileTask : public v8::Task {
 };
 
 
+OptimizingCompileDispatcher::OptimizingCompileDispatcher(Isolate* isolate)
+    : isolate_(isolate),
+      input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
+      input_queue_length_(0),
+      input_queue_shift_(0),
+      osr_buffer_cursor_(0),
+      blocked_jobs_(0),
+      ref_count_(0),
+      recompilation_delay_(FLAG_concurrent_recompilation_delay) {
+  base::NoBarrier_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
+  input_queue_ = NewArray<CompilationJob*>(input_queue_capacity_);
+  // Every queued OSR job needs a slot, plus some slack for finished jobs that
+  // are waiting to be picked up by their loop.
+  osr_buffer_capacity_ = input_queue_capacity_ + 4;
+  osr_buffer_ = NewArray<CompilationJob*>(osr_buffer_capacity_);
+  for (int i = 0; i < osr_buffer_capacity_; i++) osr_buffer_[i] = NULL;
+}
+
+
 OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
 #ifdef DEBUG
   {
@@ -80,6 +99,12 @@ OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
 #endif
   DCHECK_EQ(0, input_queue_length_);
   DeleteArray(input_queue_);
+#ifdef DEBUG
+  for (int i = 0; i < osr_buffer_capacity_; i++) {
+    DCHECK_NULL(osr_buffer_[i]);
+  }
+#endif
+  DeleteArray(osr_buffer_);
 }
 
 CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
@@ -91,8 +116,11 @@ CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
   input_queue_length_--;
   if (check_if_flushing) {
     if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
-      AllowHandleDereference allow_handle_dereference;
-      DisposeCompilationJob(job, true);
+      // OSR jobs are owned by the OSR buffer, which is flushed separately.
+      if (!job->info()->is_osr()) {
+        AllowHandleDereference allow_handle_dereference;
+        DisposeCompilationJob(job, true);
+      }
       return NULL;
     }
   }
@@ -106,6 +134,13 @@ void OptimizingCompileDispatcher::CompileNext(CompilationJob* job) {
   CompilationJob::Status status = job->OptimizeGraph();
   USE(status);  // Prevent an unused-variable error.
 
+  // OSR jobs wait in the OSR buffer until their loop asks for them.
+  if (job->info()->is_osr()) {
+    base::LockGuard<base::Mutex> access_osr_buffer(&osr_buffer_mutex_);
+    job->WaitForInstall();
+    return;
+  }
+
   // The function may have already been optimized by OSR.  Simply continue.
   // Use a mutex to make sure that functions marked for install
   // are always also queued.
@@ -130,6 +165,17 @@ void OptimizingCompileDispatcher::FlushOutputQueue(bool restore_function_code) {
 }
 
 
+void OptimizingCompileDispatcher::FlushOSRBuffer() {
+  base::LockGuard<base::Mutex> access_osr_buffer(&osr_buffer_mutex_);
+  for (int i = 0; i < osr_buffer_capacity_; i++) {
+    if (osr_buffer_[i] != NULL) {
+      DisposeCompilationJob(osr_buffer_[i], false);
+      osr_buffer_[i] = NULL;
+    }
+  }
+}
+
+
 void OptimizingCompileDispatcher::Flush() {
   base::Release_Store(&mode_, static_cast<base::AtomicWord>(FLUSH));
   if (FLAG_block_concurrent_recompilation) Unblock();
@@ -139,6 +185,7 @@ void OptimizingCompileDispatcher::Flush() {
     base::Release_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
   }
   FlushOutputQueue(true);
+  FlushOSRBuffer();
   if (FLAG_trace_concurrent_recompilation) {
     PrintF("  ** Flushed concurrent recompilation queues.\n");
   }
@@ -162,6 +209,7 @@ void OptimizingCompileDispatcher::Stop() {
   } else {
     FlushOutputQueue(false);
   }
+  FlushOSRBuffer();
 }
 
 
@@ -193,6 +241,7 @@ void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
 
 void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
   DCHECK(IsQueueAvailable());
+  if (job->info()->is_osr()) AddToOSRBuffer(job);
   {
     // Add job to the back of the input queue.
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
@@ -204,7 +253,7 @@ void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
     blocked_jobs_++;
   } else {
     V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new CompileTask(isolate_), v8::Platform::kShortRunningTask);
+        new CompileTask(isolate_), v8::Platform::kLongRunningTask);
   }
 }
 
@@ -212,11 +261,89 @@ void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
 void OptimizingCompileDispatcher::Unblock() {
   while (blocked_jobs_ > 0) {
     V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new CompileTask(isolate_), v8::Platform::kShortRunningTask);
+        new CompileTask(isolate_), v8::Platform::kLongRunningTask);
     blocked_jobs_--;
   }
 }
 
 
+CompilationJob* OptimizingCompileDispatcher::FindReadyOSRCandidate(
+    Handle<JSFunction> function, BailoutId osr_ast_id) {
+  base::LockGuard<base::Mutex> access_osr_buffer(&osr_buffer_mutex_);
+  for (int i = 0; i < osr_buffer_capacity_; i++) {
+    CompilationJob* current = osr_buffer_[i];
+    if (current != NULL && current->IsWaitingForInstall() &&
+        current->info()->osr_ast_id() == osr_ast_id &&
+        *current->info()->closure() == *function) {
+      osr_buffer_[i] = NULL;
+      return current;
+    }
+  }
+  return NULL;
+}
+
+
+bool OptimizingCompileDispatcher::IsQueuedForOSR(Handle<JSFunction> function,
+                                                 BailoutId osr_ast_id) {
+  base::LockGuard<base::Mutex> access_osr_buffer(&osr_buffer_mutex_);
+  for (int i = 0; i < osr_buffer_capacity_; i++) {
+    CompilationJob* current = osr_buffer_[i];
+    if (current != NULL && current->info()->osr_ast_id() == osr_ast_id &&
+        *current->info()->closure() == *function) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool OptimizingCompileDispatcher::IsQueuedForOSR(JSFunction* function) {
+  base::LockGuard<base::Mutex> access_osr_buffer(&osr_buffer_mutex_);
+  for (int i = 0; i < osr_buffer_capacity_; i++) {
+    CompilationJob* current = osr_buffer_[i];
+    if (current != NULL && *current->info()->closure() == function) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool OptimizingCompileDispatcher::IsOSRBufferAvailable() {
+  base::LockGuard<base::Mutex> access_osr_buffer(&osr_buffer_mutex_);
+  for (int i = 0; i < osr_buffer_capacity_; i++) {
+    CompilationJob* current = osr_buffer_[i];
+    if (current == NULL || current->IsWaitingForInstall()) return true;
+  }
+  return false;
+}
+
+
+void OptimizingCompileDispatcher::AddToOSRBuffer(CompilationJob* job) {
+  base::LockGuard<base::Mutex> access_osr_buffer(&osr_buffer_mutex_);
+  // Find the next slot that is empty or holds a finished job that was never
+  // picked up, e.g. because the loop was left in the meantime.
+  CompilationJob* stale;
+  while (true) {
+    stale = osr_buffer_[osr_buffer_cursor_];
+    if (stale == NULL || stale->IsWaitingForInstall()) break;
+    osr_buffer_cursor_ = (osr_buffer_cursor_ + 1) % osr_buffer_capacity_;
+  }
+
+  // Add to the found slot and dispose the evicted job.
+  if (stale != NULL) {
+    if (FLAG_trace_osr) {
+      PrintF("[COSR - Discarded ");
+      stale->info()->closure()->PrintName();
+      PrintF(", AST id %d]\n", stale->info()->osr_ast_id().ToInt());
+    }
+    DisposeCompilationJob(stale, false);
+  }
+
+  osr_buffer_[osr_buffer_cursor_] = job;
+  osr_buffer_cursor_ = (osr_buffer_cursor_ + 1) % osr_buffer_capacity_;
+}
+
+
 }  // namespace internal
 }  // namespace v8
@@ -12,27 +12,20 @@
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/flags.h"
+#include "src/handles.h"
 #include "src/list.h"
+#include "src/utils.h"
 
 namespace v8 {
 namespace internal {
 
 class CompilationJob;
+class JSFunction;
 class SharedFunctionInfo;
 
 class OptimizingCompileDispatcher {
  public:
-  explicit OptimizingCompileDispatcher(Isolate* isolate)
-      : isolate_(isolate),
-        input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
-        input_queue_length_(0),
-        input_queue_shift_(0),
-        blocked_jobs_(0),
-        ref_count_(0),
-        recompilation_delay_(FLAG_concurrent_recompilation_delay) {
-    base::NoBarrier_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
-    input_queue_ = NewArray<CompilationJob*>(input_queue_capacity_);
-  }
+  explicit OptimizingCompileDispatcher(Isolate* isolate);
 
   ~OptimizingCompileDispatcher();
 
@@ -43,11 +36,21 @@ class OptimizingCompileDispatcher {
   void Unblock();
   void InstallOptimizedFunctions();
 
+  // Returns the finished OSR job for the given loop and removes it from the
+  // OSR buffer, or nullptr if there is none. The caller takes ownership.
+  CompilationJob* FindReadyOSRCandidate(Handle<JSFunction> function,
+                                        BailoutId osr_ast_id);
+  bool IsQueuedForOSR(Handle<JSFunction> function, BailoutId osr_ast_id);
+  bool IsQueuedForOSR(JSFunction* function);
+
   inline bool IsQueueAvailable() {
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
     return input_queue_length_ < input_queue_capacity_;
   }
 
+  // Whether the OSR buffer has room for another OSR job.
+  bool IsOSRBufferAvailable();
+
   static bool Enabled() { return FLAG_concurrent_recompilation; }
 
  private:
@@ -56,6 +59,8 @@ class OptimizingCompileDispatcher {
   enum ModeFlag { COMPILE, FLUSH };
 
   void FlushOutputQueue(bool restore_function_code);
+  void FlushOSRBuffer();
+  void AddToOSRBuffer(CompilationJob* job);
   void CompileNext(CompilationJob* job);
   CompilationJob* NextInput(bool check_if_flushing = false);
 
@@ -81,6 +86,14 @@ class OptimizingCompileDispatcher {
   // different threads.
   base::Mutex output_queue_mutex_;
 
+  // Cyclic buffer of OSR jobs. OSR jobs are not installed into their
+  // function, they stay here until the loop they were compiled for picks them
+  // up, or until they are evicted by newer jobs.
+  CompilationJob** osr_buffer_;
+  int osr_buffer_capacity_;
+  int osr_buffer_cursor_;
+  base::Mutex osr_buffer_mutex_;
+
   volatile base::AtomicWord mode_;
 
   int blocked_jobs_;
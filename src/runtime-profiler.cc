@@ -74,10 +74,13 @@ static void GetICCounts(SharedFunctionInfo* shared,
 
   // Harvest vector-ics as well
   TypeFeedbackVector* vector = shared->feedback_vector();
-  int with = 0, gen = 0;
-  vector->ComputeCounts(&with, &gen);
+  int with = 0, gen = 0, total = 0;
+  vector->ComputeCounts(&with, &gen, &total);
   *ic_with_type_info_count += with;
   *ic_generic_count += gen;
+  // Interpreted code has no TypeFeedbackInfo, so its vector slots are the
+  // only source of the total.
+  if (shared->code()->kind() != Code::FUNCTION) *ic_total_count += total;
 
   if (*ic_total_count > 0) {
     *type_info_percentage = 100 * *ic_with_type_info_count / *ic_total_count;
@@ -106,7 +109,9 @@ void RuntimeProfiler::Optimize(JSFunction* function, const char* reason) {
     PrintF("]\n");
   }
 
-  if (function->shared()->HasBytecodeArray()) {
+  // With --turbo-from-bytecode, interpreted functions tier up to TurboFan
+  // directly instead of going through baseline code.
+  if (function->shared()->HasBytecodeArray() && !FLAG_turbo_from_bytecode) {
     function->MarkForBaseline();
   } else {
     function->AttemptConcurrentOptimization();
@@ -149,6 +154,15 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
   SharedFunctionInfo* shared = function->shared();
   Code* shared_code = shared->code();
   if (shared_code->kind() != Code::FUNCTION) return;
+
+  // A concurrent OSR job is running for a loop in this function. Keep the back
+  // edges armed, so that the loop enters the OSR code once the job is done.
+  if (isolate_->concurrent_osr_enabled() &&
+      isolate_->optimizing_compile_dispatcher()->IsQueuedForOSR(function)) {
+    AttemptOnStackReplacement(function, Code::kMaxLoopNestingMarker);
+    return;
+  }
+
   if (function->IsInOptimizationQueue()) return;
 
   if (FLAG_always_osr) {
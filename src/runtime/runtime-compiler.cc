@@ -227,7 +227,38 @@ RUNTIME_FUNCTION(Runtime_CompileForOnStackReplacement) {
   DCHECK(!ast_id.IsNone());
 
   MaybeHandle<Code> maybe_result;
-  if (IsSuitableForOnStackReplacement(isolate, function)) {
+  if (isolate->concurrent_osr_enabled()) {
+    OptimizingCompileDispatcher* dispatcher =
+        isolate->optimizing_compile_dispatcher();
+    if (dispatcher->IsQueuedForOSR(function, ast_id)) {
+      CompilationJob* job = dispatcher->FindReadyOSRCandidate(function, ast_id);
+      if (job == NULL) {
+        // Still waiting for the concurrent OSR job, keep running the
+        // unoptimized code. The runtime profiler arms the back edges again.
+        BackEdgeTable::Revert(isolate, *caller_code);
+        return NULL;
+      }
+      if (FLAG_trace_osr) {
+        PrintF("[COSR - Installing: ");
+        function->PrintName();
+        PrintF(" at AST id %d]\n", ast_id.ToInt());
+      }
+      maybe_result = Compiler::FinalizeOSRCompilationJob(job);
+    } else if (IsSuitableForOnStackReplacement(isolate, function)) {
+      if (FLAG_trace_osr) {
+        PrintF("[COSR - Queueing: ");
+        function->PrintName();
+        PrintF(" at AST id %d]\n", ast_id.ToInt());
+      }
+      maybe_result = Compiler::GetOptimizedCodeForOSR(
+          function, ast_id, nullptr, Compiler::CONCURRENT);
+      if (dispatcher->IsQueuedForOSR(function, ast_id)) {
+        // The loop enters the code on a later iteration.
+        BackEdgeTable::Revert(isolate, *caller_code);
+        return NULL;
+      }
+    }
+  } else if (IsSuitableForOnStackReplacement(isolate, function)) {
     if (FLAG_trace_osr) {
       PrintF("[OSR - Compiling: ");
       function->PrintName();
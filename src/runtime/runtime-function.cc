@@ -89,11 +89,21 @@ RUNTIME_FUNCTION(Runtime_FunctionGetScriptSourcePosition) {
 
 
 RUNTIME_FUNCTION(Runtime_FunctionGetPositionForOffset) {
-  SealHandleScope shs(isolate);
-  DCHECK(args.length() == 2);
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 3);
 
-  CONVERT_ARG_CHECKED(AbstractCode, abstract_code, 0);
+  CONVERT_ARG_HANDLE_CHECKED(AbstractCode, abstract_code, 0);
   CONVERT_NUMBER_CHECKED(int, offset, Int32, args[1]);
+  CONVERT_ARG_HANDLE_CHECKED(Object, function, 2);
+  // Bytecode may have been generated without source positions.
+  if (abstract_code->IsBytecodeArray() && function->IsJSFunction()) {
+    Handle<SharedFunctionInfo> shared(
+        Handle<JSFunction>::cast(function)->shared(), isolate);
+    if (shared->HasBytecodeArray() &&
+        shared->bytecode_array() == abstract_code->GetBytecodeArray()) {
+      SharedFunctionInfo::EnsureSourcePositionsAvailable(shared);
+    }
+  }
   return Smi::FromInt(abstract_code->SourcePosition(offset));
 }
 
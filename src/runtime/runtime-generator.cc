@@ -7,11 +7,41 @@
 #include "src/arguments.h"
 #include "src/factory.h"
 #include "src/frames-inl.h"
+#include "src/interpreter/bytecode-array-iterator.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 
+namespace {
+
+// Suspended generators running bytecode store the id of their yield as the
+// continuation, which is loaded into the accumulator right before the
+// SuspendGenerator bytecode. Returns the offset of that bytecode, or -1.
+int FindSuspendOffset(Handle<BytecodeArray> bytecode_array, int yield_id) {
+  int accumulator = -1;
+  for (interpreter::BytecodeArrayIterator it(bytecode_array); !it.done();
+       it.Advance()) {
+    interpreter::Bytecode bytecode = it.current_bytecode();
+    if (bytecode == interpreter::Bytecode::kSuspendGenerator) {
+      if (accumulator == yield_id) return it.current_offset();
+    } else if (bytecode == interpreter::Bytecode::kLdaZero ||
+               bytecode == interpreter::Bytecode::kLdaZeroStar) {
+      accumulator = 0;
+    } else if (bytecode == interpreter::Bytecode::kLdaSmi) {
+      accumulator = it.GetImmediateOperand(0);
+    } else if (bytecode == interpreter::Bytecode::kLdaConstant) {
+      Handle<Object> constant = it.GetConstantForIndexOperand(0);
+      accumulator = constant->IsSmi() ? Smi::cast(*constant)->value() : -1;
+    } else if (interpreter::Bytecodes::WritesAccumulator(bytecode)) {
+      accumulator = -1;
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
 RUNTIME_FUNCTION(Runtime_CreateJSGeneratorObject) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 2);
@@ -193,6 +223,16 @@ RUNTIME_FUNCTION(Runtime_GeneratorGetSourcePosition) {
   CONVERT_ARG_HANDLE_CHECKED(JSGeneratorObject, generator, 0);
 
   if (generator->is_suspended()) {
+    Handle<SharedFunctionInfo> shared(generator->function()->shared(), isolate);
+    if (shared->HasBytecodeArray()) {
+      // Bytecode may have been generated without source positions.
+      SharedFunctionInfo::EnsureSourcePositionsAvailable(shared);
+      Handle<BytecodeArray> bytecode_array(shared->bytecode_array(), isolate);
+      int offset =
+          FindSuspendOffset(bytecode_array, generator->continuation());
+      RUNTIME_ASSERT(offset >= 0);
+      return Smi::FromInt(bytecode_array->SourcePosition(offset));
+    }
     Handle<Code> code(generator->function()->code(), isolate);
     int offset = generator->continuation();
     RUNTIME_ASSERT(0 <= offset && offset < code->instruction_size());
@@ -431,7 +431,7 @@ bool ComputeLocation(Isolate* isolate, MessageLocation* target) {
   JavaScriptFrameIterator it(isolate);
   if (!it.done()) {
     JavaScriptFrame* frame = it.frame();
-    JSFunction* fun = frame->function();
+    Handle<JSFunction> fun(frame->function(), isolate);
     Object* script = fun->shared()->script();
     if (script->IsScript() &&
         !(Script::cast(script)->source()->IsUndefined())) {
@@ -442,8 +442,9 @@ bool ComputeLocation(Isolate* isolate, MessageLocation* target) {
       List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
       it.frame()->Summarize(&frames);
       FrameSummary& summary = frames.last();
+      summary.EnsureSourcePositionsAvailable();
       int pos = summary.abstract_code()->SourcePosition(summary.code_offset());
-      *target = MessageLocation(casted_script, pos, pos + 1, handle(fun));
+      *target = MessageLocation(casted_script, pos, pos + 1, fun);
       return true;
     }
   }
@@ -8,6 +8,7 @@
 
 #include "src/arguments.h"
 #include "src/frames-inl.h"
+#include "src/ic/ic.h"
 #include "src/interpreter/bytecode-array-iterator.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/isolate-inl.h"
@@ -152,6 +153,23 @@ RUNTIME_FUNCTION(Runtime_InterpreterTraceBytecodeExit) {
   return isolate->heap()->undefined_value();
 }
 
+RUNTIME_FUNCTION(Runtime_InterpreterCallFeedbackMiss) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(3, args.length());
+  CONVERT_ARG_HANDLE_CHECKED(Object, function, 0);
+  CONVERT_ARG_HANDLE_CHECKED(TypeFeedbackVector, vector, 1);
+  CONVERT_SMI_ARG_CHECKED(index, 2);
+  CallICNexus nexus(vector, vector->ToSlot(index));
+  CallIC::UpdateFeedback(isolate, &nexus, function);
+
+  // Interpreted code has no TypeFeedbackInfo to checksum, so the feedback
+  // change restarts the profiler ticks of the calling function directly.
+  JavaScriptFrameIterator it(isolate);
+  if (!it.done()) it.frame()->function()->shared()->set_profiler_ticks(0);
+  isolate->runtime_profiler()->NotifyICChanged();
+  return isolate->heap()->undefined_value();
+}
+
 RUNTIME_FUNCTION(Runtime_InterpreterClearPendingMessage) {
   SealHandleScope shs(isolate);
   DCHECK_EQ(0, args.length());
@@ -4,16 +4,234 @@
 
 #include "src/snapshot/code-serializer.h"
 
+#include "src/address-map.h"
+#include "src/base/functional.h"
 #include "src/code-stubs.h"
+#include "src/deoptimizer.h"
+#include "src/external-reference-table.h"
 #include "src/log.h"
 #include "src/macro-assembler.h"
 #include "src/profiler/cpu-profiler.h"
 #include "src/snapshot/deserializer.h"
+#include "src/type-feedback-vector.h"
 #include "src/version.h"
 
 namespace v8 {
 namespace internal {
 
+namespace {
+
+// Checks whether {object}, referenced from optimized code for a function of
+// {script}, denotes the same value when the code is loaded by another process.
+bool IsContextIndependent(RootIndexMap* root_index_map, Script* script,
+                          Object* object) {
+  if (object->IsSmi()) return true;
+  HeapObject* heap_object = HeapObject::cast(object);
+  if (root_index_map->Lookup(heap_object) != RootIndexMap::kInvalidRootIndex) {
+    return true;
+  }
+  if (object->IsString() || object->IsHeapNumber() || object->IsScopeInfo()) {
+    return true;
+  }
+  if (object->IsSharedFunctionInfo()) {
+    return SharedFunctionInfo::cast(object)->script() == script;
+  }
+  return false;
+}
+
+// Optimized code can be reused by another process if it was generated with
+// full reloc info, has no dependencies on objects in this heap, and only
+// refers to builtins, cacheable stubs and context-independent objects.
+bool IsSerializableOptimizedCode(Isolate* isolate,
+                                 RootIndexMap* root_index_map, Script* script,
+                                 Code* code) {
+  DCHECK_EQ(Code::OPTIMIZED_FUNCTION, code->kind());
+  if (!code->is_turbofanned() || code->marked_for_deoptimization()) {
+    return false;
+  }
+  if (!code->has_reloc_info_for_serialization()) return false;
+
+  int mode_mask = RelocInfo::kCodeTargetMask |
+                  RelocInfo::ModeMask(RelocInfo::EMBEDDED_OBJECT) |
+                  RelocInfo::ModeMask(RelocInfo::RUNTIME_ENTRY);
+  for (RelocIterator it(code, mode_mask); !it.done(); it.next()) {
+    RelocInfo* rinfo = it.rinfo();
+    RelocInfo::Mode mode = rinfo->rmode();
+    if (mode == RelocInfo::EMBEDDED_OBJECT) {
+      Object* target = rinfo->target_object();
+      if (target == code) continue;
+      if (!IsContextIndependent(root_index_map, script, target)) return false;
+    } else if (RelocInfo::IsCodeTarget(mode)) {
+      Code* target = Code::GetCodeFromTargetAddress(rinfo->target_address());
+      if (target->kind() == Code::BUILTIN) continue;
+      if (target->kind() != Code::STUB && !target->is_inline_cache_stub()) {
+        return false;
+      }
+      if (CodeStub::MajorKeyFromKey(target->stub_key()) == CodeStub::NoCache) {
+        return false;
+      }
+    } else {
+      // Only the first lazy deoptimization entries are known to the external
+      // reference table.
+      DCHECK(RelocInfo::IsRuntimeEntry(mode));
+      int id = Deoptimizer::GetDeoptimizationId(
+          isolate, rinfo->target_address(), Deoptimizer::LAZY);
+      if (id == Deoptimizer::kNotDeoptimizationEntry ||
+          id >= ExternalReferenceTable::kDeoptTableSerializeEntryCount) {
+        return false;
+      }
+    }
+  }
+
+  if (code->deoptimization_data()->length() == 0) return true;
+  DeoptimizationInputData* data =
+      DeoptimizationInputData::cast(code->deoptimization_data());
+  FixedArray* literals = data->LiteralArray();
+  for (int i = 0; i < literals->length(); i++) {
+    if (!IsContextIndependent(root_index_map, script, literals->get(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Replaces the optimized code maps of all functions of a script while the
+// script is serialized. Context-specific entries are never part of the code
+// cache. With --serialize-optimized-code the context-independent entry is
+// kept if its code can be reused by another process.
+class OptimizedCodeMapScope {
+ public:
+  OptimizedCodeMapScope(Isolate* isolate, Handle<SharedFunctionInfo> info) {
+    if (!info->script()->IsScript()) return;
+    Handle<Script> script(Script::cast(info->script()), isolate);
+    List<Handle<SharedFunctionInfo> > candidates;
+    {
+      WeakFixedArray::Iterator iterator(script->shared_function_infos());
+      SharedFunctionInfo* shared;
+      while ((shared = iterator.Next<SharedFunctionInfo>())) {
+        if (shared->OptimizedCodeMapIsCleared()) continue;
+        candidates.Add(handle(shared, isolate));
+      }
+    }
+    if (candidates.is_empty()) return;
+
+    // Allocate all replacement maps first, since a GC may flush code maps.
+    RootIndexMap root_index_map(isolate);
+    List<Handle<FixedArray> > replacements;
+    for (int i = 0; i < candidates.length(); i++) {
+      Handle<FixedArray> replacement =
+          isolate->factory()->cleared_optimized_code_map();
+      Handle<SharedFunctionInfo> shared = candidates[i];
+      if (FLAG_serialize_optimized_code &&
+          !shared->OptimizedCodeMapIsCleared()) {
+        WeakCell* cell = WeakCell::cast(shared->optimized_code_map()->get(
+            SharedFunctionInfo::kSharedCodeIndex));
+        if (!cell->cleared() &&
+            IsSerializableOptimizedCode(isolate, &root_index_map, *script,
+                                        Code::cast(cell->value()))) {
+          Handle<Code> code(Code::cast(cell->value()), isolate);
+          Handle<WeakCell> code_cell = isolate->factory()->NewWeakCell(code);
+          replacement = isolate->factory()->NewFixedArray(
+              SharedFunctionInfo::kEntriesStart, TENURED);
+          replacement->set(SharedFunctionInfo::kSharedCodeIndex, *code_cell);
+          if (FLAG_trace_serializer) {
+            PrintF(" Keeping optimized code for ");
+            shared->ShortPrint();
+            PrintF("\n");
+          }
+        }
+      }
+      replacements.Add(replacement);
+    }
+
+    for (int i = 0; i < candidates.length(); i++) {
+      Handle<SharedFunctionInfo> shared = candidates[i];
+      shared_.Add(shared);
+      code_maps_.Add(handle(shared->optimized_code_map(), isolate));
+      shared->set_optimized_code_map(*replacements[i]);
+    }
+  }
+
+  ~OptimizedCodeMapScope() {
+    for (int i = 0; i < shared_.length(); i++) {
+      shared_[i]->set_optimized_code_map(*code_maps_[i]);
+    }
+  }
+
+ private:
+  List<Handle<SharedFunctionInfo> > shared_;
+  List<Handle<FixedArray> > code_maps_;
+  DISALLOW_COPY_AND_ASSIGN(OptimizedCodeMapScope);
+};
+
+// Replaces the type feedback vectors of all functions of a script with
+// uninitialized ones while the script is serialized. Once the script ran,
+// the vectors hold weak cells to maps and closures, which are specific to
+// this isolate and cannot be part of the code cache.
+class FeedbackVectorScope {
+ public:
+  FeedbackVectorScope(Isolate* isolate, Handle<SharedFunctionInfo> info) {
+    if (!info->script()->IsScript()) return;
+    List<Handle<SharedFunctionInfo> > candidates;
+    {
+      WeakFixedArray::Iterator iterator(
+          Script::cast(info->script())->shared_function_infos());
+      SharedFunctionInfo* shared;
+      while ((shared = iterator.Next<SharedFunctionInfo>())) {
+        if (shared->feedback_vector()->is_empty()) continue;
+        candidates.Add(handle(shared, isolate));
+      }
+    }
+
+    // Allocate all replacement vectors first, since a GC may clear vectors.
+    List<Handle<TypeFeedbackVector> > replacements;
+    for (int i = 0; i < candidates.length(); i++) {
+      Handle<TypeFeedbackMetadata> metadata(
+          candidates[i]->feedback_vector()->metadata(), isolate);
+      replacements.Add(TypeFeedbackVector::New(isolate, metadata));
+    }
+
+    for (int i = 0; i < candidates.length(); i++) {
+      Handle<SharedFunctionInfo> shared = candidates[i];
+      shared_.Add(shared);
+      vectors_.Add(handle(shared->feedback_vector(), isolate));
+      shared->set_feedback_vector(*replacements[i]);
+    }
+  }
+
+  ~FeedbackVectorScope() {
+    for (int i = 0; i < shared_.length(); i++) {
+      shared_[i]->set_feedback_vector(*vectors_[i]);
+    }
+  }
+
+ private:
+  List<Handle<SharedFunctionInfo> > shared_;
+  List<Handle<TypeFeedbackVector> > vectors_;
+  DISALLOW_COPY_AND_ASSIGN(FeedbackVectorScope);
+};
+
+// Links deserialized optimized code into the code list of the current native
+// context, so that it is found when code gets deoptimized.
+void LinkDeserializedOptimizedCode(Isolate* isolate,
+                                   Handle<SharedFunctionInfo> info) {
+  if (!info->script()->IsScript()) return;
+  DisallowHeapAllocation no_gc;
+  Context* native_context = isolate->context()->native_context();
+  WeakFixedArray::Iterator iterator(
+      Script::cast(info->script())->shared_function_infos());
+  SharedFunctionInfo* shared;
+  while ((shared = iterator.Next<SharedFunctionInfo>())) {
+    if (shared->OptimizedCodeMapIsCleared()) continue;
+    WeakCell* cell = WeakCell::cast(shared->optimized_code_map()->get(
+        SharedFunctionInfo::kSharedCodeIndex));
+    if (cell->cleared()) continue;
+    native_context->AddOptimizedCode(Code::cast(cell->value()));
+  }
+}
+
+}  // namespace
+
 ScriptData* CodeSerializer::Serialize(Isolate* isolate,
                                       Handle<SharedFunctionInfo> info,
                                       Handle<String> source) {
@@ -26,9 +244,17 @@ ScriptData* CodeSerializer::Serialize(Isolate* isolate,
     PrintF("]\n");
   }
 
+  // Functions that already ran may have optimized code and type feedback.
+  // Only code that does not depend on the native context can be part of the
+  // code cache, and feedback never is.
+  HandleScope scope(isolate);
+  OptimizedCodeMapScope optimized_code_map_scope(isolate, info);
+  FeedbackVectorScope feedback_vector_scope(isolate, info);
+
   // Serialize code object.
   SnapshotByteSink sink(info->code()->CodeSize() * 2);
-  CodeSerializer cs(isolate, &sink, *source);
+  CodeSerializer cs(isolate, &sink, *source,
+                    SerializedCodeData::SourceHash(*source));
   DisallowHeapAllocation no_gc;
   Object** location = Handle<Object>::cast(info).location();
   cs.VisitPointer(location);
@@ -47,6 +273,35 @@ ScriptData* CodeSerializer::Serialize(Isolate* isolate,
   return script_data;
 }
 
+ScriptData* CodeSerializer::SerializeWasmModule(
+    Isolate* isolate, Handle<FixedArray> compiled_module,
+    Handle<FixedArray> attached_objects, Vector<const byte> wire_bytes) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  SnapshotByteSink sink(wire_bytes.length() * 4);
+  CodeSerializer cs(isolate, &sink, nullptr,
+                    SerializedCodeData::SourceHash(wire_bytes));
+  cs.set_attached_objects(attached_objects);
+  DisallowHeapAllocation no_gc;
+  Object** location = Handle<Object>::cast(compiled_module).location();
+  cs.VisitPointer(location);
+  cs.SerializeDeferredObjects();
+  cs.Pad();
+
+  SerializedCodeData data(sink.data(), cs);
+  ScriptData* script_data = data.GetScriptData();
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = script_data->length();
+    PrintF("[Serializing wasm module to %d bytes took %0.3f ms]\n", length,
+           ms);
+  }
+
+  return script_data;
+}
+
 void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
                                      WhereToPoint where_to_point, int skip) {
   int root_index = root_index_map_.Lookup(obj);
@@ -59,10 +314,18 @@ void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
 
   FlushSkip(skip);
 
+  if (SerializeAttachedObject(obj, how_to_code, where_to_point)) return;
+
   if (obj->IsCode()) {
     Code* code_object = Code::cast(obj);
     switch (code_object->kind()) {
-      case Code::OPTIMIZED_FUNCTION:  // No optimized code compiled yet.
+      case Code::OPTIMIZED_FUNCTION:
+        // Only context-independent code is left in optimized code maps, see
+        // OptimizedCodeMapScope.
+        CHECK(FLAG_serialize_optimized_code);
+        DCHECK(code_object->has_reloc_info_for_serialization());
+        SerializeGeneric(code_object, how_to_code, where_to_point);
+        return;
       case Code::HANDLER:             // No handlers patched in yet.
       case Code::REGEXP:              // No regexp literals initialized yet.
       case Code::NUMBER_OF_KINDS:     // Pseudo enum value.
@@ -79,12 +342,22 @@ void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
         SerializeCodeStub(code_object->stub_key(), how_to_code, where_to_point);
         return;
       case Code::FUNCTION:
-        DCHECK(code_object->has_reloc_info_for_serialization());
+        // Functions that were compiled lazily after the script was compiled
+        // for the code cache lack the reloc info. They are compiled again.
+        if (!code_object->has_reloc_info_for_serialization()) {
+          SerializeBuiltin(Builtins::kCompileLazy, how_to_code,
+                           where_to_point);
+          return;
+        }
         SerializeGeneric(code_object, how_to_code, where_to_point);
         return;
       case Code::WASM_FUNCTION:
-      case Code::WASM_TO_JS_FUNCTION:
-      case Code::JS_TO_WASM_FUNCTION:
+        // Only reachable when serializing a compiled wasm module.
+        DCHECK(!attached_objects_.is_null());
+        SerializeGeneric(code_object, how_to_code, where_to_point);
+        return;
+      case Code::WASM_TO_JS_FUNCTION:  // Attached to the instance.
+      case Code::JS_TO_WASM_FUNCTION:  // Not referenced from wasm code.
         UNREACHABLE();
     }
     UNREACHABLE();
@@ -136,7 +409,7 @@ void CodeSerializer::SerializeCodeStub(uint32_t stub_key, HowToCode how_to_code,
   DCHECK(CodeStub::MajorKeyFromKey(stub_key) != CodeStub::NoCache);
   DCHECK(!CodeStub::GetCode(isolate(), stub_key).is_null());
 
-  int index = AddCodeStubKey(stub_key) + kCodeStubsBaseIndex;
+  int index = AddCodeStubKey(stub_key) + code_stubs_base_index_;
 
   if (FLAG_trace_serializer) {
     PrintF(" Encoding code stub %s as %d\n",
@@ -147,6 +420,24 @@ void CodeSerializer::SerializeCodeStub(uint32_t stub_key, HowToCode how_to_code,
   sink_->PutInt(index, "CodeStub key");
 }
 
+bool CodeSerializer::SerializeAttachedObject(HeapObject* heap_object,
+                                             HowToCode how_to_code,
+                                             WhereToPoint where_to_point) {
+  if (attached_objects_.is_null()) return false;
+  for (int i = 0; i < attached_objects_->length(); i++) {
+    if (attached_objects_->get(i) != heap_object) continue;
+    int index = i + kCodeStubsBaseIndex;
+    if (FLAG_trace_serializer) {
+      PrintF(" Encoding attached object as %d\n", index);
+    }
+    sink_->Put(kAttachedReference + how_to_code + where_to_point,
+               "AttachedObject");
+    sink_->PutInt(index, "AttachedObject index");
+    return true;
+  }
+  return false;
+}
+
 int CodeSerializer::AddCodeStubKey(uint32_t stub_key) {
   // TODO(yangguo) Maybe we need a hash table for a faster lookup than O(n^2).
   int index = 0;
@@ -165,8 +456,8 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
 
   HandleScope scope(isolate);
 
-  base::SmartPointer<SerializedCodeData> scd(
-      SerializedCodeData::FromCachedData(isolate, cached_data, *source));
+  base::SmartPointer<SerializedCodeData> scd(SerializedCodeData::FromCachedData(
+      isolate, cached_data, SerializedCodeData::SourceHash(*source)));
   if (scd.is_empty()) {
     if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
     DCHECK(cached_data->rejected());
@@ -187,12 +478,13 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
   deserializer.SetAttachedObjects(attached_objects);
 
   // Deserialize.
-  Handle<SharedFunctionInfo> result;
-  if (!deserializer.DeserializeCode(isolate).ToHandle(&result)) {
+  Handle<HeapObject> root;
+  if (!deserializer.DeserializeObject(isolate).ToHandle(&root)) {
     // Deserializing may fail if the reservations cannot be fulfilled.
     if (FLAG_profile_deserialization) PrintF("[Deserializing failed]\n");
     return MaybeHandle<SharedFunctionInfo>();
   }
+  Handle<SharedFunctionInfo> result = Handle<SharedFunctionInfo>::cast(root);
 
   if (FLAG_profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
@@ -200,6 +492,9 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     PrintF("[Deserializing from %d bytes took %0.3f ms]\n", length, ms);
   }
   result->set_deserialized(true);
+  if (FLAG_serialize_optimized_code) {
+    LinkDeserializedOptimizedCode(isolate, result);
+  }
 
   if (isolate->logger()->is_logging_code_events() ||
       isolate->cpu_profiler()->is_profiling()) {
@@ -214,6 +509,56 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
   return scope.CloseAndEscape(result);
 }
 
+MaybeHandle<FixedArray> CodeSerializer::DeserializeWasmModule(
+    Isolate* isolate, ScriptData* cached_data,
+    Handle<FixedArray> attached_objects, Vector<const byte> wire_bytes) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  HandleScope scope(isolate);
+
+  base::SmartPointer<SerializedCodeData> scd(SerializedCodeData::FromCachedData(
+      isolate, cached_data, SerializedCodeData::SourceHash(wire_bytes)));
+  if (scd.is_empty()) {
+    if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
+    DCHECK(cached_data->rejected());
+    return MaybeHandle<FixedArray>();
+  }
+
+  // Prepare the list of attached objects: there is no source object, the
+  // objects of the new instance come first, then the code stubs.
+  Vector<const uint32_t> code_stub_keys = scd->CodeStubKeys();
+  int code_stubs_base_index = kCodeStubsBaseIndex + attached_objects->length();
+  Vector<Handle<Object> > attached = Vector<Handle<Object> >::New(
+      code_stub_keys.length() + code_stubs_base_index);
+  attached[kSourceObjectIndex] = isolate->factory()->undefined_value();
+  for (int i = 0; i < attached_objects->length(); i++) {
+    attached[i + kCodeStubsBaseIndex] =
+        handle(attached_objects->get(i), isolate);
+  }
+  for (int i = 0; i < code_stub_keys.length(); i++) {
+    attached[i + code_stubs_base_index] =
+        CodeStub::GetCode(isolate, code_stub_keys[i]).ToHandleChecked();
+  }
+
+  Deserializer deserializer(scd.get());
+  deserializer.SetAttachedObjects(attached);
+
+  Handle<HeapObject> root;
+  if (!deserializer.DeserializeObject(isolate).ToHandle(&root)) {
+    if (FLAG_profile_deserialization) PrintF("[Deserializing failed]\n");
+    return MaybeHandle<FixedArray>();
+  }
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = cached_data->length();
+    PrintF("[Deserializing wasm module from %d bytes took %0.3f ms]\n",
+           length, ms);
+  }
+  return scope.CloseAndEscape(Handle<FixedArray>::cast(root));
+}
+
 class Checksum {
  public:
   explicit Checksum(Vector<const byte> payload) {
@@ -275,7 +620,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>& payload,
   // Set header values.
   SetMagicNumber(cs.isolate());
   SetHeaderValue(kVersionHashOffset, Version::Hash());
-  SetHeaderValue(kSourceHashOffset, SourceHash(cs.source()));
+  SetHeaderValue(kSourceHashOffset, cs.source_hash());
   SetHeaderValue(kCpuFeaturesOffset,
                  static_cast<uint32_t>(CpuFeatures::SupportedFeatures()));
   SetHeaderValue(kFlagHashOffset, FlagList::Hash());
@@ -303,7 +648,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>& payload,
 }
 
 SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
-    Isolate* isolate, String* source) const {
+    Isolate* isolate, uint32_t expected_source_hash) const {
   uint32_t magic_number = GetMagicNumber();
   if (magic_number != ComputeMagicNumber(isolate)) return MAGIC_NUMBER_MISMATCH;
   uint32_t version_hash = GetHeaderValue(kVersionHashOffset);
@@ -313,7 +658,7 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   uint32_t c1 = GetHeaderValue(kChecksum1Offset);
   uint32_t c2 = GetHeaderValue(kChecksum2Offset);
   if (version_hash != Version::Hash()) return VERSION_MISMATCH;
-  if (source_hash != SourceHash(source)) return SOURCE_MISMATCH;
+  if (source_hash != expected_source_hash) return SOURCE_MISMATCH;
   if (cpu_features != static_cast<uint32_t>(CpuFeatures::SupportedFeatures())) {
     return CPU_FEATURES_MISMATCH;
   }
@@ -322,10 +667,18 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   return CHECK_SUCCESS;
 }
 
-uint32_t SerializedCodeData::SourceHash(String* source) const {
+uint32_t SerializedCodeData::SourceHash(String* source) {
   return source->length();
 }
 
+uint32_t SerializedCodeData::SourceHash(Vector<const byte> wire_bytes) {
+  // Unlike JavaScript source, wasm wire bytes are always available in full,
+  // so the hash covers the content and not only the length.
+  size_t hash = base::hash_range(wire_bytes.begin(), wire_bytes.end());
+  return static_cast<uint32_t>(
+      base::hash_combine(static_cast<size_t>(wire_bytes.length()), hash));
+}
+
 // Return ScriptData object and relinquish ownership over it to the caller.
 ScriptData* SerializedCodeData::GetScriptData() {
   DCHECK(owns_data_);
@@ -365,15 +718,14 @@ Vector<const uint32_t> SerializedCodeData::CodeStubKeys() const {
 SerializedCodeData::SerializedCodeData(ScriptData* data)
     : SerializedData(const_cast<byte*>(data->data()), data->length()) {}
 
-SerializedCodeData* SerializedCodeData::FromCachedData(Isolate* isolate,
-                                                       ScriptData* cached_data,
-                                                       String* source) {
+SerializedCodeData* SerializedCodeData::FromCachedData(
+    Isolate* isolate, ScriptData* cached_data, uint32_t expected_source_hash) {
   DisallowHeapAllocation no_gc;
   SerializedCodeData* scd = new SerializedCodeData(cached_data);
-  SanityCheckResult r = scd->SanityCheck(isolate, source);
+  SanityCheckResult r = scd->SanityCheck(isolate, expected_source_hash);
   if (r == CHECK_SUCCESS) return scd;
   cached_data->Reject();
-  source->GetIsolate()->counters()->code_cache_reject_reason()->AddSample(r);
+  isolate->counters()->code_cache_reject_reason()->AddSample(r);
   delete scd;
   return NULL;
 }
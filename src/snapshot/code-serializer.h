@@ -20,22 +20,38 @@ class CodeSerializer : public Serializer {
   MUST_USE_RESULT static MaybeHandle<SharedFunctionInfo> Deserialize(
       Isolate* isolate, ScriptData* cached_data, Handle<String> source);
 
+  // Serializes the code of a compiled wasm module, see wasm-module.h for the
+  // layout of {compiled_module}. The objects in {attached_objects} belong to
+  // the instance the code was compiled for (native context, function table,
+  // import wrappers, ...). They are not serialized but replaced by references
+  // into the list of attached objects passed to DeserializeWasmModule.
+  static ScriptData* SerializeWasmModule(Isolate* isolate,
+                                         Handle<FixedArray> compiled_module,
+                                         Handle<FixedArray> attached_objects,
+                                         Vector<const byte> wire_bytes);
+
+  MUST_USE_RESULT static MaybeHandle<FixedArray> DeserializeWasmModule(
+      Isolate* isolate, ScriptData* cached_data,
+      Handle<FixedArray> attached_objects, Vector<const byte> wire_bytes);
+
   static const int kSourceObjectIndex = 0;
   STATIC_ASSERT(kSourceObjectReference == kSourceObjectIndex);
 
+  // Objects attached to a wasm module start at this index, code stubs follow
+  // the attached objects.
   static const int kCodeStubsBaseIndex = 1;
 
-  String* source() const {
-    DCHECK(!AllowHeapAllocation::IsAllowed());
-    return source_;
-  }
+  uint32_t source_hash() const { return source_hash_; }
 
   const List<uint32_t>* stub_keys() const { return &stub_keys_; }
 
  private:
-  CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, String* source)
-      : Serializer(isolate, sink), source_(source) {
-    back_reference_map_.AddSourceString(source);
+  CodeSerializer(Isolate* isolate, SnapshotByteSink* sink, String* source,
+                 uint32_t source_hash)
+      : Serializer(isolate, sink),
+        source_hash_(source_hash),
+        code_stubs_base_index_(kCodeStubsBaseIndex) {
+    if (source != nullptr) back_reference_map_.AddSourceString(source);
   }
 
   ~CodeSerializer() override { OutputStatistics("CodeSerializer"); }
@@ -49,10 +65,19 @@ class CodeSerializer : public Serializer {
                          WhereToPoint where_to_point);
   void SerializeGeneric(HeapObject* heap_object, HowToCode how_to_code,
                         WhereToPoint where_to_point);
+  bool SerializeAttachedObject(HeapObject* heap_object, HowToCode how_to_code,
+                               WhereToPoint where_to_point);
   int AddCodeStubKey(uint32_t stub_key);
 
+  void set_attached_objects(Handle<FixedArray> attached_objects) {
+    attached_objects_ = attached_objects;
+    code_stubs_base_index_ = kCodeStubsBaseIndex + attached_objects->length();
+  }
+
   DisallowHeapAllocation no_gc_;
-  String* source_;
+  uint32_t source_hash_;
+  Handle<FixedArray> attached_objects_;
+  int code_stubs_base_index_;
   List<uint32_t> stub_keys_;
   DISALLOW_COPY_AND_ASSIGN(CodeSerializer);
 };
@@ -63,7 +88,10 @@ class SerializedCodeData : public SerializedData {
   // Used when consuming.
   static SerializedCodeData* FromCachedData(Isolate* isolate,
                                             ScriptData* cached_data,
-                                            String* source);
+                                            uint32_t expected_source_hash);
+
+  static uint32_t SourceHash(String* source);
+  static uint32_t SourceHash(Vector<const byte> wire_bytes);
 
   // Used when producing.
   SerializedCodeData(const List<byte>& payload, const CodeSerializer& cs);
@@ -89,14 +117,13 @@ class SerializedCodeData : public SerializedData {
     CHECKSUM_MISMATCH = 6
   };
 
-  SanityCheckResult SanityCheck(Isolate* isolate, String* source) const;
-
-  uint32_t SourceHash(String* source) const;
+  SanityCheckResult SanityCheck(Isolate* isolate,
+                                uint32_t expected_source_hash) const;
 
   // The data header consists of uint32_t-sized entries:
   // [0] magic number and external reference count
   // [1] version hash
-  // [2] source hash
+  // [2] source hash (hash of the wire bytes for wasm modules)
   // [3] cpu features
   // [4] flag hash
   // [5] number of code stub keys
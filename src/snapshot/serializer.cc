@@ -426,6 +426,13 @@ class UnlinkWeakNextScope {
       next_ = AllocationSite::cast(object)->weak_next();
       AllocationSite::cast(object)->set_weak_next(
           object->GetHeap()->undefined_value());
+    } else if (object->IsCode() &&
+               Code::cast(object)->kind() == Code::OPTIMIZED_FUNCTION) {
+      // Optimized code is linked into the code list of a native context.
+      object_ = object;
+      next_ = Code::cast(object)->next_code_link();
+      Code::cast(object)->set_next_code_link(
+          object->GetHeap()->undefined_value());
     }
   }
 
@@ -433,6 +440,9 @@ class UnlinkWeakNextScope {
     if (object_ != nullptr) {
       if (object_->IsWeakCell()) {
         WeakCell::cast(object_)->set_next(next_, UPDATE_WEAK_WRITE_BARRIER);
+      } else if (object_->IsCode()) {
+        Code::cast(object_)->set_next_code_link(next_,
+                                                UPDATE_WEAK_WRITE_BARRIER);
       } else {
         AllocationSite::cast(object_)->set_weak_next(next_,
                                                      UPDATE_WEAK_WRITE_BARRIER);
@@ -106,18 +106,21 @@ void TypeFeedbackVector::Set(FeedbackVectorSlot slot, Object* value,
 }
 
 
-void TypeFeedbackVector::ComputeCounts(int* with_type_info, int* generic) {
+void TypeFeedbackVector::ComputeCounts(int* with_type_info, int* generic,
+                                       int* vector_ic_count) {
   Object* uninitialized_sentinel =
       TypeFeedbackVector::RawUninitializedSentinel(GetIsolate());
   Object* megamorphic_sentinel =
       *TypeFeedbackVector::MegamorphicSentinel(GetIsolate());
   int with = 0;
   int gen = 0;
+  int total = 0;
   TypeFeedbackMetadataIterator iter(metadata());
   while (iter.HasNext()) {
     FeedbackVectorSlot slot = iter.Next();
     FeedbackVectorSlotKind kind = iter.kind();
 
+    if (kind != FeedbackVectorSlotKind::GENERAL) total++;
     Object* obj = Get(slot);
     if (obj != uninitialized_sentinel &&
         kind != FeedbackVectorSlotKind::GENERAL) {
@@ -131,6 +134,7 @@ void TypeFeedbackVector::ComputeCounts(int* with_type_info, int* generic) {
 
   *with_type_info = with;
   *generic = gen;
+  *vector_ic_count = total;
 }
 
 Handle<Symbol> TypeFeedbackVector::UninitializedSentinel(Isolate* isolate) {
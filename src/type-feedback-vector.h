@@ -184,7 +184,8 @@ class TypeFeedbackVector : public FixedArray {
   static const int kMetadataIndex = 0;
   static const int kReservedIndexCount = 1;
 
-  inline void ComputeCounts(int* with_type_info, int* generic);
+  inline void ComputeCounts(int* with_type_info, int* generic,
+                            int* vector_ic_count);
 
   inline bool is_empty() const;
 
@@ -490,12 +490,16 @@
         'compiler/access-info.h',
         'compiler/all-nodes.cc',
         'compiler/all-nodes.h',
+        'compiler/allocation-sinking.cc',
+        'compiler/allocation-sinking.h',
         'compiler/ast-graph-builder.cc',
         'compiler/ast-graph-builder.h',
         'compiler/ast-loop-assignment-analyzer.cc',
         'compiler/ast-loop-assignment-analyzer.h',
         'compiler/basic-block-instrumentor.cc',
         'compiler/basic-block-instrumentor.h',
+        'compiler/bounds-check-elimination.cc',
+        'compiler/bounds-check-elimination.h',
         'compiler/branch-elimination.cc',
         'compiler/branch-elimination.h',
         'compiler/bytecode-branch-analysis.cc',
@@ -551,6 +555,8 @@
         'compiler/graph.h',
         'compiler/greedy-allocator.cc',
         'compiler/greedy-allocator.h',
+        'compiler/induction-variable-analysis.cc',
+        'compiler/induction-variable-analysis.h',
         'compiler/instruction-codes.h',
         'compiler/instruction-selector-impl.h',
         'compiler/instruction-selector.cc',
@@ -601,6 +607,8 @@
         'compiler/load-elimination.h',
         'compiler/loop-analysis.cc',
         'compiler/loop-analysis.h',
+        'compiler/loop-invariant-code-motion.cc',
+        'compiler/loop-invariant-code-motion.h',
         'compiler/loop-peeling.cc',
         'compiler/loop-peeling.h',
         'compiler/machine-operator-reducer.cc',
@@ -654,6 +662,8 @@
         'compiler/simplified-operator-reducer.h',
         'compiler/simplified-operator.cc',
         'compiler/simplified-operator.h',
+        'compiler/slp-vectorizer.cc',
+        'compiler/slp-vectorizer.h',
         'compiler/source-position.cc',
         'compiler/source-position.h',
         'compiler/state-values-utils.cc',
@@ -831,6 +841,8 @@
         'heap-symbols.h',
         'heap/array-buffer-tracker.cc',
         'heap/array-buffer-tracker.h',
+        'heap/external-resource-releaser.cc',
+        'heap/external-resource-releaser.h',
         'heap/memory-reducer.cc',
         'heap/memory-reducer.h',
         'heap/gc-idle-time-handler.cc',
@@ -896,6 +908,8 @@
         'interpreter/bytecode-array-iterator.h',
         'interpreter/bytecode-register-allocator.cc',
         'interpreter/bytecode-register-allocator.h',
+        'interpreter/bytecode-register-optimizer.cc',
+        'interpreter/bytecode-register-optimizer.h',
         'interpreter/bytecode-generator.cc',
         'interpreter/bytecode-generator.h',
         'interpreter/bytecode-traits.h',
@@ -1901,10 +1915,18 @@
       ],
       'sources': [
         '../include/libplatform/libplatform.h',
+        '../include/libplatform/v8-tracing.h',
         'libplatform/default-platform.cc',
         'libplatform/default-platform.h',
         'libplatform/task-queue.cc',
         'libplatform/task-queue.h',
+        'libplatform/tracing/trace-buffer.cc',
+        'libplatform/tracing/trace-buffer.h',
+        'libplatform/tracing/trace-config.cc',
+        'libplatform/tracing/trace-object.cc',
+        'libplatform/tracing/trace-writer.cc',
+        'libplatform/tracing/trace-writer.h',
+        'libplatform/tracing/tracing-controller.cc',
         'libplatform/worker-thread.cc',
         'libplatform/worker-thread.h',
       ],
@@ -9,6 +9,7 @@
 #include "src/v8.h"
 
 #include "src/simulator.h"
+#include "src/snapshot/code-serializer.h"
 
 #include "src/wasm/ast-decoder.h"
 #include "src/wasm/module-decoder.h"
@@ -397,25 +398,66 @@ static MaybeHandle<JSFunction> LookupFunction(
 }
 
 namespace {
+// The compilation units of a module. The main thread creates the units one
+// after the other, and the background tasks pick up each unit as soon as it
+// has been created, so that compilation overlaps with the setup of the
+// remaining units. Creating a unit allocates on the heap, so it cannot move
+// to the background threads.
+class CompilationUnitQueue {
+ public:
+  CompilationUnitQueue(size_t first_unit, size_t num_units)
+      : units_(num_units, nullptr),
+        next_unit_(first_unit),
+        num_created_units_(first_unit) {}
+
+  // Adds the unit of the next function. {unit} is null for functions that are
+  // not compiled. Only called by the main thread.
+  void Add(compiler::WasmCompilationUnit* unit) {
+    size_t index = num_created_units_.Value();
+    DCHECK_LT(index, units_.size());
+    units_[index] = unit;
+    // Publishes the unit to the background tasks.
+    num_created_units_.SetValue(index + 1);
+  }
+
+  // Takes the next unit and stores it in {unit}. Returns false if all units
+  // that have been created so far have been taken. Never waits for the main
+  // thread.
+  bool Next(compiler::WasmCompilationUnit** unit) {
+    for (;;) {
+      size_t index = next_unit_.Value();
+      if (index >= num_created_units_.Value()) return false;
+      if (next_unit_.TrySetValue(index, index + 1)) {
+        *unit = units_[index];
+        return true;
+      }
+    }
+  }
+
+ private:
+  std::vector<compiler::WasmCompilationUnit*> units_;
+  base::AtomicValue<size_t> next_unit_;
+  base::AtomicValue<size_t> num_created_units_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationUnitQueue);
+};
+
 // Fetches the compilation unit of a wasm function and executes its parallel
 // phase.
 bool FetchAndExecuteCompilationUnit(
-    Isolate* isolate,
-    std::vector<compiler::WasmCompilationUnit*>* compilation_units,
+    CompilationUnitQueue* compilation_units,
     std::queue<compiler::WasmCompilationUnit*>* executed_units,
-    base::Mutex* result_mutex, base::AtomicNumber<size_t>* next_unit) {
+    base::Mutex* result_mutex) {
   DisallowHeapAllocation no_allocation;
   DisallowHandleAllocation no_handles;
   DisallowHandleDereference no_deref;
   DisallowCodeDependencyChange no_dependency_change;
 
-  // - 1 because AtomicIntrement returns the value after the atomic increment.
-  size_t index = next_unit->Increment(1) - 1;
-  if (index >= compilation_units->size()) {
+  compiler::WasmCompilationUnit* unit = nullptr;
+  if (!compilation_units->Next(&unit)) {
     return false;
   }
 
-  compiler::WasmCompilationUnit* unit = compilation_units->at(index);
   if (unit != nullptr) {
     compiler::ExecuteCompilation(unit);
     {
@@ -426,38 +468,81 @@ bool FetchAndExecuteCompilationUnit(
   return true;
 }
 
-class WasmCompilationTask : public CancelableTask {
+// The background tasks that execute compilation units. A task exits as soon
+// as it runs out of created units instead of waiting for the main thread, and
+// the main thread starts a new task whenever it adds a unit while fewer than
+// {max_tasks} tasks are running.
+class CompilationTaskPool {
  public:
-  WasmCompilationTask(
-      Isolate* isolate,
-      std::vector<compiler::WasmCompilationUnit*>* compilation_units,
-      std::queue<compiler::WasmCompilationUnit*>* executed_units,
-      base::Semaphore* on_finished, base::Mutex* result_mutex,
-      base::AtomicNumber<size_t>* next_unit)
-      : CancelableTask(isolate),
-        isolate_(isolate),
+  CompilationTaskPool(Isolate* isolate, size_t max_tasks,
+                      CompilationUnitQueue* compilation_units,
+                      std::queue<compiler::WasmCompilationUnit*>* executed_units,
+                      base::Mutex* result_mutex)
+      : isolate_(isolate),
+        max_tasks_(max_tasks),
         compilation_units_(compilation_units),
         executed_units_(executed_units),
-        on_finished_(on_finished),
         result_mutex_(result_mutex),
-        next_unit_(next_unit) {}
+        finished_tasks_(0) {}
 
-  void RunInternal() override {
-    while (FetchAndExecuteCompilationUnit(isolate_, compilation_units_,
-                                          executed_units_, result_mutex_,
-                                          next_unit_)) {
-    }
-    on_finished_->Signal();
-  }
+  void MaybeStartTask();
+  // Aborts the tasks that have not started yet and waits for all others.
+  void WaitForTasks();
+
+ private:
+  friend class WasmCompilationTask;
 
   Isolate* isolate_;
-  std::vector<compiler::WasmCompilationUnit*>* compilation_units_;
+  const size_t max_tasks_;
+  CompilationUnitQueue* compilation_units_;
   std::queue<compiler::WasmCompilationUnit*>* executed_units_;
-  base::Semaphore* on_finished_;
   base::Mutex* result_mutex_;
-  base::AtomicNumber<size_t>* next_unit_;
+  base::AtomicNumber<int> running_tasks_;
+  base::Semaphore finished_tasks_;
+  std::vector<uint32_t> task_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationTaskPool);
+};
+
+class WasmCompilationTask : public CancelableTask {
+ public:
+  explicit WasmCompilationTask(CompilationTaskPool* pool)
+      : CancelableTask(pool->isolate_), pool_(pool) {}
+
+  void RunInternal() override {
+    while (FetchAndExecuteCompilationUnit(pool_->compilation_units_,
+                                          pool_->executed_units_,
+                                          pool_->result_mutex_)) {
+    }
+    pool_->running_tasks_.Increment(-1);
+    pool_->finished_tasks_.Signal();
+  }
+
+  CompilationTaskPool* pool_;
 };
 
+void CompilationTaskPool::MaybeStartTask() {
+  // A task that is about to exit may still be counted here. The unit it
+  // misses is picked up by the next task or by the main thread.
+  if (static_cast<size_t>(running_tasks_.Value()) >= max_tasks_) return;
+  running_tasks_.Increment(1);
+  WasmCompilationTask* task = new WasmCompilationTask(this);
+  task_ids_.push_back(task->id());
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      task, v8::Platform::kLongRunningTask);
+}
+
+void CompilationTaskPool::WaitForTasks() {
+  for (uint32_t task_id : task_ids_) {
+    // If the task has not started yet, then we abort it. Otherwise we wait for
+    // it to finish.
+    if (!isolate_->cancelable_task_manager()->TryAbort(task_id)) {
+      finished_tasks_.Wait();
+    }
+  }
+  task_ids_.clear();
+}
+
 void record_code_size(uint32_t& total_code_size, Code* code) {
   if (FLAG_print_wasm_code_size) {
     total_code_size += code->body_size() + code->relocation_info()->length();
@@ -493,60 +578,9 @@ bool CompileWrappersToImportedFunctions(Isolate* isolate, WasmModule* module,
   return true;
 }
 
-void InitializeParallelCompilation(
-    Isolate* isolate, std::vector<WasmFunction>& functions,
-    std::vector<compiler::WasmCompilationUnit*>& compilation_units,
-    ModuleEnv& module_env, ErrorThrower& thrower) {
-  // Create a placeholder code object for all functions.
-  // TODO(ahaas): Maybe we could skip this for external functions.
-  for (uint32_t i = 0; i < functions.size(); i++) {
-    module_env.linker->GetFunctionCode(i);
-  }
-
-  for (uint32_t i = FLAG_skip_compiling_wasm_funcs; i < functions.size(); i++) {
-    if (!functions[i].external) {
-      compilation_units[i] = compiler::CreateWasmCompilationUnit(
-          &thrower, isolate, &module_env, &functions[i], i);
-    } else {
-      compilation_units[i] = nullptr;
-    }
-  }
-}
-
-uint32_t* StartCompilationTasks(
-    Isolate* isolate,
-    std::vector<compiler::WasmCompilationUnit*>& compilation_units,
-    std::queue<compiler::WasmCompilationUnit*>& executed_units,
-    const base::SmartPointer<base::Semaphore>& pending_tasks,
-    base::Mutex& result_mutex, base::AtomicNumber<size_t>& next_unit) {
-  const size_t num_tasks =
-      Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
-          V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
-  uint32_t* task_ids = new uint32_t[num_tasks];
-  for (size_t i = 0; i < num_tasks; i++) {
-    WasmCompilationTask* task =
-        new WasmCompilationTask(isolate, &compilation_units, &executed_units,
-                                pending_tasks.get(), &result_mutex, &next_unit);
-    task_ids[i] = task->id();
-    V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        task, v8::Platform::kShortRunningTask);
-  }
-  return task_ids;
-}
-
-void WaitForCompilationTasks(
-    Isolate* isolate, uint32_t* task_ids,
-    const base::SmartPointer<base::Semaphore>& pending_tasks) {
-  const size_t num_tasks =
-      Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
-          V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
-  for (size_t i = 0; i < num_tasks; i++) {
-    // If the task has not started yet, then we abort it. Otherwise we wait for
-    // it to finish.
-    if (!isolate->cancelable_task_manager()->TryAbort(task_ids[i])) {
-      pending_tasks->Wait();
-    }
-  }
+size_t NumberOfCompilationTasks() {
+  return Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
+             V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
 }
 
 void FinishCompilationUnits(
@@ -570,6 +604,46 @@ void FinishCompilationUnits(
   }
 }
 
+void CreateCompilationUnits(
+    Isolate* isolate, WasmModule* module,
+    CompilationUnitQueue& compilation_units, CompilationTaskPool& tasks,
+    std::queue<compiler::WasmCompilationUnit*>& executed_units,
+    std::vector<Handle<Code>>& results, base::Mutex& result_mutex,
+    ModuleEnv& module_env, ErrorThrower& thrower) {
+  std::vector<WasmFunction>& functions = module->functions;
+  for (uint32_t i = FLAG_skip_compiling_wasm_funcs; i < functions.size(); i++) {
+    if (!functions[i].external) {
+      compilation_units.Add(compiler::CreateWasmCompilationUnit(
+          &thrower, isolate, &module_env, &functions[i], i));
+    } else {
+      compilation_units.Add(nullptr);
+    }
+    tasks.MaybeStartTask();
+    // Finish units that were executed in the meantime to save memory.
+    FinishCompilationUnits(module, executed_units, results, result_mutex);
+  }
+}
+
+// Compiles the wrapper for a function that is declared external, i.e. that is
+// looked up in the FFI object. Returns a null handle on failure.
+Handle<Code> CompileWrapperToExternalFunction(Isolate* isolate,
+                                              WasmModule* module,
+                                              const Handle<JSReceiver> ffi,
+                                              const WasmFunction& func,
+                                              ErrorThrower& thrower,
+                                              Factory* factory,
+                                              ModuleEnv& module_env) {
+  DCHECK(func.external);
+  WasmName str = module->GetName(func.name_offset, func.name_length);
+  WasmName str_null = {nullptr, 0};
+  MaybeHandle<JSFunction> function =
+      LookupFunction(thrower, factory, ffi, func.func_index, str, str_null);
+  if (function.is_null()) return Handle<Code>::null();
+  return compiler::CompileWasmToJSWrapper(isolate, &module_env,
+                                          function.ToHandleChecked(), func.sig,
+                                          str, str_null);
+}
+
 bool FinishCompilation(Isolate* isolate, WasmModule* module,
                        const Handle<JSReceiver> ffi,
                        const std::vector<Handle<Code>>& results,
@@ -585,22 +659,23 @@ bool FinishCompilation(Isolate* isolate, WasmModule* module,
 
     DCHECK_EQ(i, func.func_index);
     WasmName str = module->GetName(func.name_offset, func.name_length);
-    WasmName str_null = {nullptr, 0};
     Handle<Code> code = Handle<Code>::null();
     Handle<JSFunction> function = Handle<JSFunction>::null();
     Handle<String> function_name = Handle<String>::null();
     if (func.external) {
-      // Lookup external function in FFI object.
-      MaybeHandle<JSFunction> function =
-          LookupFunction(thrower, factory, ffi, i, str, str_null);
-      if (function.is_null()) {
+      // Lookup external function in FFI object, unless the wrapper was already
+      // compiled for deserializing the module.
+      code = results[i];
+      if (code.is_null()) {
+        code = CompileWrapperToExternalFunction(isolate, module, ffi, func,
+                                                thrower, factory, module_env);
+      }
+      if (code.is_null()) {
         return false;
       }
-      code = compiler::CompileWasmToJSWrapper(isolate, &module_env,
-                                              function.ToHandleChecked(),
-                                              func.sig, str, str_null);
     } else {
-      if (FLAG_wasm_num_compilation_tasks != 0) {
+      if (!results[i].is_null() || FLAG_wasm_num_compilation_tasks != 0) {
+        // The code was compiled in parallel or deserialized.
         code = results[i];
       } else {
         // Compile the function.
@@ -638,16 +713,160 @@ bool FinishCompilation(Isolate* isolate, WasmModule* module,
   }
   return true;
 }
+
+//-------------------------------------------------------------------------
+// Code caching of compiled modules.
+//-------------------------------------------------------------------------
+
+// Internal constants for the layout of a compiled module in the code cache.
+const int kCompiledModuleCodeTable = 0;        // FixedArray of Code
+const int kCompiledModuleRelocationBases = 1;  // ByteArray of RelocationBases
+const int kCompiledModuleFieldCount = 2;
+
+// The addresses of per-instance data that are embedded in the compiled code.
+struct RelocationBases {
+  Address mem_start;
+  size_t mem_size;
+  Address globals_start;
+};
+
+// Returns the objects of {instance} that are referenced by its compiled code
+// but are not part of the code cache. The order of the objects has to be the
+// same when producing and when consuming the cache. The wrappers to external
+// functions are taken from {code_table}.
+Handle<FixedArray> GetAttachedObjects(Isolate* isolate, WasmModule* module,
+                                      const WasmModuleInstance& instance,
+                                      Handle<FixedArray> code_table) {
+  int num_external_functions = 0;
+  for (const WasmFunction& func : module->functions) {
+    if (func.external) num_external_functions++;
+  }
+  int num_imports = static_cast<int>(instance.import_code.size());
+  Handle<FixedArray> objects = isolate->factory()->NewFixedArray(
+      3 + num_imports + num_external_functions, TENURED);
+  int index = 0;
+  objects->set(index++, *instance.context);
+  objects->set(index++, *instance.js_object);
+  // The function table stays undefined if the module does not have one.
+  if (!instance.function_table.is_null()) {
+    objects->set(index, *instance.function_table);
+  }
+  index++;
+  for (Handle<Code> code : instance.import_code) {
+    objects->set(index++, *code);
+  }
+  for (const WasmFunction& func : module->functions) {
+    if (func.external) {
+      objects->set(index++, code_table->get(func.func_index));
+    }
+  }
+  DCHECK_EQ(objects->length(), index);
+  return objects;
+}
+
+// Serializes the code of all functions in {code_table}, which has been
+// linked already.
+ScriptData* SerializeCompiledModule(Isolate* isolate, WasmModule* module,
+                                    const WasmModuleInstance& instance,
+                                    Handle<FixedArray> code_table) {
+  Factory* factory = isolate->factory();
+  RelocationBases bases = {instance.mem_start, instance.mem_size,
+                           instance.globals_start};
+  Handle<ByteArray> relocation_bases =
+      factory->NewByteArray(sizeof(bases), TENURED);
+  relocation_bases->copy_in(0, reinterpret_cast<byte*>(&bases), sizeof(bases));
+
+  Handle<FixedArray> compiled_module =
+      factory->NewFixedArray(kCompiledModuleFieldCount, TENURED);
+  compiled_module->set(kCompiledModuleCodeTable, *code_table);
+  compiled_module->set(kCompiledModuleRelocationBases, *relocation_bases);
+
+  Handle<FixedArray> attached_objects =
+      GetAttachedObjects(isolate, module, instance, code_table);
+  return CodeSerializer::SerializeWasmModule(
+      isolate, compiled_module, attached_objects,
+      Vector<const byte>(module->module_start,
+                         static_cast<int>(module->module_end -
+                                          module->module_start)));
+}
+
+// Patches the references to the memory and the globals of the instance the
+// code was compiled for, so that they point into {instance}.
+void RelocateCode(Isolate* isolate, Handle<Code> code,
+                  const RelocationBases& bases,
+                  const WasmModuleInstance& instance) {
+  int mode_mask = RelocInfo::ModeMask(RelocInfo::WASM_MEMORY_REFERENCE) |
+                  RelocInfo::ModeMask(RelocInfo::WASM_GLOBAL_REFERENCE);
+  AllowDeferredHandleDereference embedding_raw_address;
+  uint32_t mem_size = static_cast<uint32_t>(instance.mem_size);
+  for (RelocIterator it(*code, mode_mask); !it.done(); it.next()) {
+    RelocInfo::Mode mode = it.rinfo()->rmode();
+    if (RelocInfo::IsWasmMemoryReference(mode)) {
+      it.rinfo()->update_wasm_memory_reference(
+          bases.mem_start, instance.mem_start, mem_size, mem_size,
+          SKIP_ICACHE_FLUSH);
+    } else {
+      DCHECK(RelocInfo::IsWasmGlobalReference(mode));
+      it.rinfo()->update_wasm_global_reference(
+          bases.globals_start, instance.globals_start, SKIP_ICACHE_FLUSH);
+    }
+  }
+  Assembler::FlushICache(isolate, code->instruction_start(),
+                         code->instruction_size());
+}
+
+// Deserializes the code of all functions from {cached_data} and relocates it
+// to {instance}. The wrappers to external functions have to be installed in
+// {code_table} already. On success, the code of the wasm functions is stored
+// in {results}. Returns false if the cached data was rejected.
+bool DeserializeCompiledModule(Isolate* isolate, WasmModule* module,
+                               ScriptData* cached_data,
+                               const WasmModuleInstance& instance,
+                               Handle<FixedArray> code_table,
+                               std::vector<Handle<Code>>& results) {
+  Handle<FixedArray> attached_objects =
+      GetAttachedObjects(isolate, module, instance, code_table);
+  Handle<FixedArray> compiled_module;
+  if (!CodeSerializer::DeserializeWasmModule(
+           isolate, cached_data, attached_objects,
+           Vector<const byte>(module->module_start,
+                              static_cast<int>(module->module_end -
+                                               module->module_start)))
+           .ToHandle(&compiled_module)) {
+    return false;
+  }
+
+  RelocationBases bases;
+  ByteArray::cast(compiled_module->get(kCompiledModuleRelocationBases))
+      ->copy_out(0, reinterpret_cast<byte*>(&bases), sizeof(bases));
+  // Bounds checks embed the size of the memory, so the cached code can only
+  // be used for memories of the same size.
+  if (bases.mem_size != instance.mem_size) {
+    cached_data->Reject();
+    return false;
+  }
+
+  FixedArray* cached_code_table =
+      FixedArray::cast(compiled_module->get(kCompiledModuleCodeTable));
+  DCHECK_EQ(code_table->length(), cached_code_table->length());
+  for (uint32_t i = 0; i < module->functions.size(); i++) {
+    if (module->functions[i].external) continue;
+    Handle<Code> code(Code::cast(cached_code_table->get(i)), isolate);
+    RelocateCode(isolate, code, bases, instance);
+    results[i] = code;
+  }
+  return true;
+}
 }  // namespace
 
 // Instantiates a wasm module as a JSObject.
 //  * allocates a backing store of {mem_size} bytes.
 //  * installs a named property "memory" for that buffer if exported
 //  * installs named properties on the object for exported functions
-//  * compiles wasm code to machine code
-MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
-                                              Handle<JSReceiver> ffi,
-                                              Handle<JSArrayBuffer> memory) {
+//  * compiles wasm code to machine code, or deserializes it from the code cache
+MaybeHandle<JSObject> WasmModule::Instantiate(
+    Isolate* isolate, Handle<JSReceiver> ffi, Handle<JSArrayBuffer> memory,
+    ScriptData** cached_data, ScriptCompiler::CompileOptions compile_options) {
   HistogramTimerScope wasm_instantiate_module_time_scope(
       isolate->counters()->wasm_instantiate_module_time());
   this->shared_isolate = isolate;  // TODO(titzer): have a real shared isolate.
@@ -731,22 +950,52 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
         static_cast<int>(functions.size()));
 
     // Data structures for the parallel compilation.
-    std::vector<compiler::WasmCompilationUnit*> compilation_units(
-        functions.size());
     std::queue<compiler::WasmCompilationUnit*> executed_units;
     std::vector<Handle<Code>> results(functions.size());
 
-    if (FLAG_wasm_num_compilation_tasks != 0) {
+    // Code that skipped compilation would reference placeholders, so it is
+    // never cached.
+    bool use_code_cache =
+        cached_data != nullptr &&
+        compile_options != ScriptCompiler::kNoCompileOptions &&
+        FLAG_skip_compiling_wasm_funcs == 0;
+    bool deserialized = false;
+    if (use_code_cache &&
+        compile_options == ScriptCompiler::kConsumeCodeCache) {
+      HistogramTimerScope wasm_deserialize_module_time_scope(
+          isolate->counters()->wasm_deserialize_module_time());
+      // The wrappers to external functions are attached to the cached code,
+      // so they have to be compiled first.
+      for (const WasmFunction& func : functions) {
+        if (!func.external) continue;
+        Handle<Code> code = CompileWrapperToExternalFunction(
+            isolate, this, ffi, func, thrower, factory, module_env);
+        if (code.is_null()) return MaybeHandle<JSObject>();
+        code_table->set(func.func_index, *code);
+        results[func.func_index] = code;
+      }
+      deserialized = DeserializeCompiledModule(isolate, this, *cached_data,
+                                               instance, code_table, results);
+    }
+    if (use_code_cache &&
+        compile_options == ScriptCompiler::kProduceCodeCache) {
+      instance.will_serialize = true;
+    }
+
+    if (!deserialized && FLAG_wasm_num_compilation_tasks != 0) {
       //-----------------------------------------------------------------------
       // For parallel compilation:
       // 1) The main thread allocates a compilation unit for each wasm function
-      //    and stores them in the vector {compilation_units}.
-      // 2) The main thread spawns {WasmCompilationTask} instances which run on
-      //    the background threads.
-      // 3.a) The background threads and the main thread pick one compilation
-      //      unit at a time and execute the parallel phase of the compilation
-      //      unit. After finishing the execution of the parallel phase, the
-      //      result is enqueued in {executed_units}.
+      //    and adds it to {compilation_units}. Each unit is available to the
+      //    background threads as soon as it has been added.
+      // 2) After adding a unit, the main thread spawns another
+      //    {WasmCompilationTask} unless enough tasks are running. A task runs
+      //    until no created unit is left and never waits for the main thread.
+      // 3.a) The background threads and, once all units were added, the main
+      //      thread pick one compilation unit at a time and execute the
+      //      parallel phase of the compilation unit. After finishing the
+      //      execution of the parallel phase, the result is enqueued in
+      //      {executed_units}.
       // 3.b) If {executed_units} contains a compilation unit, the main thread
       //      dequeues it and finishes the compilation.
       // 4) After the parallel phase of all compilation units has started, the
@@ -757,30 +1006,34 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
       // use the node cache.
       CanonicalHandleScope canonical(isolate);
 
-      // 1) The main thread allocates a compilation unit for each wasm function
-      //    and stores them in the vector {compilation_units}.
-      InitializeParallelCompilation(isolate, functions, compilation_units,
-                                    module_env, thrower);
+      // Create a placeholder code object for all functions.
+      // TODO(ahaas): Maybe we could skip this for external functions.
+      for (uint32_t i = 0; i < functions.size(); i++) {
+        linker.GetFunctionCode(i);
+      }
 
       // Objects for the synchronization with the background threads.
-      base::SmartPointer<base::Semaphore> pending_tasks(new base::Semaphore(0));
+      CompilationUnitQueue compilation_units(
+          static_cast<size_t>(FLAG_skip_compiling_wasm_funcs),
+          functions.size());
       base::Mutex result_mutex;
-      base::AtomicNumber<size_t> next_unit(
-          static_cast<size_t>(FLAG_skip_compiling_wasm_funcs));
+      CompilationTaskPool tasks(isolate, NumberOfCompilationTasks(),
+                                &compilation_units, &executed_units,
+                                &result_mutex);
 
-      // 2) The main thread spawns {WasmCompilationTask} instances which run on
-      //    the background threads.
-      base::SmartArrayPointer<uint32_t> task_ids(
-          StartCompilationTasks(isolate, compilation_units, executed_units,
-                                pending_tasks, result_mutex, next_unit));
+      // 1) The main thread allocates a compilation unit for each wasm function
+      //    and adds it to {compilation_units}.
+      // 2) It spawns {WasmCompilationTask} instances on the way.
+      CreateCompilationUnits(isolate, this, compilation_units, tasks,
+                             executed_units, results, result_mutex, module_env,
+                             thrower);
 
       // 3.a) The background threads and the main thread pick one compilation
       //      unit at a time and execute the parallel phase of the compilation
       //      unit. After finishing the execution of the parallel phase, the
       //      result is enqueued in {executed_units}.
-      while (FetchAndExecuteCompilationUnit(isolate, &compilation_units,
-                                            &executed_units, &result_mutex,
-                                            &next_unit)) {
+      while (FetchAndExecuteCompilationUnit(&compilation_units,
+                                            &executed_units, &result_mutex)) {
         // 3.b) If {executed_units} contains a compilation unit, the main thread
         //      dequeues it and finishes the compilation unit. Compilation units
         //      are finished concurrently to the background threads to save
@@ -789,7 +1042,7 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
       }
       // 4) After the parallel phase of all compilation units has started, the
       //    main thread waits for all {WasmCompilationTask} instances to finish.
-      WaitForCompilationTasks(isolate, task_ids.get(), pending_tasks);
+      tasks.WaitForTasks();
       // Finish the compilation of the remaining compilation units.
       FinishCompilationUnits(this, executed_units, results, result_mutex);
     }
@@ -805,6 +1058,13 @@ MaybeHandle<JSObject> WasmModule::Instantiate(Isolate* isolate,
     instance.js_object->SetInternalField(kWasmModuleFunctionTable,
                                          Smi::FromInt(0));
 
+    if (instance.will_serialize) {
+      HistogramTimerScope wasm_serialize_module_time_scope(
+          isolate->counters()->wasm_serialize_module_time());
+      *cached_data =
+          SerializeCompiledModule(isolate, this, instance, code_table);
+    }
+
     //-------------------------------------------------------------------------
     // Create and populate the exports object.
     //-------------------------------------------------------------------------
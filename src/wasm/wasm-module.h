@@ -14,6 +14,8 @@
 namespace v8 {
 namespace internal {
 
+class ScriptData;
+
 namespace compiler {
 class CallDescriptor;
 class WasmCompilationUnit;
@@ -220,9 +222,17 @@ struct WasmModule {
     return start <= size && end <= size;
   }
 
-  // Creates a new instantiation of the module in the given isolate.
-  MaybeHandle<JSObject> Instantiate(Isolate* isolate, Handle<JSReceiver> ffi,
-                                    Handle<JSArrayBuffer> memory);
+  // Creates a new instantiation of the module in the given isolate. With
+  // {ScriptCompiler::kProduceCodeCache}, the compiled code is serialized into
+  // {*cached_data}. With {ScriptCompiler::kConsumeCodeCache}, the code is
+  // deserialized from {*cached_data} instead of being compiled; if the data
+  // does not fit this module, isolate or flags, it is rejected and the module
+  // is compiled as usual.
+  MaybeHandle<JSObject> Instantiate(
+      Isolate* isolate, Handle<JSReceiver> ffi, Handle<JSArrayBuffer> memory,
+      ScriptData** cached_data = nullptr,
+      ScriptCompiler::CompileOptions compile_options =
+          ScriptCompiler::kNoCompileOptions);
 };
 
 // An instantiated WASM module, including memory, function table, etc.
@@ -242,13 +252,16 @@ struct WasmModuleInstance {
   // -- raw globals -----------------------------------------------------------
   byte* globals_start;  // start of the globals area.
   size_t globals_size;  // size of the globals area.
+  // -- compilation -----------------------------------------------------------
+  bool will_serialize;  // whether the compiled code will be serialized.
 
   explicit WasmModuleInstance(WasmModule* m)
       : module(m),
         mem_start(nullptr),
         mem_size(0),
         globals_start(nullptr),
-        globals_size(0) {}
+        globals_size(0),
+        will_serialize(false) {}
 };
 
 // forward declaration.
@@ -143,6 +143,7 @@ class CcTestArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
     return malloc(length == 0 ? 1 : length);
   }
   virtual void Free(void* data, size_t length) { free(data); }
+  virtual bool IsFreeThreadSafe() { return true; }
   // TODO(dslomov): Remove when v8:2823 is fixed.
   virtual void Free(void* data) { UNREACHABLE(); }
 };
@@ -573,6 +573,45 @@ TEST(InlineMutuallyRecursive) {
   T.CheckCall(T.Val(42), T.Val(1));
 }
 
+
+TEST(InlineMaxLevels) {
+  FLAG_max_inlining_levels = 1;
+  FunctionTester T(
+      "(function () {"
+      "  function baz(x) { AssertInlineCount(1); return x + 1; }"
+      "  function bar(x) { AssertInlineCount(2); return baz(x); }"
+      "  function foo(x) { return bar(x); }"
+      "  return foo;"
+      "})();",
+      kInlineFlags);
+
+  InstallAssertInlineCountHelper(CcTest::isolate());
+  T.CheckCall(T.Val(2), T.Val(1));
+}
+
+
+TEST(InlineMaxLevelsPolymorphic) {
+  FLAG_max_inlining_levels = 1;
+  FLAG_turbo_polymorphic_inlining = true;
+  FunctionTester T(
+      "(function () {"
+      "  function baz1(x) { AssertInlineCount(1); return x + 1; }"
+      "  function baz2(x) { AssertInlineCount(1); return x + 2; }"
+      "  function bar(p, x) {"
+      "    AssertInlineCount(2);"
+      "    var g = p ? baz1 : baz2;"
+      "    return g(x);"
+      "  }"
+      "  function foo(p, x) { return bar(p, x); }"
+      "  return foo;"
+      "})();",
+      kInlineFlags);
+
+  InstallAssertInlineCountHelper(CcTest::isolate());
+  T.CheckCall(T.Val(2), T.true_value(), T.Val(1));
+  T.CheckCall(T.Val(3), T.false_value(), T.Val(1));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
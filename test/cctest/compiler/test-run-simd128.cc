@@ -0,0 +1,241 @@
+// Copyright 2016 the V8 project authors. All rights reserved. Use of this
+// source code is governed by a BSD-style license that can be found in the
+// LICENSE file.
+
+#include "test/cctest/cctest.h"
+#include "test/cctest/compiler/codegen-tester.h"
+#include "test/cctest/compiler/value-helper.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Only x64 implements the 128-bit machine operators.
+#if V8_TARGET_ARCH_X64
+
+namespace {
+
+const int kLanes = 4;
+
+int32_t AddWrapped(int32_t a, int32_t b) {
+  return static_cast<int32_t>(static_cast<uint32_t>(a) +
+                              static_cast<uint32_t>(b));
+}
+
+int32_t SubWrapped(int32_t a, int32_t b) {
+  return static_cast<int32_t>(static_cast<uint32_t>(a) -
+                              static_cast<uint32_t>(b));
+}
+
+// Builds c = op(a, b) on 128-bit vectors loaded from and stored to memory,
+// i.e. an unaligned load, the operation, and an unaligned store.
+template <typename T>
+void BuildSimd128Binop(RawMachineAssemblerTester<int32_t>* m,
+                       const Operator* op, T* a, T* b, T* c) {
+  Node* x = m->Load(MachineType::Simd128(), m->PointerConstant(a));
+  Node* y = m->Load(MachineType::Simd128(), m->PointerConstant(b));
+  m->Store(MachineRepresentation::kSimd128, m->PointerConstant(c),
+           m->AddNode(op, x, y), kNoWriteBarrier);
+  m->Return(m->Int32Constant(0));
+}
+
+}  // namespace
+
+
+TEST(RunInt32x4Add) {
+  int32_t a[kLanes], b[kLanes], c[kLanes];
+  RawMachineAssemblerTester<int32_t> m;
+  BuildSimd128Binop(&m, m.machine()->Int32x4Add(), a, b, c);
+
+  FOR_INT32_INPUTS(i) {
+    FOR_INT32_INPUTS(j) {
+      for (int lane = 0; lane < kLanes; ++lane) {
+        a[lane] = AddWrapped(*i, lane);
+        b[lane] = SubWrapped(*j, lane);
+      }
+      CHECK_EQ(0, m.Call());
+      for (int lane = 0; lane < kLanes; ++lane) {
+        CHECK_EQ(AddWrapped(a[lane], b[lane]), c[lane]);
+      }
+    }
+  }
+}
+
+
+TEST(RunInt32x4Sub) {
+  int32_t a[kLanes], b[kLanes], c[kLanes];
+  RawMachineAssemblerTester<int32_t> m;
+  BuildSimd128Binop(&m, m.machine()->Int32x4Sub(), a, b, c);
+
+  FOR_INT32_INPUTS(i) {
+    FOR_INT32_INPUTS(j) {
+      for (int lane = 0; lane < kLanes; ++lane) {
+        a[lane] = AddWrapped(*i, lane);
+        b[lane] = SubWrapped(*j, lane);
+      }
+      CHECK_EQ(0, m.Call());
+      for (int lane = 0; lane < kLanes; ++lane) {
+        CHECK_EQ(SubWrapped(a[lane], b[lane]), c[lane]);
+      }
+    }
+  }
+}
+
+
+TEST(RunFloat32x4Arithmetic) {
+  float a[kLanes], b[kLanes], c[kLanes];
+  RawMachineAssemblerTester<int32_t> add, sub, mul, div;
+  BuildSimd128Binop(&add, add.machine()->Float32x4Add(), a, b, c);
+  BuildSimd128Binop(&sub, sub.machine()->Float32x4Sub(), a, b, c);
+  BuildSimd128Binop(&mul, mul.machine()->Float32x4Mul(), a, b, c);
+  BuildSimd128Binop(&div, div.machine()->Float32x4Div(), a, b, c);
+
+  FOR_FLOAT32_INPUTS(i) {
+    FOR_FLOAT32_INPUTS(j) {
+      // Each lane gets different inputs to catch mixed up lanes.
+      for (int lane = 0; lane < kLanes; ++lane) {
+        a[lane] = lane % 2 == 0 ? *i : *j;
+        b[lane] = lane < 2 ? *j : *i;
+      }
+      CHECK_EQ(0, add.Call());
+      for (int lane = 0; lane < kLanes; ++lane) {
+        CHECK_FLOAT_EQ(a[lane] + b[lane], c[lane]);
+      }
+      CHECK_EQ(0, sub.Call());
+      for (int lane = 0; lane < kLanes; ++lane) {
+        CHECK_FLOAT_EQ(a[lane] - b[lane], c[lane]);
+      }
+      CHECK_EQ(0, mul.Call());
+      for (int lane = 0; lane < kLanes; ++lane) {
+        CHECK_FLOAT_EQ(a[lane] * b[lane], c[lane]);
+      }
+      CHECK_EQ(0, div.Call());
+      for (int lane = 0; lane < kLanes; ++lane) {
+        CHECK_FLOAT_EQ(a[lane] / b[lane], c[lane]);
+      }
+    }
+  }
+}
+
+
+TEST(RunSimd128UnalignedLoadStore) {
+  // Copies a vector between addresses that are not 16-byte aligned.
+  int32_t buffer[3 * kLanes];
+  RawMachineAssemblerTester<int32_t> m;
+  Node* value = m.Load(MachineType::Simd128(), m.PointerConstant(&buffer[1]));
+  m.Store(MachineRepresentation::kSimd128, m.PointerConstant(&buffer[6]),
+          value, kNoWriteBarrier);
+  m.Return(m.Int32Constant(0));
+
+  for (int i = 0; i < 3 * kLanes; ++i) buffer[i] = i;
+  CHECK_EQ(0, m.Call());
+  for (int i = 0; i < 3 * kLanes; ++i) {
+    CHECK_EQ(i >= 6 && i < 6 + kLanes ? i - 5 : i, buffer[i]);
+  }
+}
+
+
+TEST(RunSimd128PhiSwap) {
+  // a, b = b, a in a loop, which needs a swap of two 128-bit values in the
+  // gap moves of the back edge.
+  int32_t a[kLanes], b[kLanes];
+  RawMachineAssemblerTester<int32_t> m(MachineType::Int32());
+  Node* a0 = m.Load(MachineType::Simd128(), m.PointerConstant(a));
+  Node* b0 = m.Load(MachineType::Simd128(), m.PointerConstant(b));
+  Node* zero = m.Int32Constant(0);
+
+  RawMachineLabel header, body, end;
+  m.Goto(&header);
+  m.Bind(&header);
+  Node* counter = m.Phi(MachineRepresentation::kWord32, zero, zero);
+  Node* phi_a = m.Phi(MachineRepresentation::kSimd128, a0, a0);
+  Node* phi_b = m.Phi(MachineRepresentation::kSimd128, b0, b0);
+  m.Branch(m.Int32LessThan(counter, m.Parameter(0)), &body, &end);
+  m.Bind(&body);
+  counter->ReplaceInput(1, m.Int32Add(counter, m.Int32Constant(1)));
+  phi_a->ReplaceInput(1, phi_b);
+  phi_b->ReplaceInput(1, phi_a);
+  m.Goto(&header);
+  m.Bind(&end);
+  m.Store(MachineRepresentation::kSimd128, m.PointerConstant(a), phi_a,
+          kNoWriteBarrier);
+  m.Store(MachineRepresentation::kSimd128, m.PointerConstant(b), phi_b,
+          kNoWriteBarrier);
+  m.Return(zero);
+
+  for (int32_t iterations = 0; iterations < 4; ++iterations) {
+    for (int lane = 0; lane < kLanes; ++lane) {
+      a[lane] = lane;
+      b[lane] = -lane - 1;
+    }
+    CHECK_EQ(0, m.Call(iterations));
+    bool swapped = iterations % 2 == 1;
+    for (int lane = 0; lane < kLanes; ++lane) {
+      CHECK_EQ(swapped ? -lane - 1 : lane, a[lane]);
+      CHECK_EQ(swapped ? lane : -lane - 1, b[lane]);
+    }
+  }
+}
+
+
+TEST(RunSimd128Spills) {
+  // Rotates more 128-bit values than there are registers through a loop, so
+  // that some of them live in 16-byte spill slots. The gap moves of the back
+  // edge move values between registers and spill slots in both directions.
+  static const int kCount = 20;
+  int32_t values[kCount][kLanes];
+  int32_t one[kLanes] = {1, 1, 1, 1};
+  RawMachineAssemblerTester<int32_t> m(MachineType::Int32());
+  Node* increment = m.Load(MachineType::Simd128(), m.PointerConstant(one));
+  Node* initial[kCount];
+  for (int i = 0; i < kCount; ++i) {
+    initial[i] =
+        m.Load(MachineType::Simd128(), m.PointerConstant(&values[i][0]));
+  }
+  Node* zero = m.Int32Constant(0);
+
+  RawMachineLabel header, body, end;
+  m.Goto(&header);
+  m.Bind(&header);
+  Node* counter = m.Phi(MachineRepresentation::kWord32, zero, zero);
+  Node* phis[kCount];
+  for (int i = 0; i < kCount; ++i) {
+    phis[i] = m.Phi(MachineRepresentation::kSimd128, initial[i], initial[i]);
+  }
+  m.Branch(m.Int32LessThan(counter, m.Parameter(0)), &body, &end);
+  m.Bind(&body);
+  counter->ReplaceInput(1, m.Int32Add(counter, m.Int32Constant(1)));
+  // v[i] = v[i + 1] + 1 for all i at once.
+  for (int i = 0; i < kCount; ++i) {
+    phis[i]->ReplaceInput(1, m.AddNode(m.machine()->Int32x4Add(),
+                                       phis[(i + 1) % kCount], increment));
+  }
+  m.Goto(&header);
+  m.Bind(&end);
+  for (int i = 0; i < kCount; ++i) {
+    m.Store(MachineRepresentation::kSimd128,
+            m.PointerConstant(&values[i][0]), phis[i], kNoWriteBarrier);
+  }
+  m.Return(zero);
+
+  for (int32_t iterations = 0; iterations < 2 * kCount; iterations += 7) {
+    for (int i = 0; i < kCount; ++i) {
+      for (int lane = 0; lane < kLanes; ++lane) {
+        values[i][lane] = i * kLanes + lane;
+      }
+    }
+    CHECK_EQ(0, m.Call(iterations));
+    for (int i = 0; i < kCount; ++i) {
+      int source = (i + iterations) % kCount;
+      for (int lane = 0; lane < kLanes; ++lane) {
+        CHECK_EQ(source * kLanes + lane + iterations, values[i][lane]);
+      }
+    }
+  }
+}
+
+#endif  // V8_TARGET_ARCH_X64
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,126 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/api.h"
+#include "src/heap/array-buffer-tracker.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "test/cctest/cctest.h"
+#include "test/cctest/heap/utils-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+bool IsTracked(JSArrayBuffer* buf) {
+  return CcTest::heap()->array_buffer_tracker()->IsTracked(buf);
+}
+
+}  // namespace
+
+TEST(ArrayBuffer_OnlyScavenge) {
+  // Array buffers that survive scavenges stay tracked at their new location.
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = CcTest::heap();
+
+  v8::HandleScope handle_scope(isolate);
+  Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, 100);
+  Handle<JSArrayBuffer> buf = v8::Utils::OpenHandle(*ab);
+  CHECK(heap->InNewSpace(*buf));
+  CHECK(IsTracked(*buf));
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(IsTracked(*buf));
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(IsTracked(*buf));
+  CHECK(!heap->InNewSpace(*buf));
+}
+
+TEST(ArrayBuffer_OnlyMC) {
+  // Array buffers that survive full GCs stay tracked at their new location.
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = CcTest::heap();
+
+  v8::HandleScope handle_scope(isolate);
+  Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, 100);
+  Handle<JSArrayBuffer> buf = v8::Utils::OpenHandle(*ab);
+  CHECK(IsTracked(*buf));
+  heap->CollectAllGarbage();
+  CHECK(IsTracked(*buf));
+  heap->CollectAllGarbage();
+  CHECK(IsTracked(*buf));
+  CHECK(!heap->InNewSpace(*buf));
+}
+
+TEST(ArrayBuffer_Compaction) {
+  // Array buffers on evacuation candidates are moved with their objects.
+  FLAG_manual_evacuation_candidates_selection = true;
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = CcTest::heap();
+
+  v8::HandleScope handle_scope(isolate);
+  Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, 100);
+  Handle<JSArrayBuffer> buf = v8::Utils::OpenHandle(*ab);
+  heap->CollectGarbage(NEW_SPACE);
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(!heap->InNewSpace(*buf));
+  CHECK(IsTracked(*buf));
+
+  Page* page_before_gc = Page::FromAddress(buf->address());
+  page_before_gc->SetFlag(MemoryChunk::FORCE_EVACUATION_CANDIDATE_FOR_TESTING);
+  heap->CollectAllGarbage();
+  CHECK(IsTracked(*buf));
+  CHECK_NE(page_before_gc, Page::FromAddress(buf->address()));
+}
+
+TEST(ArrayBuffer_UnregisterDetachesFromPage) {
+  // Externalized backing stores are no longer owned by the page.
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = CcTest::heap();
+
+  v8::HandleScope handle_scope(isolate);
+  Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, 100);
+  Handle<JSArrayBuffer> buf = v8::Utils::OpenHandle(*ab);
+  CHECK(IsTracked(*buf));
+  v8::ArrayBuffer::Contents contents = ab->Externalize();
+  CHECK(!IsTracked(*buf));
+  heap->CollectAllGarbage();
+  CHECK(!IsTracked(*buf));
+  CcTest::array_buffer_allocator()->Free(contents.Data(),
+                                         contents.ByteLength());
+}
+
+TEST(ArrayBuffer_ConcurrentRelease) {
+  // Backing stores of dead buffers are accounted as freed at the end of the
+  // GC, even if the memory is released by a background task.
+  FLAG_concurrent_external_release = true;
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = CcTest::heap();
+
+  int64_t external_memory_before = heap->amount_of_external_allocated_memory();
+  {
+    v8::HandleScope handle_scope(isolate);
+    for (int i = 0; i < 100; i++) {
+      v8::ArrayBuffer::New(isolate, 1024);
+    }
+    CHECK_LE(external_memory_before + 100 * 1024,
+             heap->amount_of_external_allocated_memory());
+  }
+  heap->CollectAllGarbage();
+  heap->CollectAllGarbage();
+  CHECK_EQ(external_memory_before, heap->amount_of_external_allocated_memory());
+}
+
+}  // namespace internal
+}  // namespace v8
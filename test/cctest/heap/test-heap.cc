@@ -1248,6 +1248,82 @@ UNINITIALIZED_TEST(TestCodeFlushing) {
 }
 
 
+UNINITIALIZED_TEST(TestBytecodeFlushing) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  i::FLAG_ignition = true;
+  i::FLAG_flush_bytecode = true;
+  i::FLAG_always_opt = false;
+  i::FLAG_optimize_for_size = false;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  isolate->Enter();
+  Factory* factory = i_isolate->factory();
+  Heap* heap = i_isolate->heap();
+  {
+    v8::HandleScope scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    const char* source =
+        "function foo() {"
+        "  var x = 42;"
+        "  var y = 42;"
+        "  var z = x + y;"
+        "};"
+        "foo()";
+    Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+
+    {
+      v8::HandleScope scope(isolate);
+      CompileRun(source);
+    }
+
+    // Check function is interpreted.
+    Handle<Object> func_value = Object::GetProperty(i_isolate->global_object(),
+                                                    foo_name).ToHandleChecked();
+    CHECK(func_value->IsJSFunction());
+    Handle<JSFunction> function = Handle<JSFunction>::cast(func_value);
+    CHECK(function->shared()->HasBytecodeArray());
+
+    // Bytecode is only flushed by GCs that reduce memory, no matter how old
+    // it is.
+    const int kAgingThreshold = BytecodeArray::kIsOldBytecodeAge;
+    for (int i = 0; i < kAgingThreshold; i++) {
+      heap->CollectAllGarbage();
+    }
+    CHECK(function->shared()->HasBytecodeArray());
+    CHECK(function->shared()->bytecode_array()->IsOld());
+
+    heap->CollectAllGarbage(Heap::kReduceMemoryFootprintMask);
+    CHECK(!function->shared()->HasBytecodeArray());
+    CHECK(!function->shared()->is_compiled());
+    CHECK(!function->is_compiled());
+
+    // Call foo to get it recompiled.
+    CompileRun("foo()");
+    CHECK(function->shared()->HasBytecodeArray());
+    CHECK(function->is_compiled());
+
+    // Recently executed bytecode survives GCs that reduce memory.
+    heap->CollectAllGarbage(Heap::kReduceMemoryFootprintMask);
+    CHECK(function->shared()->HasBytecodeArray());
+    CHECK(function->is_compiled());
+
+    // Calling foo makes old bytecode young again, so it survives as well.
+    function->shared()->bytecode_array()->set_bytecode_age(kAgingThreshold);
+    CHECK(function->shared()->bytecode_array()->IsOld());
+    CompileRun("foo()");
+    CHECK(!function->shared()->bytecode_array()->IsOld());
+    heap->CollectAllGarbage(Heap::kReduceMemoryFootprintMask);
+    CHECK(function->shared()->HasBytecodeArray());
+    CHECK(function->is_compiled());
+  }
+  isolate->Exit();
+  isolate->Dispose();
+}
+
+
 TEST(TestCodeFlushingPreAged) {
   // If we do not flush code this test is invalid.
   if (!FLAG_flush_code) return;
@@ -4,6 +4,7 @@
 
 #include "src/v8.h"
 
+#include "src/compilation-cache.h"
 #include "src/execution.h"
 #include "src/handles.h"
 #include "src/interpreter/bytecode-array-builder.h"
@@ -913,6 +914,51 @@ TEST(InterpreterCall) { TestInterpreterCall(TailCallMode::kDisallow); }
 
 TEST(InterpreterTailCall) { TestInterpreterCall(TailCallMode::kAllow); }
 
+TEST(InterpreterCallFeedback) {
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+  i::Zone zone(isolate->allocator());
+
+  i::FeedbackVectorSpec feedback_spec(&zone);
+  i::FeedbackVectorSlot slot = feedback_spec.AddCallICSlot();
+
+  Handle<i::TypeFeedbackVector> vector =
+      i::NewTypeFeedbackVector(isolate, &feedback_spec);
+  int slot_index = vector->GetIndex(slot);
+
+  BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone(), 1,
+                               0, 1);
+  builder.LoadUndefined()
+      .StoreAccumulatorInRegister(Register(0))
+      .Call(builder.Parameter(0), Register(0), 1, slot_index)
+      .Return();
+  Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+  InterpreterTester tester(handles.main_isolate(), bytecode_array, vector);
+  auto callable = tester.GetCallable<Handle<Object>>();
+
+  i::CallICNexus nexus(vector, slot);
+  CHECK_EQ(i::UNINITIALIZED, nexus.StateFromFeedback());
+
+  Handle<Object> function1 =
+      InterpreterTester::NewObject("(function() { return 1; })");
+  Handle<Object> return_val = callable(function1).ToHandleChecked();
+  CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(1));
+  CHECK_EQ(i::MONOMORPHIC, nexus.StateFromFeedback());
+  CHECK_EQ(1, nexus.ExtractCallCount());
+
+  return_val = callable(function1).ToHandleChecked();
+  CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(1));
+  CHECK_EQ(i::MONOMORPHIC, nexus.StateFromFeedback());
+  CHECK_EQ(2, nexus.ExtractCallCount());
+
+  Handle<Object> function2 =
+      InterpreterTester::NewObject("(function() { return 2; })");
+  return_val = callable(function2).ToHandleChecked();
+  CHECK_EQ(Smi::cast(*return_val), Smi::FromInt(2));
+  CHECK_EQ(i::MEGAMORPHIC, nexus.StateFromFeedback());
+}
+
 static BytecodeArrayBuilder& SetRegister(BytecodeArrayBuilder& builder,
                                          Register reg, int value,
                                          Register scratch) {
@@ -4171,6 +4217,55 @@ TEST(InterpreterGenerators) {
   FLAG_ignition_generators = old_flag;
 }
 
+TEST(InterpreterLazySourcePositions) {
+  bool old_flag = FLAG_lazy_source_positions;
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+  // Both compilations below must really compile the same source.
+  isolate->compilation_cache()->Disable();
+
+  std::string source(InterpreterTester::SourceForBody(
+      "var a = 1;\n"
+      "var b = a + 2;\n"
+      "return b * 3;"));
+  std::string name = InterpreterTester::function_name();
+
+  Handle<ByteArray> eager_table;
+  {
+    FLAG_lazy_source_positions = false;
+    InterpreterTester tester(handles.main_isolate(), source.c_str());
+    auto callable = tester.GetCallable<>();
+    CHECK_EQ(Smi::FromInt(9), *callable().ToHandleChecked());
+    Handle<JSFunction> function = Handle<JSFunction>::cast(
+        InterpreterTester::NewObject(name.c_str()));
+    CHECK(function->shared()->bytecode_array()->HasSourcePositionTable());
+    eager_table =
+        handle(function->shared()->bytecode_array()->SourcePositionTable());
+  }
+
+  {
+    FLAG_lazy_source_positions = true;
+    InterpreterTester tester(handles.main_isolate(), source.c_str());
+    auto callable = tester.GetCallable<>();
+    CHECK_EQ(Smi::FromInt(9), *callable().ToHandleChecked());
+    Handle<JSFunction> function = Handle<JSFunction>::cast(
+        InterpreterTester::NewObject(name.c_str()));
+    Handle<SharedFunctionInfo> shared(function->shared());
+    CHECK(!shared->bytecode_array()->HasSourcePositionTable());
+
+    SharedFunctionInfo::EnsureSourcePositionsAvailable(shared);
+    CHECK(shared->bytecode_array()->HasSourcePositionTable());
+    ByteArray* lazy_table = shared->bytecode_array()->SourcePositionTable();
+    CHECK_EQ(eager_table->length(), lazy_table->length());
+    CHECK_EQ(0, memcmp(eager_table->GetDataStartAddress(),
+                       lazy_table->GetDataStartAddress(),
+                       eager_table->length()));
+  }
+
+  isolate->compilation_cache()->Enable();
+  FLAG_lazy_source_positions = old_flag;
+}
+
 
 }  // namespace interpreter
 }  // namespace internal
@@ -386,6 +386,8 @@ TEST(DisasmX64) {
     __ cvtsd2ss(xmm0, xmm1);
     __ cvtsd2ss(xmm0, Operand(rbx, rcx, times_4, 10000));
     __ movaps(xmm0, xmm1);
+    __ movups(xmm0, Operand(rbx, rcx, times_4, 10000));
+    __ movups(Operand(rbx, rcx, times_4, 10000), xmm0);
 
     // logic operation
     __ andps(xmm0, xmm1);
@@ -459,6 +461,9 @@ TEST(DisasmX64) {
 
     __ punpckldq(xmm1, xmm11);
     __ punpckhdq(xmm8, xmm15);
+
+    __ paddd(xmm1, xmm0);
+    __ psubd(xmm1, xmm11);
   }
 
   // cmov.
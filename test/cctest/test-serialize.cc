@@ -1810,6 +1810,114 @@ TEST(CodeSerializerEagerCompilationAndPreAge) {
   isolate2->Dispose();
 }
 
+// Returns the context-independent optimized code of the function {name} in
+// the script of {toplevel}, or a null handle if there is none.
+static Handle<Code> GetSharedOptimizedCode(Handle<SharedFunctionInfo> toplevel,
+                                           const char* name) {
+  Handle<Script> script(Script::cast(toplevel->script()));
+  WeakFixedArray::Iterator iterator(script->shared_function_infos());
+  while (SharedFunctionInfo* shared = iterator.Next<SharedFunctionInfo>()) {
+    if (!String::cast(shared->name())->IsUtf8EqualTo(CStrVector(name))) {
+      continue;
+    }
+    if (shared->OptimizedCodeMapIsCleared()) break;
+    WeakCell* cell = WeakCell::cast(shared->optimized_code_map()->get(
+        SharedFunctionInfo::kSharedCodeIndex));
+    if (cell->cleared()) break;
+    return handle(Code::cast(cell->value()));
+  }
+  return Handle<Code>::null();
+}
+
+TEST(CodeSerializerAfterExecuteWithOptimizedCode) {
+  if (FLAG_ignition) return;
+
+  FLAG_serialize_toplevel = true;
+  FLAG_serialize_optimized_code = true;
+  // Only functions compiled for the code cache can keep optimized code.
+  FLAG_serialize_eager = true;
+  FLAG_allow_natives_syntax = true;
+  FLAG_turbo = true;
+  FlagList::EnforceFlagImplications();
+
+  // The feedback of g and of the top-level code refers to maps and closures,
+  // which must not end up in the cache.
+  static const char* source =
+      "function g(o) { return o.x; }"
+      "function f(a, b) { return a + b; }"
+      "g({x: 1}); g({x: 2});"
+      "f(1, 2); f(3, 4);"
+      "%OptimizeFunctionOnNextCall(f);"
+      "f(5, 6);";
+
+  v8::ScriptCompiler::CachedData* cache;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate1, &source, v8::ScriptCompiler::kProduceCodeCache)
+            .ToLocalChecked();
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK_EQ(11, result->Int32Value(context).FromJust());
+
+    // Create the cache after the script ran and f was optimized.
+    CHECK(!GetSharedOptimizedCode(v8::Utils::OpenHandle(*script), "f")
+               .is_null());
+    cache = v8::ScriptCompiler::CreateCodeCache(script, source_str);
+    CHECK_NOT_NULL(cache);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    v8::Local<v8::UnboundScript> script;
+    {
+      DisallowCompilation no_compile(reinterpret_cast<Isolate*>(isolate2));
+      script = v8::ScriptCompiler::CompileUnboundScript(
+                   isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+                   .ToLocalChecked();
+    }
+    CHECK(!cache->rejected);
+
+    // The optimized code of f came with the cache.
+    HandleScope i_scope(reinterpret_cast<Isolate*>(isolate2));
+    Handle<Code> optimized_code =
+        GetSharedOptimizedCode(v8::Utils::OpenHandle(*script), "f");
+    CHECK(!optimized_code.is_null());
+    CHECK_EQ(Code::OPTIMIZED_FUNCTION, optimized_code->kind());
+
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK_EQ(11, result->Int32Value(context).FromJust());
+
+    // Optimizing f picked up that code instead of compiling it again.
+    Handle<JSFunction> f =
+        Handle<JSFunction>::cast(v8::Utils::OpenHandle(*CompileRun("f")));
+    CHECK(f->IsOptimized());
+    CHECK_EQ(*optimized_code, f->code());
+  }
+  isolate2->Dispose();
+}
+
 TEST(Regress503552) {
   // Test that the code serializer can deal with weak cells that form a linked
   // list during incremental marking.
@@ -1469,6 +1469,45 @@ TEST(InvalidExternalString) {
 }
 
 
+class DisposeCountingResource
+    : public v8::String::ExternalOneByteStringResource {
+ public:
+  explicit DisposeCountingResource(int* dispose_count)
+      : dispose_count_(dispose_count) {}
+  virtual const char* data() const { return "external"; }
+  virtual size_t length() const { return 8; }
+
+ protected:
+  virtual void Dispose() {
+    (*dispose_count_)++;
+    delete this;
+  }
+
+ private:
+  int* dispose_count_;
+};
+
+
+TEST(ExternalStringDisposedDuringGC) {
+  // Resources that do not declare Dispose as thread-safe are disposed during
+  // the GC, even if external resources are released concurrently.
+  FLAG_concurrent_external_release = true;
+  CcTest::InitializeVM();
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  int dispose_count = 0;
+  {
+    HandleScope scope(isolate);
+    isolate->factory()
+        ->NewExternalStringFromOneByte(
+            new DisposeCountingResource(&dispose_count))
+        .ToHandleChecked();
+  }
+  CcTest::heap()->CollectAllAvailableGarbage();
+  CHECK_EQ(1, dispose_count);
+}
+
+
 #define INVALID_STRING_TEST(FUN, TYPE)                                         \
   TEST(StringOOM##FUN) {                                                       \
     CcTest::InitializeVM();                                                    \
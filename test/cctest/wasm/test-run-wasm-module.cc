@@ -5,7 +5,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "src/parsing/preparse-data.h"
 #include "src/wasm/encoder.h"
+#include "src/wasm/module-decoder.h"
 #include "src/wasm/wasm-js.h"
 #include "src/wasm/wasm-macro-gen.h"
 #include "src/wasm/wasm-module.h"
@@ -27,6 +29,79 @@ void TestModule(WasmModuleIndex* module, int32_t expected_result) {
       CompileAndRunWasmModule(isolate, module->Begin(), module->End());
   CHECK_EQ(expected_result, result);
 }
+
+// Instantiates the module in a new isolate and runs its exported function
+// "main". The code cache is produced or consumed according to {options}.
+int32_t InstantiateAndRunInNewIsolate(
+    const byte* module_start, const byte* module_end, ScriptData** cached_data,
+    v8::ScriptCompiler::CompileOptions options) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* v8_isolate = v8::Isolate::New(create_params);
+  int32_t result = -1;
+  {
+    v8::Isolate::Scope isolate_scope(v8_isolate);
+    v8::HandleScope handle_scope(v8_isolate);
+    v8::Local<v8::Context> context = v8::Context::New(v8_isolate);
+    v8::Context::Scope context_scope(context);
+    Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+    WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+
+    Zone zone(isolate->allocator());
+    ModuleResult decoding_result = DecodeWasmModule(
+        isolate, &zone, module_start, module_end, false, kWasmOrigin);
+    CHECK(decoding_result.ok());
+    WasmModule* module = decoding_result.val;
+    Handle<JSObject> instance =
+        module
+            ->Instantiate(isolate, Handle<JSReceiver>::null(),
+                          Handle<JSArrayBuffer>::null(), cached_data, options)
+            .ToHandleChecked();
+    Handle<String> name = isolate->factory()->InternalizeUtf8String("main");
+    Handle<Object> main =
+        JSObject::GetProperty(instance, name).ToHandleChecked();
+    Handle<Object> undefined = isolate->factory()->undefined_value();
+    Handle<Object> retval =
+        Execution::Call(isolate, main, undefined, 0, nullptr).ToHandleChecked();
+    result = static_cast<int32_t>(retval->Number());
+    delete module;
+  }
+  v8_isolate->Dispose();
+  return result;
+}
+
+// Like InstantiateAndRunInNewIsolate, but goes through the public API.
+int32_t InstantiateThroughApiAndRunInNewIsolate(
+    const byte* module_start, const byte* module_end,
+    v8::ScriptCompiler::CachedData** cached_data,
+    v8::ScriptCompiler::CompileOptions options) {
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* v8_isolate = v8::Isolate::New(create_params);
+  int32_t result = -1;
+  {
+    v8::Isolate::Scope isolate_scope(v8_isolate);
+    v8::HandleScope handle_scope(v8_isolate);
+    v8::Local<v8::Context> context = v8::Context::New(v8_isolate);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Object> instance =
+        v8::WasmCompiledModule::Instantiate(
+            context, module_start,
+            static_cast<size_t>(module_end - module_start),
+            v8::Local<v8::Object>(), v8::Local<v8::ArrayBuffer>(), cached_data,
+            options)
+            .ToLocalChecked();
+    v8::Local<v8::Value> main =
+        instance->Get(context, v8_str("main")).ToLocalChecked();
+    v8::Local<v8::Value> retval =
+        v8::Local<v8::Function>::Cast(main)
+            ->Call(context, v8::Undefined(v8_isolate), 0, nullptr)
+            .ToLocalChecked();
+    result = retval->Int32Value(context).FromJust();
+  }
+  v8_isolate->Dispose();
+  return result;
+}
 }  // namespace
 
 TEST(Run_WasmModule_Return114) {
@@ -152,3 +227,133 @@ TEST(Run_WasmModule_Global) {
   WasmModuleWriter* writer = builder->Build(&zone);
   TestModule(writer->WriteTo(&zone), 97);
 }
+
+TEST(Run_WasmModule_SerializeAndDeserialize) {
+  static const byte kDataSegmentDest0 = 12;
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+  uint32_t global1 = builder->AddGlobal(MachineType::Int32(), 0);
+  uint32_t global2 = builder->AddGlobal(MachineType::Int32(), 0);
+  uint16_t f1_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f1_index);
+  f->ReturnType(kAstI32);
+  byte code1[] = {
+      WASM_I32_ADD(WASM_LOAD_GLOBAL(global1), WASM_LOAD_GLOBAL(global2))};
+  f->EmitCode(code1, sizeof(code1));
+  uint16_t f2_index = builder->AddFunction();
+  f = builder->FunctionAt(f2_index);
+  f->ReturnType(kAstI32);
+  f->Exported(1);
+  static const unsigned char kMain[] = "main";
+  f->SetName(kMain, 4);
+  byte code2[] = {
+      WASM_STORE_GLOBAL(global1, WASM_I32V_1(56)),
+      WASM_STORE_GLOBAL(global2, WASM_I32V_1(41)),
+      WASM_RETURN1(WASM_I32_ADD(
+          WASM_CALL_FUNCTION0(f1_index),
+          WASM_LOAD_MEM(MachineType::Int32(), WASM_I8(kDataSegmentDest0))))};
+  f->EmitCode(code2, sizeof(code2));
+  byte data[] = {1, 0, 0, 0};
+  builder->AddDataSegment(new (&zone) WasmDataSegmentEncoder(
+      &zone, data, sizeof(data), kDataSegmentDest0));
+  WasmModuleIndex* module = builder->Build(&zone)->WriteTo(&zone);
+
+  ScriptData* cached_data = nullptr;
+  CHECK_EQ(98, InstantiateAndRunInNewIsolate(
+                   module->Begin(), module->End(), &cached_data,
+                   v8::ScriptCompiler::kProduceCodeCache));
+  CHECK_NOT_NULL(cached_data);
+
+  // The memory and the globals of the new instance are at different
+  // addresses, so the deserialized code has to be relocated.
+  CHECK_EQ(98, InstantiateAndRunInNewIsolate(
+                   module->Begin(), module->End(), &cached_data,
+                   v8::ScriptCompiler::kConsumeCodeCache));
+  CHECK(!cached_data->rejected());
+  delete cached_data;
+}
+
+TEST(Run_WasmModule_SerializeAndDeserializeThroughApi) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+  uint32_t global = builder->AddGlobal(MachineType::Int32(), 0);
+  uint16_t f_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f_index);
+  f->ReturnType(kAstI32);
+  f->Exported(1);
+  static const unsigned char kMain[] = "main";
+  f->SetName(kMain, 4);
+  byte code[] = {WASM_STORE_GLOBAL(global, WASM_I32V_1(42)),
+                 WASM_RETURN1(WASM_LOAD_GLOBAL(global))};
+  f->EmitCode(code, sizeof(code));
+  WasmModuleIndex* module = builder->Build(&zone)->WriteTo(&zone);
+
+  v8::ScriptCompiler::CachedData* cached_data = nullptr;
+  CHECK_EQ(42, InstantiateThroughApiAndRunInNewIsolate(
+                   module->Begin(), module->End(), &cached_data,
+                   v8::ScriptCompiler::kProduceCodeCache));
+  CHECK_NOT_NULL(cached_data);
+  CHECK_LT(0, cached_data->length);
+
+  CHECK_EQ(42, InstantiateThroughApiAndRunInNewIsolate(
+                   module->Begin(), module->End(), &cached_data,
+                   v8::ScriptCompiler::kConsumeCodeCache));
+  CHECK(!cached_data->rejected);
+  delete cached_data;
+}
+
+TEST(Run_WasmModule_CompileInParallel) {
+  // f0(x) = x + 1 and fi(x) = f{i-1}(x) * 3 + i, so every function calls the
+  // one compiled before it.
+  static const int kNumFunctions = 50;
+  static const int32_t kArgument = 7;
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+  uint32_t expected = static_cast<uint32_t>(kArgument) + 1;
+  uint16_t f_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f_index);
+  f->ReturnType(kAstI32);
+  uint16_t param = f->AddParam(kAstI32);
+  byte code0[] = {WASM_I32_ADD(WASM_GET_LOCAL(param), WASM_I8(1))};
+  f->EmitCode(code0, sizeof(code0));
+  for (int i = 1; i < kNumFunctions; ++i) {
+    uint16_t previous = f_index;
+    f_index = builder->AddFunction();
+    f = builder->FunctionAt(f_index);
+    f->ReturnType(kAstI32);
+    param = f->AddParam(kAstI32);
+    byte code[] = {WASM_I32_ADD(
+        WASM_I32_MUL(WASM_CALL_FUNCTION1(previous, WASM_GET_LOCAL(param)),
+                     WASM_I8(3)),
+        WASM_I8(i))};
+    f->EmitCode(code, sizeof(code));
+    expected = expected * 3 + i;
+  }
+  uint16_t main_index = builder->AddFunction();
+  f = builder->FunctionAt(main_index);
+  f->ReturnType(kAstI32);
+  f->Exported(1);
+  static const unsigned char kMain[] = "main";
+  f->SetName(kMain, 4);
+  byte code[] = {WASM_CALL_FUNCTION1(f_index, WASM_I8(kArgument))};
+  f->EmitCode(code, sizeof(code));
+  WasmModuleIndex* module = builder->Build(&zone)->WriteTo(&zone);
+
+  // Sequential and overlapped compilation have to produce the same code.
+  ScriptData* cached_data = nullptr;
+  FLAG_wasm_num_compilation_tasks = 0;
+  int32_t sequential_result = InstantiateAndRunInNewIsolate(
+      module->Begin(), module->End(), &cached_data,
+      v8::ScriptCompiler::kNoCompileOptions);
+  CHECK_EQ(static_cast<int32_t>(expected), sequential_result);
+  FLAG_wasm_num_compilation_tasks = 4;
+  int32_t parallel_result = InstantiateAndRunInNewIsolate(
+      module->Begin(), module->End(), &cached_data,
+      v8::ScriptCompiler::kNoCompileOptions);
+  FLAG_wasm_num_compilation_tasks = 0;
+  CHECK_EQ(sequential_result, parallel_result);
+  CHECK_NULL(cached_data);
+}
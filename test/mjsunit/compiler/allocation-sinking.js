@@ -0,0 +1,24 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --experimental-turbo-escape
+// Flags: --turbo-allocation-sinking
+
+var escaped = [];
+
+function f(x, fail) {
+  var o = { x: x, y: x + 1 };
+  if (fail) escaped.push(o);
+  return x;
+}
+
+assertEquals(1, f(1, false));
+assertEquals(2, f(2, false));
+%OptimizeFunctionOnNextCall(f);
+assertEquals(3, f(3, false));
+assertEquals(0, escaped.length);
+assertEquals(4, f(4, true));
+assertEquals(1, escaped.length);
+assertEquals(4, escaped[0].x);
+assertEquals(5, escaped[0].y);
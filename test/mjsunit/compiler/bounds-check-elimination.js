@@ -0,0 +1,83 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --turbo-bounds-check-elimination
+// Flags: --turbo-induction-variables
+
+(function LoopBoundedByLength() {
+  function sum(a) {
+    var s = 0;
+    for (var i = 0; i < a.length; i++) s += a[i];
+    return s;
+  }
+  assertEquals(6, sum([1, 2, 3]));
+  assertEquals(10, sum([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(15, sum([1, 2, 3, 4, 5]));
+  assertEquals(0, sum([]));
+})();
+
+(function LoopBoundedByTypedArrayLength() {
+  function sum(a) {
+    var s = 0;
+    for (var i = 0; i < a.length; i++) s += a[i];
+    return s;
+  }
+  assertEquals(6, sum(new Int32Array([1, 2, 3])));
+  assertEquals(10, sum(new Int32Array([1, 2, 3, 4])));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(15, sum(new Int32Array([1, 2, 3, 4, 5])));
+  assertEquals(0, sum(new Int32Array(0)));
+})();
+
+(function CheckedIndex() {
+  function get(a, i) {
+    if (i < a.length) return a[i];
+    return -1;
+  }
+  assertEquals(1, get([1, 2], 0));
+  assertEquals(2, get([1, 2], 1));
+  %OptimizeFunctionOnNextCall(get);
+  assertEquals(2, get([1, 2], 1));
+  assertEquals(-1, get([1, 2], 2));
+})();
+
+(function LoopOneElementPastTheEnd() {
+  // The last iteration reads past the end, so its check must stay.
+  function sum(a) {
+    var s = 0;
+    for (var i = 0; i <= a.length; i++) s += a[i] | 0;
+    return s;
+  }
+  assertEquals(6, sum([1, 2, 3]));
+  assertEquals(6, sum([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(6, sum([1, 2, 3]));
+})();
+
+(function UncheckedIndex() {
+  function get(a, i) { return a[i]; }
+  assertEquals(1, get([1, 2], 0));
+  assertEquals(2, get([1, 2], 1));
+  %OptimizeFunctionOnNextCall(get);
+  assertEquals(2, get([1, 2], 1));
+  assertEquals(undefined, get([1, 2], 2));
+})();
+
+(function LengthChangedAfterCheck() {
+  // The length is written between the check and the access, so the access
+  // has to check the new length.
+  function get(a, i) {
+    if (i < a.length) {
+      a.length = i;
+      return a[i];
+    }
+    return -1;
+  }
+  assertEquals(undefined, get([1, 2], 1));
+  assertEquals(undefined, get([1, 2], 0));
+  %OptimizeFunctionOnNextCall(get);
+  assertEquals(undefined, get([1, 2], 1));
+  assertEquals(-1, get([1, 2], 2));
+})();
@@ -0,0 +1,51 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-polymorphic-inlining
+
+// Polymorphic method calls dispatch on the loaded target.
+function A() {}
+A.prototype.f = function(x) { return x + 1; };
+function B() {}
+B.prototype.f = function(x) { return x * 2; };
+function C() {}
+C.prototype.f = function(x) { throw x; };
+
+function call(o, x) { return o.f(x); }
+
+var a = new A();
+var b = new B();
+assertEquals(2, call(a, 1));
+assertEquals(4, call(b, 2));
+%OptimizeFunctionOnNextCall(call);
+assertEquals(3, call(a, 2));
+assertEquals(6, call(b, 3));
+
+// Exceptions thrown by one of the targets reach the handler.
+function tryCall(o, x) {
+  try {
+    return o.f(x);
+  } catch (e) {
+    return -e;
+  }
+}
+
+var c = new C();
+assertEquals(2, tryCall(a, 1));
+assertEquals(-3, tryCall(c, 3));
+%OptimizeFunctionOnNextCall(tryCall);
+assertEquals(3, tryCall(a, 2));
+assertEquals(-4, tryCall(c, 4));
+
+// Calls through a phi of closures.
+function select(p, x) {
+  var g = p ? function(y) { return y - 1; } : function(y) { return y + 1; };
+  return g(x);
+}
+
+assertEquals(0, select(true, 1));
+assertEquals(2, select(false, 1));
+%OptimizeFunctionOnNextCall(select);
+assertEquals(1, select(true, 2));
+assertEquals(3, select(false, 2));
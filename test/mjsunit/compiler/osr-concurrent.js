@@ -0,0 +1,50 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --use-osr --concurrent-recompilation
+// Flags: --concurrent-osr
+
+// The optimization count goes up when a loop picks up its finished OSR job,
+// right before it enters the optimized code. Without Crankshaft (status 4)
+// there is nothing to wait for.
+function OsrDone(f) {
+  return %GetOptimizationCount(f) > 0 || %GetOptimizationStatus(f) == 4;
+}
+
+// Upper bound on the iterations spent waiting for the OSR job, so that the
+// test fails instead of timing out if the job is aborted.
+var kMaxIterations = 10000000;
+
+// The loop keeps running unoptimized code while the OSR job is compiled in
+// the background, and enters the optimized code on a later iteration. It
+// runs for at least {n} iterations and until that happened.
+function f(n) {
+  var sum = 0;
+  for (var i = 0; i < n || (!OsrDone(f) && i < kMaxIterations); i++) {
+    if (i == 10) %OptimizeOsr();
+    sum += i;
+  }
+  assertEquals(i * (i - 1) / 2, sum);
+  return i;
+}
+
+assertTrue(f(10000) >= 10000);
+assertTrue(OsrDone(f));
+assertEquals(1000000, f(1000000));
+
+// Nested loops pick up the code for the loop that requested it.
+function g(n) {
+  var sum = 0;
+  for (var i = 0; i < n || (!OsrDone(g) && i * n < kMaxIterations); i++) {
+    for (var j = 0; j < n; j++) {
+      if (i == 1 && j == 1) %OptimizeOsr();
+      sum += j;
+    }
+  }
+  assertEquals(i * n * (n - 1) / 2, sum);
+  return i;
+}
+
+assertTrue(g(1000) >= 1000);
+assertTrue(OsrDone(g));
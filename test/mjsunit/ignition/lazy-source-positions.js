@@ -0,0 +1,34 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --lazy-source-positions --no-turbo
+
+function f(x) {
+  if (x == 0) {
+    return new Error().stack;
+  }
+  return f(x - 1);
+}
+
+var stack_lines = f(2).split("\n");
+
+assertTrue(/at f \(.*?:9:12\)/.test(stack_lines[1]));
+assertTrue(/at f \(.*?:11:10\)/.test(stack_lines[2]));
+assertTrue(/at f \(.*?:11:10\)/.test(stack_lines[3]));
+
+// Positions collected for the stack trace above are reused.
+stack_lines = f(1).split("\n");
+assertTrue(/at f \(.*?:9:12\)/.test(stack_lines[1]));
+assertTrue(/at f \(.*?:11:10\)/.test(stack_lines[2]));
+
+function g(o) {
+  return o.x.y;
+}
+
+try {
+  g({});
+  assertUnreachable();
+} catch (e) {
+  assertTrue(/at g \(.*?:26:\d+\)/.test(e.stack.split("\n")[1]));
+}
@@ -0,0 +1,54 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-peephole --ignition-reo
+
+function swap(a, b) {
+  var t = a;
+  a = b;
+  b = t;
+  return [a, b, t];
+}
+assertEquals([2, 1, 1], swap(1, 2));
+
+function chain(x) {
+  var a = x;
+  var b = a;
+  var c = b;
+  a = 1;
+  return a + b + c;
+}
+assertEquals(5, chain(2));
+
+function branches(x) {
+  var y = x;
+  if (x > 0) {
+    y = x + 1;
+  }
+  var z = y;
+  return z;
+}
+assertEquals(3, branches(2));
+assertEquals(-1, branches(-1));
+
+function caught(x) {
+  var y = 0;
+  try {
+    y = x;
+    throw y;
+  } catch (e) {
+    return e + y;
+  }
+}
+assertEquals(6, caught(3));
+
+function* gen(x) {
+  var a = x;
+  yield a;
+  var b = a;
+  yield b + 1;
+}
+var g = gen(4);
+assertEquals(4, g.next().value);
+assertEquals(5, g.next().value);
@@ -0,0 +1,48 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --ignition-superinstructions --turbo-from-bytecode
+// Flags: --allow-natives-syntax
+
+function count(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    var undef;
+    if (undef === undefined) sum += i;
+  }
+  return sum;
+}
+assertEquals(45, count(10));
+assertEquals(45, count(10));
+%OptimizeFunctionOnNextCall(count);
+assertEquals(45, count(10));
+
+function strict(a, b) {
+  if (a === b) return 1;
+  if (a !== b) return 2;
+  return 3;
+}
+assertEquals(1, strict(1, 1));
+assertEquals(2, strict(1, "1"));
+assertEquals(2, strict(NaN, NaN));
+%OptimizeFunctionOnNextCall(strict);
+assertEquals(1, strict("a", "a"));
+assertEquals(2, strict({}, {}));
+
+function value(a, b) {
+  var r = (a === b) || 0;
+  return r;
+}
+assertEquals(true, value(1, 1));
+assertEquals(0, value(1, 2));
+
+function* gen() {
+  var x = 0;
+  yield x;
+  var y;
+  yield y === undefined;
+}
+var g = gen();
+assertEquals(0, g.next().value);
+assertEquals(true, g.next().value);
@@ -0,0 +1,40 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --turbo-from-bytecode --allow-natives-syntax
+
+function add(a, b) { return a + b; }
+
+function callAdd(a, b) { return add(a, b); }
+
+// Collect monomorphic call feedback in the interpreter and optimize from it.
+assertEquals(3, callAdd(1, 2));
+assertEquals(5, callAdd(2, 3));
+%OptimizeFunctionOnNextCall(callAdd);
+assertEquals(7, callAdd(3, 4));
+assertOptimized(callAdd);
+
+// Deoptimize back to the interpreter on unexpected input.
+assertEquals("ab", callAdd("a", "b"));
+assertEquals(9, callAdd(4, 5));
+
+function callTarget(f) { return f(); }
+
+function one() { return 1; }
+function two() { return 2; }
+
+// Megamorphic call sites still produce correct results once optimized.
+assertEquals(1, callTarget(one));
+assertEquals(2, callTarget(two));
+assertEquals(1, callTarget(one));
+%OptimizeFunctionOnNextCall(callTarget);
+assertEquals(2, callTarget(two));
+
+// Calls to the Array function record an allocation site.
+function makeArray(n) { return Array(n); }
+
+assertEquals(3, makeArray(3).length);
+assertEquals(4, makeArray(4).length);
+%OptimizeFunctionOnNextCall(makeArray);
+assertEquals(5, makeArray(5).length);
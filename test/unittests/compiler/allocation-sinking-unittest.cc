@@ -0,0 +1,149 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/allocation-sinking.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/factory.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class AllocationSinkingTest : public GraphTest {
+ public:
+  AllocationSinkingTest() : GraphTest(3), simplified_(zone()) {}
+  ~AllocationSinkingTest() override {}
+
+ protected:
+  struct Region {
+    Node* allocate;
+    Node* store;
+    Node* finish;
+  };
+
+  // Builds an allocation region of a single field object on the start node.
+  Region BuildRegion() {
+    Node* begin = graph()->NewNode(common()->BeginRegion(), start());
+    Node* allocate = graph()->NewNode(simplified()->Allocate(),
+                                      NumberConstant(kPointerSize), begin,
+                                      start());
+    Node* store =
+        graph()->NewNode(simplified()->StoreField(AccessBuilder::ForMap()),
+                         allocate, HeapConstant(factory()->fixed_array_map()),
+                         allocate, start());
+    Node* finish =
+        graph()->NewNode(common()->FinishRegion(), allocate, store);
+    return {allocate, store, finish};
+  }
+
+  // Stores {value} into the object passed as the second parameter.
+  Node* Escape(Node* value, Node* effect, Node* control) {
+    return graph()->NewNode(
+        simplified()->StoreField(AccessBuilder::ForJSObjectProperties()),
+        Parameter(1), value, effect, control);
+  }
+
+  size_t Sink() {
+    AllocationSinking allocation_sinking(graph(), zone());
+    allocation_sinking.Run();
+    return allocation_sinking.sunk_count();
+  }
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(AllocationSinkingTest, EscapeInOneArm) {
+  Region region = BuildRegion();
+  Node* branch = graph()->NewNode(common()->Branch(), Parameter(0), start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* escape = Escape(region.finish, region.finish, if_true);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* effect_phi = graph()->NewNode(common()->EffectPhi(2), escape,
+                                      region.finish, merge);
+  Node* ret =
+      graph()->NewNode(common()->Return(), Int32Constant(0), effect_phi, merge);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  EXPECT_EQ(1u, Sink());
+  EXPECT_EQ(if_true, NodeProperties::GetControlInput(region.allocate));
+  EXPECT_EQ(if_true, NodeProperties::GetControlInput(region.store));
+  EXPECT_EQ(region.finish, NodeProperties::GetEffectInput(escape));
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(effect_phi, 1));
+}
+
+
+TEST_F(AllocationSinkingTest, EscapeInBothArms) {
+  Region region = BuildRegion();
+  Node* branch = graph()->NewNode(common()->Branch(), Parameter(0), start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* escape_true = Escape(region.finish, region.finish, if_true);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* escape_false = Escape(region.finish, region.finish, if_false);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* effect_phi = graph()->NewNode(common()->EffectPhi(2), escape_true,
+                                      escape_false, merge);
+  Node* ret =
+      graph()->NewNode(common()->Return(), Int32Constant(0), effect_phi, merge);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  EXPECT_EQ(0u, Sink());
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(region.allocate));
+}
+
+
+TEST_F(AllocationSinkingTest, EscapeAfterMerge) {
+  Region region = BuildRegion();
+  Node* branch = graph()->NewNode(common()->Branch(), Parameter(0), start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* effect_phi = graph()->NewNode(common()->EffectPhi(2), region.finish,
+                                      region.finish, merge);
+  Node* escape = Escape(region.finish, effect_phi, merge);
+  Node* ret =
+      graph()->NewNode(common()->Return(), Int32Constant(0), escape, merge);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  EXPECT_EQ(0u, Sink());
+}
+
+
+TEST_F(AllocationSinkingTest, ConsecutiveRegions) {
+  Region first = BuildRegion();
+  Node* begin = graph()->NewNode(common()->BeginRegion(), first.finish);
+  Node* allocate =
+      graph()->NewNode(simplified()->Allocate(), NumberConstant(kPointerSize),
+                       begin, start());
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSObjectProperties()),
+      allocate, first.finish, allocate, start());
+  Node* second = graph()->NewNode(common()->FinishRegion(), allocate, store);
+  Node* branch = graph()->NewNode(common()->Branch(), Parameter(0), start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* escape = Escape(second, second, if_false);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), second, escape, merge);
+  Node* ret =
+      graph()->NewNode(common()->Return(), Int32Constant(0), effect_phi, merge);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  EXPECT_EQ(2u, Sink());
+  EXPECT_EQ(if_false, NodeProperties::GetControlInput(first.allocate));
+  EXPECT_EQ(if_false, NodeProperties::GetControlInput(allocate));
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(effect_phi, 0));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
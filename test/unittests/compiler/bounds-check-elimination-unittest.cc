@@ -0,0 +1,207 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/bounds-check-elimination.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class BoundsCheckEliminationTest : public TypedGraphTest {
+ public:
+  BoundsCheckEliminationTest()
+      : TypedGraphTest(3), javascript_(zone()), simplified_(zone()) {}
+  ~BoundsCheckEliminationTest() override {}
+
+ protected:
+  void Reduce() {
+    GraphReducer graph_reducer(zone(), graph());
+    BoundsCheckElimination bounds_check_elimination(&graph_reducer);
+    graph_reducer.AddReducer(&bounds_check_elimination);
+    graph_reducer.ReduceGraph();
+  }
+
+  // Builds a check that deoptimizes unless {condition} holds, and returns
+  // from the function after the check.
+  Node* CheckAndReturn(Node* condition, Node* effect, Node* control) {
+    Node* check =
+        graph()->NewNode(common()->DeoptimizeUnless(), condition,
+                         EmptyFrameState(), effect, control);
+    Node* ret = graph()->NewNode(common()->Return(), Int32Constant(0), effect,
+                                 check);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return ret;
+  }
+
+  Node* LoadLength(Node* array, Node* effect, Node* control) {
+    return graph()->NewNode(
+        simplified()->LoadField(AccessBuilder::ForJSArrayLength(FAST_ELEMENTS)),
+        array, effect, control);
+  }
+
+  JSOperatorBuilder* javascript() { return &javascript_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  JSOperatorBuilder javascript_;
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(BoundsCheckEliminationTest, DominatedBySameCondition) {
+  Node* index = Parameter(Type::Unsigned31(), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* check =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length);
+  Node* ret = CheckAndReturn(check, start(), if_true);
+
+  Reduce();
+
+  EXPECT_EQ(if_true, NodeProperties::GetControlInput(ret));
+}
+
+
+TEST_F(BoundsCheckEliminationTest, DominatedByNegatedCondition) {
+  Node* index = Parameter(Type::Unsigned31(), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThanOrEqual(), length, index);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, start());
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* check =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length);
+  Node* ret = CheckAndReturn(check, start(), if_false);
+
+  Reduce();
+
+  EXPECT_EQ(if_false, NodeProperties::GetControlInput(ret));
+}
+
+
+TEST_F(BoundsCheckEliminationTest, NotDominatedOnAllPaths) {
+  Node* index = Parameter(Type::Unsigned31(), 0);
+  Node* length = Parameter(Type::Unsigned31(), 1);
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* check =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length);
+  Node* ret = CheckAndReturn(check, start(), merge);
+
+  Reduce();
+
+  EXPECT_EQ(IrOpcode::kDeoptimizeUnless,
+            NodeProperties::GetControlInput(ret)->opcode());
+}
+
+
+TEST_F(BoundsCheckEliminationTest, ReloadedLength) {
+  Node* array = Parameter(Type::Any(), 0);
+  Node* index = Parameter(Type::Unsigned31(), 1);
+  Node* length1 = LoadLength(array, start(), start());
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length1);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* map = graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                               array, length1, if_true);
+  Node* length2 = LoadLength(array, map, if_true);
+  Node* check =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length2);
+  Node* ret = CheckAndReturn(check, length2, if_true);
+
+  Reduce();
+
+  EXPECT_EQ(if_true, NodeProperties::GetControlInput(ret));
+}
+
+
+TEST_F(BoundsCheckEliminationTest, ReloadedLengthAfterStore) {
+  Node* array = Parameter(Type::Any(), 0);
+  Node* index = Parameter(Type::Unsigned31(), 1);
+  Node* length1 = LoadLength(array, start(), start());
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length1);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSArrayLength(FAST_ELEMENTS)),
+      array, NumberConstant(0), length1, if_true);
+  Node* length2 = LoadLength(array, store, if_true);
+  Node* check =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length2);
+  Node* ret = CheckAndReturn(check, length2, if_true);
+
+  Reduce();
+
+  EXPECT_EQ(IrOpcode::kDeoptimizeUnless,
+            NodeProperties::GetControlInput(ret)->opcode());
+}
+
+
+TEST_F(BoundsCheckEliminationTest, ReloadedLengthAfterStackCheck) {
+  Node* array = Parameter(Type::Any(), 0);
+  Node* index = Parameter(Type::Unsigned31(), 1);
+  Node* context = Parameter(2);
+  Node* length1 = LoadLength(array, start(), start());
+  Node* condition =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length1);
+  Node* branch = graph()->NewNode(common()->Branch(), condition, start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  // An interrupt may run code that changes the length.
+  Node* stack_check =
+      graph()->NewNode(javascript()->StackCheck(), context, EmptyFrameState(),
+                       length1, if_true);
+  Node* length2 = LoadLength(array, stack_check, if_true);
+  Node* check =
+      graph()->NewNode(simplified()->NumberLessThan(), index, length2);
+  Node* ret = CheckAndReturn(check, length2, if_true);
+
+  Reduce();
+
+  EXPECT_EQ(IrOpcode::kDeoptimizeUnless,
+            NodeProperties::GetControlInput(ret)->opcode());
+}
+
+
+TEST_F(BoundsCheckEliminationTest, Uint32ConversionOfUnsigned32) {
+  Node* index = Parameter(Type::Unsigned31(), 0);
+  Node* index32 = graph()->NewNode(simplified()->NumberToUint32(), index);
+  Node* check = graph()->NewNode(simplified()->NumberEqual(), index32, index);
+  Node* ret = CheckAndReturn(check, start(), start());
+
+  Reduce();
+
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(ret));
+}
+
+
+TEST_F(BoundsCheckEliminationTest, Uint32ConversionOfNumber) {
+  Node* index = Parameter(Type::Number(), 0);
+  Node* index32 = graph()->NewNode(simplified()->NumberToUint32(), index);
+  Node* check = graph()->NewNode(simplified()->NumberEqual(), index32, index);
+  Node* ret = CheckAndReturn(check, start(), start());
+
+  Reduce();
+
+  EXPECT_EQ(IrOpcode::kDeoptimizeUnless,
+            NodeProperties::GetControlInput(ret)->opcode());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,202 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/frame.h"
+#include "src/compiler/greedy-allocator.h"
+#include "test/unittests/compiler/instruction-sequence-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class GreedyAllocatorTest : public InstructionSequenceTest {
+ public:
+  GreedyAllocatorTest() : data_(nullptr), allocator_(nullptr) {}
+
+ protected:
+  // Builds the live ranges of the sequence and a greedy allocator for the
+  // general registers, but does not allocate any registers.
+  void BuildAllocator() {
+    WireBlocks();
+    Frame* frame = new (zone()) Frame(0);
+    data_ = new (zone())
+        RegisterAllocationData(config(), zone(), frame, sequence());
+    ConstraintBuilder constraint_builder(data_);
+    constraint_builder.MeetRegisterConstraints();
+    constraint_builder.ResolvePhis();
+    LiveRangeBuilder live_range_builder(data_, zone());
+    live_range_builder.BuildLiveRanges();
+    allocator_ = new (zone()) GreedyAllocator(data_, GENERAL_REGISTERS, zone());
+    allocator_->ComputeLoopDepths();
+  }
+
+  RegisterAllocationData* data() const { return data_; }
+
+  int LoopDepth(int rpo) const {
+    return allocator_->loop_depths_[static_cast<size_t>(rpo)];
+  }
+
+  int FirstInstructionIndex(int rpo) {
+    return sequence()
+        ->InstructionBlockAt(RpoNumber::FromInt(rpo))
+        ->first_instruction_index();
+  }
+
+  float UseWeight(int instruction_index,
+                  UnallocatedOperand::ExtendedPolicy policy) const {
+    UnallocatedOperand operand(policy, 0);
+    UsePosition pos(
+        LifetimePosition::InstructionFromInstructionIndex(instruction_index),
+        &operand, nullptr, UsePositionHintType::kNone);
+    return allocator_->GetUseWeight(&pos);
+  }
+
+  bool TrySpillUntilFirstRegisterUse(LiveRange* range) {
+    return allocator_->TrySpillUntilFirstRegisterUse(range);
+  }
+
+  // Returns the next range the allocator would try to allocate, or nullptr.
+  LiveRange* NextScheduledRange() {
+    if (allocator_->scheduler().empty()) return nullptr;
+    return allocator_->scheduler().GetNext().live_range();
+  }
+
+ private:
+  RegisterAllocationData* data_;
+  GreedyAllocator* allocator_;
+};
+
+
+TEST_F(GreedyAllocatorTest, ComputeLoopDepths) {
+  StartBlock();
+  EndBlock();
+
+  {
+    StartLoop(2);
+    StartBlock();
+    EndBlock(Branch(Reg(DefineConstant()), 1, 2));
+    StartBlock();
+    EndBlock(Jump(-1));
+    EndLoop();
+  }
+
+  {
+    StartLoop(1);
+    StartBlock();
+    EndBlock(Branch(Reg(DefineConstant()), 0, 1));
+    EndLoop();
+  }
+
+  StartBlock();
+  Return(DefineConstant());
+  EndBlock();
+
+  BuildAllocator();
+
+  EXPECT_EQ(0, LoopDepth(0));
+  EXPECT_EQ(1, LoopDepth(1));
+  EXPECT_EQ(1, LoopDepth(2));
+  // The second loop starts right after the end of the first one.
+  EXPECT_EQ(1, LoopDepth(3));
+  EXPECT_EQ(0, LoopDepth(4));
+  // The end block added by WireBlocks.
+  EXPECT_EQ(0, LoopDepth(5));
+}
+
+
+TEST_F(GreedyAllocatorTest, GetUseWeight) {
+  StartBlock();
+  VReg value = Define(Reg());
+  EndBlock();
+
+  {
+    StartLoop(2);
+    StartBlock();
+    EndBlock(Branch(Reg(DefineConstant()), 1, 2));
+    StartBlock();
+    EmitI(Reg(value));
+    EndBlock(Jump(-1));
+    EndLoop();
+  }
+
+  StartBlock();
+  Return(value);
+  EndBlock();
+
+  BuildAllocator();
+
+  int outside_loop = FirstInstructionIndex(0);
+  int inside_loop = FirstInstructionIndex(2);
+  EXPECT_FLOAT_EQ(
+      1.0f, UseWeight(outside_loop, UnallocatedOperand::MUST_HAVE_REGISTER));
+  EXPECT_FLOAT_EQ(0.5f, UseWeight(outside_loop, UnallocatedOperand::ANY));
+  EXPECT_FLOAT_EQ(0.5f,
+                  UseWeight(outside_loop, UnallocatedOperand::MUST_HAVE_SLOT));
+  // Uses inside a loop are ten times as expensive to spill.
+  EXPECT_FLOAT_EQ(
+      10.0f, UseWeight(inside_loop, UnallocatedOperand::MUST_HAVE_REGISTER));
+  EXPECT_FLOAT_EQ(5.0f, UseWeight(inside_loop, UnallocatedOperand::ANY));
+}
+
+
+TEST_F(GreedyAllocatorTest, SpillUntilFirstRegisterUse) {
+  StartBlock();
+  VReg value = Define(Reg());
+  int def_index = sequence()->LastInstructionIndex();
+  for (int i = 0; i < 4; ++i) EmitNop();
+  EmitI(Reg(value));
+  int use_index = sequence()->LastInstructionIndex();
+  Return(DefineConstant());
+  EndBlock(Last());
+
+  BuildAllocator();
+
+  // The part of the range after its definition does not need a register
+  // until the use.
+  LiveRange* range = data()->live_ranges()[value.value_]->SplitAt(
+      LifetimePosition::GapFromInstructionIndex(def_index + 1), zone());
+  EXPECT_TRUE(TrySpillUntilFirstRegisterUse(range));
+
+  LifetimePosition split_pos =
+      LifetimePosition::GapFromInstructionIndex(use_index);
+  EXPECT_TRUE(range->spilled());
+  EXPECT_EQ(split_pos, range->End());
+
+  // The rest of the range is requeued for allocation.
+  LiveRange* tail = NextScheduledRange();
+  ASSERT_NE(nullptr, tail);
+  EXPECT_EQ(range->next(), tail);
+  EXPECT_EQ(split_pos, tail->Start());
+  EXPECT_FALSE(tail->spilled());
+  EXPECT_EQ(nullptr, NextScheduledRange());
+}
+
+
+TEST_F(GreedyAllocatorTest, DoNotSpillRangeNeedingRegisterAtStart) {
+  StartBlock();
+  VReg value = Define(Reg());
+  for (int i = 0; i < 4; ++i) EmitNop();
+  EmitI(Reg(value));
+  int use_index = sequence()->LastInstructionIndex();
+  Return(DefineConstant());
+  EndBlock(Last());
+
+  BuildAllocator();
+
+  // The definition needs a register.
+  TopLevelLiveRange* range = data()->live_ranges()[value.value_];
+  EXPECT_FALSE(TrySpillUntilFirstRegisterUse(range));
+  EXPECT_FALSE(range->spilled());
+
+  // So does the use at the start of the last part of the range.
+  LiveRange* tail = range->SplitAt(
+      LifetimePosition::GapFromInstructionIndex(use_index), zone());
+  EXPECT_FALSE(TrySpillUntilFirstRegisterUse(tail));
+  EXPECT_FALSE(tail->spilled());
+  EXPECT_EQ(nullptr, NextScheduledRange());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
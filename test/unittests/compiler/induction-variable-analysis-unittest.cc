@@ -0,0 +1,220 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <functional>
+
+#include "src/compiler/induction-variable-analysis.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/compiler/typer.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class InductionVariableAnalysisTest : public TypedGraphTest {
+ public:
+  InductionVariableAnalysisTest() : TypedGraphTest(3), simplified_(zone()) {}
+  ~InductionVariableAnalysisTest() override {}
+
+ protected:
+  // Builds the loop
+  //   for (phi = init; condition(phi); phi = increment(phi)) {}
+  // and returns the phi.
+  Node* BuildLoop(Node* init,
+                  std::function<Node*(Node*)> const& build_condition,
+                  std::function<Node*(Node*)> const& build_increment) {
+    Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+    Node* phi = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kTagged, 2), init, init, loop);
+    Node* branch =
+        graph()->NewNode(common()->Branch(), build_condition(phi), loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+    loop->ReplaceInput(1, if_true);
+    phi->ReplaceInput(1, build_increment(phi));
+    Node* ret = graph()->NewNode(common()->Return(), phi, start(), if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return phi;
+  }
+
+  // Builds the loop for (i = 0; i < bound; i++) {} and returns the phi.
+  Node* BuildIncrementingLoop(Node* init, Node* bound) {
+    return BuildLoop(
+        init,
+        [&](Node* phi) {
+          return graph()->NewNode(simplified()->NumberLessThan(), phi, bound);
+        },
+        [&](Node* phi) {
+          return graph()->NewNode(simplified()->NumberAdd(), phi,
+                                  NumberConstant(1));
+        });
+  }
+
+  void Analyze(InductionVariableAnalysis* analysis) {
+    analysis->Run();
+    typer()->Run(NodeVector(zone()), analysis);
+  }
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(InductionVariableAnalysisTest, IncrementingLoop) {
+  // for (i = 0; i < 100; i++) {}
+  Node* bound = NumberConstant(100);
+  Node* phi = BuildLoop(
+      NumberConstant(0),
+      [&](Node* phi) {
+        return graph()->NewNode(simplified()->NumberLessThan(), phi, bound);
+      },
+      [&](Node* phi) {
+        return graph()->NewNode(simplified()->NumberAdd(), phi,
+                                NumberConstant(1));
+      });
+
+  InductionVariableAnalysis analysis(graph(), zone());
+  Analyze(&analysis);
+
+  InductionVariable* induction_var = analysis.Get(phi);
+  ASSERT_NE(nullptr, induction_var);
+  EXPECT_EQ(bound, induction_var->bound());
+  EXPECT_EQ(1.0, induction_var->step());
+  EXPECT_TRUE(induction_var->strict());
+  Type* type = NodeProperties::GetType(phi);
+  EXPECT_EQ(0.0, type->Min());
+  EXPECT_EQ(100.0, type->Max());
+}
+
+
+TEST_F(InductionVariableAnalysisTest, DecrementingLoop) {
+  // for (i = 10; 0 <= i; i -= 2) {}
+  Node* bound = NumberConstant(0);
+  Node* phi = BuildLoop(
+      NumberConstant(10),
+      [&](Node* phi) {
+        return graph()->NewNode(simplified()->NumberLessThanOrEqual(), bound,
+                                phi);
+      },
+      [&](Node* phi) {
+        return graph()->NewNode(simplified()->NumberSubtract(), phi,
+                                NumberConstant(2));
+      });
+
+  InductionVariableAnalysis analysis(graph(), zone());
+  Analyze(&analysis);
+
+  InductionVariable* induction_var = analysis.Get(phi);
+  ASSERT_NE(nullptr, induction_var);
+  EXPECT_EQ(-2.0, induction_var->step());
+  EXPECT_FALSE(induction_var->strict());
+  Type* type = NodeProperties::GetType(phi);
+  EXPECT_EQ(-2.0, type->Min());
+  EXPECT_EQ(10.0, type->Max());
+}
+
+
+TEST_F(InductionVariableAnalysisTest, LoopTestInWrongDirection) {
+  // for (i = 0; i > -100; i++) {}
+  Node* phi = BuildLoop(
+      NumberConstant(0),
+      [&](Node* phi) {
+        return graph()->NewNode(simplified()->NumberLessThan(),
+                                NumberConstant(-100), phi);
+      },
+      [&](Node* phi) {
+        return graph()->NewNode(simplified()->NumberAdd(), phi,
+                                NumberConstant(1));
+      });
+
+  InductionVariableAnalysis analysis(graph(), zone());
+  Analyze(&analysis);
+
+  EXPECT_EQ(nullptr, analysis.Get(phi));
+}
+
+
+
+// The following tests check how the typer narrows the type of an induction
+// variable with the types of its initial value and its bound.
+
+
+TEST_F(InductionVariableAnalysisTest, TypeWithRangeBound) {
+  // The bound is only known to be in [0, 1000].
+  Node* bound = graph()->NewNode(common()->Guard(Type::Range(0, 1000, zone())),
+                                 Parameter(0), start());
+  Node* phi = BuildIncrementingLoop(NumberConstant(0), bound);
+
+  InductionVariableAnalysis analysis(graph(), zone());
+  Analyze(&analysis);
+
+  Type* type = NodeProperties::GetType(phi);
+  EXPECT_EQ(0.0, type->Min());
+  EXPECT_EQ(1000.0, type->Max());
+}
+
+
+TEST_F(InductionVariableAnalysisTest, TypeWithNonStrictBound) {
+  // for (i = 0; i <= 100; i += 3) {}
+  Node* bound = NumberConstant(100);
+  Node* phi = BuildLoop(
+      NumberConstant(0),
+      [&](Node* phi) {
+        return graph()->NewNode(simplified()->NumberLessThanOrEqual(), phi,
+                                bound);
+      },
+      [&](Node* phi) {
+        return graph()->NewNode(simplified()->NumberAdd(), phi,
+                                NumberConstant(3));
+      });
+
+  InductionVariableAnalysis analysis(graph(), zone());
+  Analyze(&analysis);
+
+  Type* type = NodeProperties::GetType(phi);
+  EXPECT_EQ(0.0, type->Min());
+  EXPECT_EQ(103.0, type->Max());
+}
+
+
+TEST_F(InductionVariableAnalysisTest, TypeWithInitialValueBeyondBound) {
+  // The loop body never runs, so the phi only takes the initial value.
+  Node* phi = BuildIncrementingLoop(NumberConstant(200), NumberConstant(100));
+
+  InductionVariableAnalysis analysis(graph(), zone());
+  Analyze(&analysis);
+
+  Type* type = NodeProperties::GetType(phi);
+  EXPECT_EQ(200.0, type->Min());
+  EXPECT_EQ(200.0, type->Max());
+}
+
+
+TEST_F(InductionVariableAnalysisTest, TypeWithNonIntegerBound) {
+  Node* phi = BuildIncrementingLoop(NumberConstant(0), NumberConstant(10.5));
+
+  InductionVariableAnalysis analysis(graph(), zone());
+  Analyze(&analysis);
+
+  // The type is not narrowed, since the range of the bound is not integral.
+  ASSERT_NE(nullptr, analysis.Get(phi));
+  EXPECT_LT(11.0, NodeProperties::GetType(phi)->Max());
+}
+
+
+TEST_F(InductionVariableAnalysisTest, TypeWithoutAnalysis) {
+  Node* phi = BuildIncrementingLoop(NumberConstant(0), NumberConstant(100));
+
+  typer()->Run();
+
+  EXPECT_LT(101.0, NodeProperties::GetType(phi)->Max());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
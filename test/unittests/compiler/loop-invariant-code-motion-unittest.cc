@@ -0,0 +1,197 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/loop-invariant-code-motion.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/factory.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopInvariantCodeMotionTest : public TypedGraphTest {
+ public:
+  LoopInvariantCodeMotionTest()
+      : TypedGraphTest(3), javascript_(zone()), simplified_(zone()) {}
+  ~LoopInvariantCodeMotionTest() override {}
+
+ protected:
+  struct Loop {
+    Node* loop;
+    Node* effect_phi;
+  };
+
+  // Builds a loop whose body is produced by {build_body}, which receives the
+  // loop effect and control and returns the effect at the back edge.
+  template <typename Function>
+  Loop BuildLoop(Function build_body) {
+    Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), loop);
+    Node* effect = build_body(effect_phi, loop);
+    Node* branch = graph()->NewNode(common()->Branch(), Parameter(0), loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+    loop->ReplaceInput(1, if_true);
+    effect_phi->ReplaceInput(1, effect);
+    Node* ret =
+        graph()->NewNode(common()->Return(), Int32Constant(0), effect, if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return {loop, effect_phi};
+  }
+
+  size_t Hoist() {
+    LoopInvariantCodeMotion licm(graph(), zone());
+    licm.Run();
+    return licm.hoisted_count();
+  }
+
+  JSOperatorBuilder* javascript() { return &javascript_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  JSOperatorBuilder javascript_;
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(LoopInvariantCodeMotionTest, MapLoadOfConstant) {
+  Node* object = HeapConstant(factory()->undefined_value());
+  Node* load = nullptr;
+  Loop loop = BuildLoop([&](Node* effect, Node* control) {
+    load = graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                            object, effect, control);
+    return load;
+  });
+
+  EXPECT_EQ(1u, Hoist());
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(load));
+  EXPECT_EQ(load, NodeProperties::GetEffectInput(loop.effect_phi, 0));
+  EXPECT_EQ(loop.effect_phi, NodeProperties::GetEffectInput(loop.effect_phi, 1));
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, MapLoadOfPossibleSmi) {
+  Node* object = Parameter(Type::Any(), 1);
+  Node* load = nullptr;
+  BuildLoop([&](Node* effect, Node* control) {
+    load = graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                            object, effect, control);
+    return load;
+  });
+
+  EXPECT_EQ(0u, Hoist());
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, MapLoadOfUnreachableValue) {
+  Node* object = Parameter(Type::None(), 1);
+  Node* load = nullptr;
+  BuildLoop([&](Node* effect, Node* control) {
+    load = graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                            object, effect, control);
+    return load;
+  });
+
+  EXPECT_EQ(0u, Hoist());
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, MapLoadWithMapStoreInLoop) {
+  Node* object = Parameter(Type::Receiver(), 1);
+  Node* load = nullptr;
+  BuildLoop([&](Node* effect, Node* control) {
+    load = graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                            object, effect, control);
+    return graph()->NewNode(
+        simplified()->StoreField(AccessBuilder::ForMap()), object,
+        HeapConstant(factory()->fixed_array_map()), load, control);
+  });
+
+  EXPECT_EQ(0u, Hoist());
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, ContextSlotLoadWithUnrelatedStore) {
+  // The context is the last parameter of the function.
+  Node* context = Parameter(1);
+  Node* object = Parameter(Type::Receiver(), 2);
+  Node* load = nullptr;
+  BuildLoop([&](Node* effect, Node* control) {
+    load = graph()->NewNode(
+        simplified()->LoadField(
+            AccessBuilder::ForContextSlot(Context::MIN_CONTEXT_SLOTS)),
+        context, effect, control);
+    return graph()->NewNode(
+        simplified()->StoreField(AccessBuilder::ForJSObjectProperties()),
+        object, load, load, control);
+  });
+
+  EXPECT_EQ(1u, Hoist());
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(load));
+}
+
+
+
+TEST_F(LoopInvariantCodeMotionTest, MapLoadWithStackCheckInLoop) {
+  Node* object = Parameter(Type::Receiver(), 1);
+  Node* context = Parameter(2);
+  Node* load = nullptr;
+  BuildLoop([&](Node* effect, Node* control) {
+    // An interrupt may run code that changes the map.
+    Node* stack_check =
+        graph()->NewNode(javascript()->StackCheck(), context,
+                         EmptyFrameState(), effect, control);
+    load = graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                            object, stack_check, control);
+    return load;
+  });
+
+  EXPECT_EQ(0u, Hoist());
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, MapLoadInNestedLoops) {
+  Node* object = HeapConstant(factory()->undefined_value());
+  Node* outer = graph()->NewNode(common()->Loop(2), start(), start());
+  Node* outer_phi =
+      graph()->NewNode(common()->EffectPhi(2), start(), start(), outer);
+  Node* inner = graph()->NewNode(common()->Loop(2), outer, outer);
+  Node* inner_phi =
+      graph()->NewNode(common()->EffectPhi(2), outer_phi, outer_phi, inner);
+  Node* load =
+      graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                       object, inner_phi, inner);
+  Node* inner_branch =
+      graph()->NewNode(common()->Branch(), Parameter(0), inner);
+  Node* inner_true = graph()->NewNode(common()->IfTrue(), inner_branch);
+  Node* inner_false = graph()->NewNode(common()->IfFalse(), inner_branch);
+  inner->ReplaceInput(1, inner_true);
+  inner_phi->ReplaceInput(1, load);
+  Node* outer_branch =
+      graph()->NewNode(common()->Branch(), Parameter(0), inner_false);
+  Node* outer_true = graph()->NewNode(common()->IfTrue(), outer_branch);
+  Node* outer_false = graph()->NewNode(common()->IfFalse(), outer_branch);
+  outer->ReplaceInput(1, outer_true);
+  outer_phi->ReplaceInput(1, inner_phi);
+  Node* ret = graph()->NewNode(common()->Return(), Int32Constant(0),
+                               inner_phi, outer_false);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  // The load moves out of both loops, but is only counted once.
+  EXPECT_EQ(1u, Hoist());
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(load));
+  EXPECT_EQ(load, NodeProperties::GetEffectInput(outer_phi, 0));
+  EXPECT_EQ(outer_phi, NodeProperties::GetEffectInput(inner_phi, 0));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "src/compiler/frame.h"
 #include "src/compiler/pipeline.h"
+#include "src/compiler/register-allocator.h"
 #include "test/unittests/compiler/instruction-sequence-unittest.h"
 
 namespace v8 {
@@ -86,6 +88,63 @@ class RegisterAllocatorTest : public InstructionSequenceTest {
     WireBlocks();
     Pipeline::AllocateRegistersForTesting(config(), sequence(), true);
   }
+
+  void AllocateWithParallelRegisterAllocation(bool parallel) {
+    bool const old_parallel = FLAG_turbo_parallel_regalloc;
+    bool const old_select = FLAG_turbo_select_regalloc;
+    FLAG_turbo_parallel_regalloc = parallel;
+    FLAG_turbo_select_regalloc = false;
+    Allocate();
+    FLAG_turbo_parallel_regalloc = old_parallel;
+    FLAG_turbo_select_regalloc = old_select;
+  }
+
+  VReg DefineFP(VReg vreg) {
+    sequence()->MarkAsRepresentation(MachineRepresentation::kFloat64,
+                                     vreg.value_);
+    return vreg;
+  }
+
+  // Builds a block that is large enough to allocate general and floating
+  // point registers in parallel. More values of each kind are live than
+  // there are registers, so both allocators split and spill ranges. Records
+  // the instructions that define values of each kind.
+  void BuildMixedBlock(std::vector<int>* general_defs,
+                       std::vector<int>* fp_defs) {
+    static const int kValues = kDefaultNRegs + 4;
+    static const int kRounds = 1100;
+    StartBlock();
+    VReg general[kValues];
+    VReg fp[kValues];
+    for (int i = 0; i < kValues; ++i) {
+      general[i] = Define(Reg());
+      fp[i] = DefineFP(Define(Reg()));
+    }
+    for (int round = 0; round < kRounds; ++round) {
+      int i = round % kValues;
+      general[i] = EmitOI(Same(), Reg(general[i]), Use(fp[i]));
+      general_defs->push_back(sequence()->LastInstructionIndex());
+      fp[i] = DefineFP(EmitOI(Same(), Reg(fp[i]), Use(general[i])));
+      fp_defs->push_back(sequence()->LastInstructionIndex());
+    }
+    for (int i = 0; i < kValues; ++i) {
+      EmitI(Reg(general[i]), Reg(fp[i]));
+    }
+    Return(general[0]);
+    EndBlock(Last());
+  }
+
+  void CheckMixedBlock(std::vector<int> const& general_defs,
+                       std::vector<int> const& fp_defs) {
+    for (int index : general_defs) {
+      InstructionOperand* output = sequence()->InstructionAt(index)->Output();
+      EXPECT_TRUE(output->IsRegister() || output->IsStackSlot());
+    }
+    for (int index : fp_defs) {
+      InstructionOperand* output = sequence()->InstructionAt(index)->Output();
+      EXPECT_TRUE(output->IsFPRegister() || output->IsFPStackSlot());
+    }
+  }
 };
 
 
@@ -102,6 +161,65 @@ TEST_F(RegisterAllocatorTest, CanAllocateThreeRegisters) {
 }
 
 
+TEST_F(RegisterAllocatorTest, GeneralAndFPRegistersSequentially) {
+  std::vector<int> general_defs;
+  std::vector<int> fp_defs;
+  BuildMixedBlock(&general_defs, &fp_defs);
+
+  AllocateWithParallelRegisterAllocation(false);
+
+  CheckMixedBlock(general_defs, fp_defs);
+}
+
+
+TEST_F(RegisterAllocatorTest, GeneralAndFPRegistersInParallel) {
+  std::vector<int> general_defs;
+  std::vector<int> fp_defs;
+  BuildMixedBlock(&general_defs, &fp_defs);
+
+  AllocateWithParallelRegisterAllocation(true);
+
+  CheckMixedBlock(general_defs, fp_defs);
+}
+
+
+TEST_F(RegisterAllocatorTest, AllocationZonePerRegisterKind) {
+  StartBlock();
+  VReg general = Define(Reg());
+  VReg fp = DefineFP(Define(Reg()));
+  EmitI(Reg(general), Reg(fp));
+  Return(general);
+  EndBlock(Last());
+  WireBlocks();
+
+  Frame frame(0);
+  Zone fp_zone(isolate()->allocator());
+  RegisterAllocationData data(config(), zone(), &frame, sequence());
+  EXPECT_EQ(zone(), data.allocation_zone(GENERAL_REGISTERS));
+  EXPECT_EQ(zone(), data.allocation_zone(FP_REGISTERS));
+
+  // Once FP registers have a zone of their own, their spill ranges are
+  // allocated there.
+  data.set_fp_allocation_zone(&fp_zone);
+  EXPECT_EQ(zone(), data.allocation_zone(GENERAL_REGISTERS));
+  EXPECT_EQ(&fp_zone, data.allocation_zone(FP_REGISTERS));
+  TopLevelLiveRange* general_range =
+      data.GetOrCreateLiveRangeFor(general.value_);
+  TopLevelLiveRange* fp_range = data.GetOrCreateLiveRangeFor(fp.value_);
+  EXPECT_EQ(GENERAL_REGISTERS, general_range->kind());
+  EXPECT_EQ(FP_REGISTERS, fp_range->kind());
+
+  size_t fp_zone_size = fp_zone.allocation_size();
+  data.AssignSpillRangeToLiveRange(fp_range);
+  EXPECT_LT(fp_zone_size, fp_zone.allocation_size());
+
+  fp_zone_size = fp_zone.allocation_size();
+  data.AssignSpillRangeToLiveRange(general_range);
+  EXPECT_EQ(fp_zone_size, fp_zone.allocation_size());
+  data.set_fp_allocation_zone(nullptr);
+}
+
+
 TEST_F(RegisterAllocatorTest, SimpleLoop) {
   // i = K;
   // while(true) { i++ }
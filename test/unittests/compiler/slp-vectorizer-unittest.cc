@@ -0,0 +1,312 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/slp-vectorizer.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+using testing::_;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class SLPVectorizerTest : public GraphTest {
+ public:
+  SLPVectorizerTest()
+      : GraphTest(3),
+        machine_(zone(), MachineType::PointerRepresentation(),
+                 MachineOperatorBuilder::kSimd128Arithmetic) {}
+  ~SLPVectorizerTest() override {}
+
+ protected:
+  void Vectorize() {
+    SLPVectorizer vectorizer(graph(), common(), machine(), zone());
+    vectorizer.Vectorize();
+  }
+
+  Node* IntPtrConstant(int offset) {
+    return machine()->Is64() ? Int64Constant(offset) : Int32Constant(offset);
+  }
+
+  Node* Load(MachineType type, Node* base, int offset, Node** effect) {
+    *effect = graph()->NewNode(machine()->Load(type), base,
+                               IntPtrConstant(offset), *effect, start());
+    return *effect;
+  }
+
+  Node* Store(MachineRepresentation rep, Node* base, int offset, Node* value,
+              Node** effect) {
+    *effect = graph()->NewNode(
+        machine()->Store(StoreRepresentation(rep, kNoWriteBarrier)), base,
+        IntPtrConstant(offset), value, *effect, start());
+    return *effect;
+  }
+
+  Node* CheckedLoad(MachineType type, Node* buffer, Node* offset, Node* length,
+                    Node** effect) {
+    *effect = graph()->NewNode(machine()->CheckedLoad(type), buffer, offset,
+                               length, *effect, start());
+    return *effect;
+  }
+
+  Node* CheckedStore(MachineRepresentation rep, Node* buffer, Node* offset,
+                     Node* length, Node* value, Node** effect) {
+    *effect = graph()->NewNode(machine()->CheckedStore(rep), buffer, offset,
+                               length, value, *effect, start());
+    return *effect;
+  }
+
+  Node* Int32Add(Node* node, int value) {
+    return graph()->NewNode(machine()->Int32Add(), node, Int32Constant(value));
+  }
+
+  // Returns the effect that reaches the end of the graph.
+  Node* Return(Node* effect) {
+    Node* ret = graph()->NewNode(common()->Return(), Int32Constant(0), effect,
+                                 start());
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return ret;
+  }
+
+  MachineOperatorBuilder* machine() { return &machine_; }
+
+ private:
+  MachineOperatorBuilder machine_;
+};
+
+
+TEST_F(SLPVectorizerTest, Float32x4Add) {
+  Node* a = Parameter(0);
+  Node* b = Parameter(1);
+  Node* c = Parameter(2);
+  Node* effect = start();
+  Node* sums[4];
+  for (int i = 0; i < 4; ++i) {
+    Node* x = Load(MachineType::Float32(), a, i * 4, &effect);
+    Node* y = Load(MachineType::Float32(), b, i * 4, &effect);
+    sums[i] = graph()->NewNode(machine()->Float32Add(), x, y);
+  }
+  for (int i = 0; i < 4; ++i) {
+    Store(MachineRepresentation::kFloat32, c, i * 4, sums[i], &effect);
+  }
+  Node* ret = Return(effect);
+
+  Vectorize();
+
+  Node* store = NodeProperties::GetEffectInput(ret);
+  Node* value = store->InputAt(2);
+  EXPECT_THAT(store, IsStore(StoreRepresentation(
+                                 MachineRepresentation::kSimd128,
+                                 kNoWriteBarrier),
+                             c, _, value, _, start()));
+  ASSERT_EQ(IrOpcode::kFloat32x4Add, value->opcode());
+  Node* load_b = NodeProperties::GetEffectInput(store);
+  Node* load_a = NodeProperties::GetEffectInput(load_b);
+  EXPECT_EQ(load_a, value->InputAt(0));
+  EXPECT_EQ(load_b, value->InputAt(1));
+  EXPECT_THAT(load_a, IsLoad(MachineType::Simd128(), a, _, start(), start()));
+  EXPECT_THAT(load_b, IsLoad(MachineType::Simd128(), b, _, load_a, start()));
+}
+
+
+TEST_F(SLPVectorizerTest, Int32x4SubWithLoadsAfterStores) {
+  Node* a = Parameter(0);
+  Node* b = Parameter(1);
+  Node* effect = start();
+  Node* differences[4];
+  for (int i = 0; i < 4; ++i) {
+    Node* x = Load(MachineType::Int32(), a, i * 4, &effect);
+    Node* y = Load(MachineType::Int32(), a, 16 + i * 4, &effect);
+    differences[i] = graph()->NewNode(machine()->Int32Sub(), x, y);
+  }
+  for (int i = 0; i < 4; ++i) {
+    Store(MachineRepresentation::kWord32, a, 32 + i * 4, differences[i],
+          &effect);
+  }
+  // A load of another object after the stores is not reordered.
+  Node* load = Load(MachineType::Int32(), b, 0, &effect);
+  Node* ret = Return(effect);
+
+  Vectorize();
+
+  EXPECT_EQ(load, NodeProperties::GetEffectInput(ret));
+  Node* store = NodeProperties::GetEffectInput(load);
+  EXPECT_THAT(store, IsStore(StoreRepresentation(
+                                 MachineRepresentation::kSimd128,
+                                 kNoWriteBarrier),
+                             a, _, _, _, start()));
+  EXPECT_EQ(IrOpcode::kInt32x4Sub, store->InputAt(2)->opcode());
+}
+
+
+TEST_F(SLPVectorizerTest, AliasingStoreBlocksVectorization) {
+  Node* a = Parameter(0);
+  Node* b = Parameter(1);
+  Node* effect = start();
+  Node* sums[4];
+  for (int i = 0; i < 4; ++i) {
+    Node* x = Load(MachineType::Float32(), a, i * 4, &effect);
+    sums[i] = graph()->NewNode(machine()->Float32Add(), x, x);
+    // The store to b may alias the loads of a.
+    if (i == 1) Store(MachineRepresentation::kFloat32, b, 0, x, &effect);
+  }
+  for (int i = 0; i < 4; ++i) {
+    Store(MachineRepresentation::kFloat32, a, 16 + i * 4, sums[i], &effect);
+  }
+  Node* ret = Return(effect);
+
+  Vectorize();
+
+  EXPECT_EQ(effect, NodeProperties::GetEffectInput(ret));
+  EXPECT_THAT(effect, IsStore(StoreRepresentation(
+                                  MachineRepresentation::kFloat32,
+                                  kNoWriteBarrier),
+                              a, _, sums[3], _, start()));
+}
+
+
+TEST_F(SLPVectorizerTest, ScalarUseBlocksVectorization) {
+  Node* a = Parameter(0);
+  Node* effect = start();
+  Node* sums[4];
+  for (int i = 0; i < 4; ++i) {
+    Node* x = Load(MachineType::Float32(), a, i * 4, &effect);
+    sums[i] = graph()->NewNode(machine()->Float32Add(), x, x);
+  }
+  for (int i = 0; i < 4; ++i) {
+    Store(MachineRepresentation::kFloat32, a, 16 + i * 4, sums[i], &effect);
+  }
+  // The sum of the first lane is also used as a scalar.
+  Store(MachineRepresentation::kFloat32, a, 64, sums[0], &effect);
+  Node* ret = Return(effect);
+
+  Vectorize();
+
+  EXPECT_EQ(effect, NodeProperties::GetEffectInput(ret));
+  Node* store = NodeProperties::GetEffectInput(effect);
+  EXPECT_THAT(store, IsStore(StoreRepresentation(
+                                 MachineRepresentation::kFloat32,
+                                 kNoWriteBarrier),
+                             a, _, sums[3], _, start()));
+}
+
+
+TEST_F(SLPVectorizerTest, CheckedInt32x4AddIsGuarded) {
+  Node* buffer = Parameter(0);
+  Node* key = Parameter(1);
+  Node* length = Parameter(2);
+  Node* effect = start();
+  Node* sums[4];
+  for (int i = 0; i < 4; ++i) {
+    Node* x = CheckedLoad(MachineType::Int32(), buffer, Int32Add(key, i * 4),
+                          length, &effect);
+    Node* y = CheckedLoad(MachineType::Int32(), buffer,
+                          Int32Add(key, 16 + i * 4), length, &effect);
+    sums[i] = graph()->NewNode(machine()->Int32Add(), x, y);
+  }
+  Node* stores[4];
+  for (int i = 0; i < 4; ++i) {
+    stores[i] = CheckedStore(MachineRepresentation::kWord32, buffer,
+                             Int32Add(key, 32 + i * 4), length, sums[i],
+                             &effect);
+  }
+  Node* ret = Return(effect);
+
+  Vectorize();
+
+  // The scalar accesses are kept for the case that a lane is out of bounds.
+  Node* ephi = NodeProperties::GetEffectInput(ret);
+  ASSERT_EQ(IrOpcode::kEffectPhi, ephi->opcode());
+  Node* merge = NodeProperties::GetControlInput(ephi);
+  Node* branch = NodeProperties::GetControlInput(merge)->InputAt(0);
+  EXPECT_THAT(merge, IsMerge(IsIfTrue(branch), IsIfFalse(branch)));
+  EXPECT_THAT(branch, IsBranch(IsWord32And(_, _), start()));
+  EXPECT_EQ(stores[3], ephi->InputAt(1));
+  EXPECT_THAT(stores[3]->InputAt(5), IsIfFalse(branch));
+
+  Node* store = ephi->InputAt(0);
+  EXPECT_THAT(store, IsStore(StoreRepresentation(
+                                 MachineRepresentation::kSimd128,
+                                 kNoWriteBarrier),
+                             buffer, stores[0]->InputAt(1), _, _,
+                             IsIfTrue(branch)));
+  ASSERT_EQ(IrOpcode::kInt32x4Add, store->InputAt(2)->opcode());
+  Node* load_y = NodeProperties::GetEffectInput(store);
+  Node* load_x = NodeProperties::GetEffectInput(load_y);
+  EXPECT_THAT(load_x, IsLoad(MachineType::Simd128(), buffer, _, start(),
+                             IsIfTrue(branch)));
+  EXPECT_THAT(load_y, IsLoad(MachineType::Simd128(), buffer, _, load_x,
+                             IsIfTrue(branch)));
+}
+
+
+TEST_F(SLPVectorizerTest, CheckedAccessesWithDifferentLengths) {
+  Node* buffer = Parameter(0);
+  Node* key = Parameter(1);
+  Node* effect = start();
+  Node* sums[4];
+  for (int i = 0; i < 4; ++i) {
+    Node* x = CheckedLoad(MachineType::Int32(), buffer, Int32Add(key, i * 4),
+                          Parameter(2), &effect);
+    sums[i] = graph()->NewNode(machine()->Int32Add(), x, x);
+  }
+  for (int i = 0; i < 4; ++i) {
+    // Each store is checked against another length.
+    CheckedStore(MachineRepresentation::kWord32, buffer,
+                 Int32Add(key, 16 + i * 4), Int32Constant(100 + i), sums[i],
+                 &effect);
+  }
+  Node* ret = Return(effect);
+
+  Vectorize();
+
+  EXPECT_EQ(effect, NodeProperties::GetEffectInput(ret));
+  EXPECT_EQ(sums[3], effect->InputAt(3));
+}
+
+
+TEST_F(SLPVectorizerTest, RelocatableBaseAddresses) {
+  // Accesses to constant wasm memory offsets use a separate relocatable base
+  // for each offset.
+  const intptr_t kMemStart = 0x10000;
+  Node* effect = start();
+  Node* sums[4];
+  for (int i = 0; i < 4; ++i) {
+    Node* base = machine()->Is64()
+                     ? graph()->NewNode(common()->RelocatableInt64Constant(
+                           kMemStart + i * 4,
+                           RelocInfo::WASM_MEMORY_REFERENCE))
+                     : graph()->NewNode(common()->RelocatableInt32Constant(
+                           static_cast<int32_t>(kMemStart + i * 4),
+                           RelocInfo::WASM_MEMORY_REFERENCE));
+    Node* x = Load(MachineType::Float32(), base, 0, &effect);
+    sums[i] = graph()->NewNode(machine()->Float32Add(), x, x);
+  }
+  for (int i = 0; i < 4; ++i) {
+    Node* base = machine()->Is64()
+                     ? graph()->NewNode(common()->RelocatableInt64Constant(
+                           kMemStart, RelocInfo::WASM_MEMORY_REFERENCE))
+                     : graph()->NewNode(common()->RelocatableInt32Constant(
+                           static_cast<int32_t>(kMemStart),
+                           RelocInfo::WASM_MEMORY_REFERENCE));
+    Store(MachineRepresentation::kFloat32, base, 16 + i * 4, sums[i], &effect);
+  }
+  Node* ret = Return(effect);
+
+  Vectorize();
+
+  Node* store = NodeProperties::GetEffectInput(ret);
+  EXPECT_THAT(store, IsStore(StoreRepresentation(
+                                 MachineRepresentation::kSimd128,
+                                 kNoWriteBarrier),
+                             _, _, _, _, start()));
+  EXPECT_EQ(IrOpcode::kFloat32x4Add, store->InputAt(2)->opcode());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,172 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "src/compiler/instruction-scheduler.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class InstructionSchedulerTest : public TestWithIsolateAndZone {
+ public:
+  InstructionSchedulerTest() : scheduler_(nullptr) { ResetScheduler(); }
+
+ protected:
+  static const int kNoOutput = -1;
+
+  // Builds the graph of a block from scratch. The instruction sequence is
+  // not needed as long as the block is not actually scheduled.
+  void ResetScheduler() {
+    scheduler_ = new (zone()) InstructionScheduler(zone(), nullptr);
+  }
+
+  // Adds an instruction defining virtual register {output} from the virtual
+  // registers in {inputs}.
+  Instruction* Emit(InstructionCode opcode, int output,
+                    const std::vector<int>& inputs) {
+    InstructionOperand output_operand =
+        UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, output);
+    std::vector<InstructionOperand> input_operands;
+    for (int input : inputs) {
+      input_operands.push_back(
+          UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, input));
+    }
+    Instruction* instr = Instruction::New(
+        zone(), opcode, output == kNoOutput ? 0 : 1, &output_operand,
+        input_operands.size(), input_operands.data(), 0, nullptr);
+    scheduler_->AddInstruction(instr);
+    return instr;
+  }
+
+  int RegisterPressureDelta(size_t index) {
+    return scheduler_->graph_[index]->RegisterPressureDelta();
+  }
+
+  void StartTrackingLiveValues() { scheduler_->StartTrackingLiveValues(); }
+  void Schedule(size_t index) {
+    scheduler_->UpdateLiveValues(scheduler_->graph_[index]);
+  }
+
+  int live_values() const { return scheduler_->live_values_; }
+  int max_live_values() const { return scheduler_->max_live_values_; }
+  bool IsRegisterPressureHigh() const {
+    return scheduler_->IsRegisterPressureHigh();
+  }
+
+  // Returns the instruction the critical path queue would schedule first.
+  Instruction* PopBestCandidate() {
+    scheduler_->ComputeTotalLatencies();
+    InstructionScheduler::CriticalPathFirstQueue queue(scheduler_);
+    for (InstructionScheduler::ScheduleGraphNode* node : scheduler_->graph_) {
+      if (!node->HasUnscheduledPredecessor()) queue.AddNode(node);
+    }
+    return queue.PopBestCandidate(0)->instruction();
+  }
+
+  int Latency(InstructionCode opcode, bool has_output) {
+    InstructionOperand operands[] = {
+        UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, 1),
+        UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, 2)};
+    Instruction* instr =
+        has_output
+            ? Instruction::New(zone(), opcode, 1, operands, 1, operands + 1, 0,
+                               nullptr)
+            : Instruction::New(zone(), opcode, 0, nullptr, 2, operands, 0,
+                               nullptr);
+    return InstructionScheduler::GetInstructionLatency(instr);
+  }
+
+ private:
+  InstructionScheduler* scheduler_;
+};
+
+
+TEST_F(InstructionSchedulerTest, RegisterPressureDelta) {
+  // v1 = v10 + v11; v2 = v1 + v10; v3 = v2 + v2
+  Emit(kX64Add32, 1, {10, 11});
+  Emit(kX64Add32, 2, {1, 10});
+  Emit(kX64Add32, 3, {2, 2});
+
+  // v1 becomes live and v11 dies. v10 is still used by the second add.
+  EXPECT_EQ(0, RegisterPressureDelta(0));
+  // v2 becomes live and v1 dies.
+  EXPECT_EQ(0, RegisterPressureDelta(1));
+  // v3 has no user in the block; v2 dies, although it is used twice.
+  EXPECT_EQ(-1, RegisterPressureDelta(2));
+
+  // v10 and v11 are live on entry to the block.
+  StartTrackingLiveValues();
+  EXPECT_EQ(2, live_values());
+  Schedule(0);
+  EXPECT_EQ(2, live_values());
+  // Now the second add is the last user of v10 as well.
+  EXPECT_EQ(-1, RegisterPressureDelta(1));
+  Schedule(1);
+  EXPECT_EQ(1, live_values());
+  Schedule(2);
+  EXPECT_EQ(0, live_values());
+}
+
+
+TEST_F(InstructionSchedulerTest, IsRegisterPressureHigh) {
+  // Each add uses a different value which is live on entry to the block.
+  for (int i = 0; i < max_live_values(); ++i) {
+    Emit(kX64Add32, 100 + i, {i, i});
+  }
+  StartTrackingLiveValues();
+  EXPECT_EQ(max_live_values(), live_values());
+  EXPECT_TRUE(IsRegisterPressureHigh());
+
+  Schedule(0);
+  EXPECT_EQ(max_live_values() - 1, live_values());
+  EXPECT_FALSE(IsRegisterPressureHigh());
+}
+
+
+TEST_F(InstructionSchedulerTest, HighRegisterPressurePrefersDyingValues) {
+  // The division is on the critical path, but it makes another value live.
+  // The independent add ends the live range of v2 instead. The values used by
+  // the last instruction fill the remaining registers.
+  for (int pass = 0; pass < 2; ++pass) {
+    bool high_pressure = pass == 0;
+    ResetScheduler();
+    Instruction* div = Emit(kX64Idiv32, 100, {0, 1});
+    Emit(kX64Add32, 101, {100, 100});
+    Instruction* add = Emit(kX64Add32, 102, {2, 2});
+    std::vector<int> inputs = {101, 0, 1};
+    int live_ins = high_pressure ? max_live_values() : 3;
+    for (int i = 3; i < live_ins; ++i) inputs.push_back(i);
+    Emit(kX64Add32, 103, inputs);
+
+    EXPECT_EQ(1, RegisterPressureDelta(0));
+    EXPECT_EQ(-1, RegisterPressureDelta(2));
+    StartTrackingLiveValues();
+    EXPECT_EQ(high_pressure, IsRegisterPressureHigh());
+    EXPECT_EQ(high_pressure ? add : div, PopBestCandidate());
+  }
+}
+
+
+TEST_F(InstructionSchedulerTest, Latencies) {
+  InstructionCode memory = AddressingModeField::encode(kMode_MR);
+  EXPECT_EQ(1, Latency(kX64Add32, true));
+  EXPECT_EQ(6, Latency(kX64Add32 | memory, true));
+  EXPECT_EQ(1, Latency(kX64Lea32 | memory, true));
+  EXPECT_EQ(3, Latency(kX64Imul32, true));
+  EXPECT_EQ(26, Latency(kX64Idiv32, true));
+  EXPECT_EQ(40, Latency(kX64Idiv, true));
+  // Loads pay the load-to-use latency, stores and register moves do not.
+  EXPECT_EQ(1, Latency(kX64Movl, true));
+  EXPECT_EQ(5, Latency(kX64Movl | memory, true));
+  EXPECT_EQ(1, Latency(kX64Movl | memory, false));
+  EXPECT_EQ(6, Latency(kCheckedLoadWord32, true));
+  EXPECT_EQ(20, Latency(kX64Xchgl | memory, false));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -161,7 +161,7 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
       .JumpIfNotHole(&start);
 
   // Longer jumps with constant operands
-  BytecodeLabel end[8];
+  BytecodeLabel end[10];
   builder.Jump(&end[0])
       .LoadTrue()
       .JumpIfTrue(&end[1])
@@ -187,6 +187,22 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
       .JumpIfTrue(&start)
       .BinaryOperation(Token::Value::ADD, reg)
       .JumpIfFalse(&start);
+  // Emit pairs of bytecodes that are fused into superinstructions.
+  bool old_superinstructions = FLAG_ignition_superinstructions;
+  FLAG_ignition_superinstructions = true;
+  builder.LoadLiteral(Smi::FromInt(0))
+      .StoreAccumulatorInRegister(reg)
+      .LoadUndefined()
+      .StoreAccumulatorInRegister(reg)
+      .CompareOperation(Token::Value::EQ_STRICT, reg)
+      .JumpIfTrue(&start)
+      .CompareOperation(Token::Value::EQ_STRICT, reg)
+      .JumpIfFalse(&start)
+      .CompareOperation(Token::Value::EQ_STRICT, reg)
+      .JumpIfTrue(&end[8])
+      .CompareOperation(Token::Value::EQ_STRICT, reg)
+      .JumpIfFalse(&end[9]);
+  FLAG_ignition_superinstructions = old_superinstructions;
   // Insert dummy ops to force longer jumps
   for (int i = 0; i < 128; i++) {
     builder.LoadTrue();
@@ -786,6 +802,49 @@ TEST_F(BytecodeArrayBuilderTest, SizesForUnsignOperands) {
             static_cast<size_t>(kMaxUInt32)) == OperandSize::kQuad);
 }
 
+TEST_F(BytecodeArrayBuilderTest, Superinstructions) {
+  bool old_superinstructions = FLAG_ignition_superinstructions;
+  FLAG_ignition_superinstructions = true;
+  BytecodeArrayBuilder builder(isolate(), zone(), 0, 0, 2);
+  Register reg0(0);
+  Register reg1(1);
+  BytecodeLabel label;
+  builder.LoadLiteral(Smi::FromInt(0))
+      .StoreAccumulatorInRegister(reg0)
+      .CompareOperation(Token::Value::EQ_STRICT, reg1)
+      .JumpIfFalse(&label)
+      .LoadUndefined()
+      .Bind(&label)
+      .StoreAccumulatorInRegister(reg1)
+      .CompareOperation(Token::Value::EQ_STRICT, reg0)
+      .JumpIfTrue(&label)
+      .Return();
+  FLAG_ignition_superinstructions = old_superinstructions;
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  BytecodeArrayIterator iterator(array);
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kLdaZeroStar);
+  CHECK_EQ(iterator.GetRegisterOperand(0).index(), reg0.index());
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kTestEqualStrictJumpIfFalse);
+  CHECK_EQ(iterator.GetRegisterOperand(1).index(), reg1.index());
+  int label_offset = iterator.GetJumpTargetOffset();
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kLdaUndefined);
+  iterator.Advance();
+  // The label starts a new basic block, so the store is not fused.
+  CHECK_EQ(iterator.current_offset(), label_offset);
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kStar);
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kTestEqualStrictJumpIfTrue);
+  CHECK_EQ(iterator.GetRegisterOperand(1).index(), reg0.index());
+  CHECK_EQ(iterator.GetJumpTargetOffset(), label_offset);
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kReturn);
+  iterator.Advance();
+  CHECK(iterator.done());
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
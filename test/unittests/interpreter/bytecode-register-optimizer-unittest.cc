@@ -0,0 +1,151 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/v8.h"
+
+#include "src/interpreter/bytecode-array-builder.h"
+#include "src/interpreter/bytecode-array-iterator.h"
+#include "src/interpreter/bytecode-register-optimizer.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace interpreter {
+
+class BytecodeRegisterOptimizerTest : public TestWithIsolateAndZone {
+ public:
+  BytecodeRegisterOptimizerTest() : optimizer_(zone()) {}
+  ~BytecodeRegisterOptimizerTest() override {}
+
+  BytecodeRegisterOptimizer* optimizer() { return &optimizer_; }
+
+  void Update(Bytecode bytecode) { optimizer()->Update(bytecode, nullptr, 0); }
+
+  void Update(Bytecode bytecode, Register reg) {
+    uint32_t operands[] = {BytecodeArrayBuilder::RegisterOperand(reg)};
+    optimizer()->Update(bytecode, operands, 1);
+  }
+
+  void Update(Bytecode bytecode, Register reg0, Register reg1) {
+    uint32_t operands[] = {BytecodeArrayBuilder::RegisterOperand(reg0),
+                           BytecodeArrayBuilder::RegisterOperand(reg1)};
+    optimizer()->Update(bytecode, operands, 2);
+  }
+
+ private:
+  BytecodeRegisterOptimizer optimizer_;
+};
+
+// Enables the bytecode optimizations for the lifetime of the scope.
+class BytecodeOptimizationScope {
+ public:
+  BytecodeOptimizationScope()
+      : old_peephole_(FLAG_ignition_peephole), old_reo_(FLAG_ignition_reo) {
+    FLAG_ignition_peephole = true;
+    FLAG_ignition_reo = true;
+  }
+  ~BytecodeOptimizationScope() {
+    FLAG_ignition_peephole = old_peephole_;
+    FLAG_ignition_reo = old_reo_;
+  }
+
+ private:
+  bool old_peephole_;
+  bool old_reo_;
+};
+
+TEST_F(BytecodeRegisterOptimizerTest, StarAndLdar) {
+  Register reg0(0);
+  Register reg1(1);
+  CHECK(!optimizer()->IsAccumulatorEquivalent(reg0));
+  Update(Bytecode::kStar, reg0);
+  CHECK(optimizer()->IsAccumulatorEquivalent(reg0));
+  CHECK(!optimizer()->IsAccumulatorEquivalent(reg1));
+  Update(Bytecode::kStar, reg1);
+  CHECK(optimizer()->AreEquivalent(reg0, reg1));
+  Update(Bytecode::kLdaZero);
+  CHECK(!optimizer()->IsAccumulatorEquivalent(reg0));
+  CHECK(optimizer()->AreEquivalent(reg0, reg1));
+  Update(Bytecode::kLdar, reg1);
+  CHECK(optimizer()->IsAccumulatorEquivalent(reg0));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, MovAndOutputRegisters) {
+  Register reg0(0);
+  Register reg1(1);
+  Register reg2(2);
+  Update(Bytecode::kMov, reg0, reg1);
+  CHECK(optimizer()->AreEquivalent(reg0, reg1));
+  CHECK(!optimizer()->AreEquivalent(reg0, reg2));
+  uint32_t operands[] = {BytecodeArrayBuilder::RegisterOperand(reg0)};
+  optimizer()->Update(Bytecode::kForInPrepare, operands, 1);
+  CHECK(!optimizer()->AreEquivalent(reg0, reg1));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, Reset) {
+  Register reg0(0);
+  Update(Bytecode::kStar, reg0);
+  optimizer()->Reset();
+  CHECK(!optimizer()->IsAccumulatorEquivalent(reg0));
+  Update(Bytecode::kStar, reg0);
+  Update(Bytecode::kDebugger);
+  CHECK(!optimizer()->IsAccumulatorEquivalent(reg0));
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, ElidesRedundantTransfers) {
+  BytecodeOptimizationScope scope;
+  BytecodeArrayBuilder builder(isolate(), zone(), 0, 0, 3);
+  Register reg0(0);
+  Register reg1(1);
+  Register reg2(2);
+  builder.LoadLiteral(Smi::FromInt(1))
+      .StoreAccumulatorInRegister(reg0)
+      .MoveRegister(reg0, reg1)
+      .LoadAccumulatorWithRegister(reg2)
+      .LoadAccumulatorWithRegister(reg1)
+      .StoreAccumulatorInRegister(reg0)
+      .MoveRegister(reg1, reg0)
+      .Return();
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  BytecodeArrayIterator iterator(array);
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kLdaSmi);
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kStar);
+  CHECK_EQ(iterator.GetRegisterOperand(0).index(), reg0.index());
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kMov);
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kLdar);
+  CHECK_EQ(iterator.GetRegisterOperand(0).index(), reg1.index());
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kReturn);
+  iterator.Advance();
+  CHECK(iterator.done());
+}
+
+TEST_F(BytecodeRegisterOptimizerTest, KeepsTransfersAcrossLabels) {
+  BytecodeOptimizationScope scope;
+  BytecodeArrayBuilder builder(isolate(), zone(), 0, 0, 1);
+  Register reg0(0);
+  BytecodeLabel label;
+  builder.StoreAccumulatorInRegister(reg0)
+      .Bind(&label)
+      .LoadAccumulatorWithRegister(reg0)
+      .Return();
+
+  Handle<BytecodeArray> array = builder.ToBytecodeArray();
+  BytecodeArrayIterator iterator(array);
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kStar);
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kLdar);
+  iterator.Advance();
+  CHECK_EQ(iterator.current_bytecode(), Bytecode::kReturn);
+  iterator.Advance();
+  CHECK(iterator.done());
+}
+
+}  // namespace interpreter
+}  // namespace internal
+}  // namespace v8
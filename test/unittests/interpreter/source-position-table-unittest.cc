@@ -79,6 +79,16 @@ TEST_F(SourcePositionTableTest, EncodeAscending) {
   CHECK(!builder.ToSourcePositionTable().is_null());
 }
 
+TEST_F(SourcePositionTableTest, OmitPositions) {
+  SourcePositionTableBuilder builder(
+      isolate(), zone(), SourcePositionTableBuilder::OMIT_SOURCE_POSITIONS);
+  for (int i = 0; i < arraysize(offsets); i++) {
+    builder.AddStatementPosition(offsets[i], offsets[i]);
+    builder.AddExpressionPosition(offsets[i], offsets[i] + 1);
+  }
+  CHECK(builder.ToSourcePositionTable()->IsUndefined());
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
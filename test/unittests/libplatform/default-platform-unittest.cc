@@ -3,9 +3,12 @@
 // found in the LICENSE file.
 
 #include "src/libplatform/default-platform.h"
+#include "src/base/platform/semaphore.h"
+#include "src/base/platform/time.h"
 #include "testing/gmock/include/gmock/gmock.h"
 
 using testing::InSequence;
+using testing::InvokeWithoutArgs;
 using testing::StrictMock;
 
 namespace v8 {
@@ -20,9 +23,28 @@ struct MockTask : public Task {
 };
 
 
+struct MockIdleTask : public IdleTask {
+  virtual ~MockIdleTask() { Die(); }
+  MOCK_METHOD1(Run, void(double deadline_in_seconds));
+  MOCK_METHOD0(Die, void());
+};
+
+
+class SignalingTask : public Task {
+ public:
+  explicit SignalingTask(base::Semaphore* semaphore) : semaphore_(semaphore) {}
+  void Run() override { semaphore_->Signal(); }
+
+ private:
+  base::Semaphore* semaphore_;
+};
+
+
 class DefaultPlatformWithMockTime : public DefaultPlatform {
  public:
-  DefaultPlatformWithMockTime() : time_(0) {}
+  explicit DefaultPlatformWithMockTime(
+      IdleTaskSupport idle_task_support = IdleTaskSupport::kDisabled)
+      : DefaultPlatform(idle_task_support), time_(0) {}
   double MonotonicallyIncreasingTime() override { return time_; }
   void IncreaseTime(double seconds) { time_ += seconds; }
 
@@ -127,5 +149,93 @@ TEST(DefaultPlatformTest, PendingDelayedTasksAreDestroyedOnShutdown) {
 }
 
 
+TEST(DefaultPlatformTest, RunIdleTasks) {
+  InSequence s;
+
+  int dummy;
+  Isolate* isolate = reinterpret_cast<Isolate*>(&dummy);
+
+  DefaultPlatformWithMockTime platform(IdleTaskSupport::kEnabled);
+  EXPECT_TRUE(platform.IdleTasksEnabled(isolate));
+
+  StrictMock<MockIdleTask>* task = new StrictMock<MockIdleTask>;
+  platform.CallIdleOnForegroundThread(isolate, task);
+  EXPECT_CALL(*task, Run(42.0));
+  EXPECT_CALL(*task, Die());
+  platform.IncreaseTime(23.0);
+  platform.RunIdleTasks(isolate, 42.0 - 23.0);
+}
+
+
+TEST(DefaultPlatformTest, RunIdleTasksStopsAtDeadline) {
+  InSequence s;
+
+  int dummy;
+  Isolate* isolate = reinterpret_cast<Isolate*>(&dummy);
+
+  DefaultPlatformWithMockTime platform(IdleTaskSupport::kEnabled);
+  StrictMock<MockIdleTask>* task1 = new StrictMock<MockIdleTask>;
+  StrictMock<MockIdleTask>* task2 = new StrictMock<MockIdleTask>;
+  platform.CallIdleOnForegroundThread(isolate, task1);
+  platform.CallIdleOnForegroundThread(isolate, task2);
+
+  // The first task uses up the whole idle period.
+  EXPECT_CALL(*task1, Run(10.0))
+      .WillOnce(InvokeWithoutArgs([&platform]() { platform.IncreaseTime(10); }));
+  EXPECT_CALL(*task1, Die());
+  platform.RunIdleTasks(isolate, 10.0);
+
+  EXPECT_CALL(*task2, Run(15.0));
+  EXPECT_CALL(*task2, Die());
+  platform.RunIdleTasks(isolate, 5.0);
+}
+
+
+TEST(DefaultPlatformTest, PendingIdleTasksAreDestroyedOnShutdown) {
+  InSequence s;
+
+  int dummy;
+  Isolate* isolate = reinterpret_cast<Isolate*>(&dummy);
+
+  {
+    DefaultPlatformWithMockTime platform(IdleTaskSupport::kEnabled);
+    StrictMock<MockIdleTask>* task = new StrictMock<MockIdleTask>;
+    platform.CallIdleOnForegroundThread(isolate, task);
+    EXPECT_CALL(*task, Die());
+  }
+}
+
+
+TEST(DefaultPlatformTest, CallDelayedOnBackgroundThread) {
+  static const double kDelayInSeconds = 0.05;
+
+  DefaultPlatform platform;
+  platform.SetThreadPoolSize(2);
+  platform.EnsureInitialized();
+
+  base::Semaphore semaphore(0);
+  base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+  platform.CallDelayedOnBackgroundThread(new SignalingTask(&semaphore),
+                                         kDelayInSeconds);
+  semaphore.Wait();
+  base::TimeDelta elapsed = base::TimeTicks::HighResolutionNow() - start;
+  EXPECT_LE(kDelayInSeconds, elapsed.InSecondsF());
+}
+
+
+TEST(DefaultPlatformTest, PendingDelayedBackgroundTasksAreDestroyedOnShutdown) {
+  InSequence s;
+
+  {
+    DefaultPlatform platform;
+    platform.SetThreadPoolSize(1);
+    platform.EnsureInitialized();
+    StrictMock<MockTask>* task = new StrictMock<MockTask>;
+    platform.CallDelayedOnBackgroundThread(task, 1000);
+    EXPECT_CALL(*task, Die());
+  }
+}
+
+
 }  // namespace platform
 }  // namespace v8
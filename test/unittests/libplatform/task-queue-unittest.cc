@@ -56,5 +56,56 @@ TEST(TaskQueueTest, TerminateMultipleReaders) {
   thread2.Join();
 }
 
+
+TEST(TaskQueueTest, ShortRunningTasksFirst) {
+  TaskQueue queue;
+  MockTask long_task;
+  MockTask short_task;
+  queue.Append(&long_task, Platform::kLongRunningTask);
+  queue.Append(&short_task, Platform::kShortRunningTask);
+  EXPECT_EQ(&short_task, queue.GetNext());
+  EXPECT_EQ(&long_task, queue.GetNext());
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(), IsNull());
+}
+
+
+TEST(TaskQueueTest, StealFromOtherWorkers) {
+  TaskQueue queue(2);
+  MockTask task1;
+  MockTask task2;
+  // Tasks are distributed over both sub-queues, but a single worker can
+  // still drain all of them.
+  queue.Append(&task1);
+  queue.Append(&task2);
+  Task* first = queue.GetNext(1);
+  Task* second = queue.GetNext(1);
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(first == &task1 || first == &task2);
+  EXPECT_TRUE(second == &task1 || second == &task2);
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(0), IsNull());
+  EXPECT_THAT(queue.GetNext(1), IsNull());
+}
+
+
+TEST(TaskQueueTest, LongRunningTaskLimit) {
+  TaskQueue queue(2);
+  MockTask long_task1;
+  MockTask long_task2;
+  queue.Append(&long_task1, Platform::kLongRunningTask);
+  queue.Append(&long_task2, Platform::kLongRunningTask);
+  Task* first = queue.GetNext(0);
+  // Only one of the two workers may run a long running task at a time, so
+  // the second one becomes available once worker 0 asks for its next task.
+  Task* second = queue.GetNext(0);
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(first == &long_task1 || first == &long_task2);
+  EXPECT_TRUE(second == &long_task1 || second == &long_task2);
+  queue.Terminate();
+  EXPECT_THAT(queue.GetNext(1), IsNull());
+  EXPECT_THAT(queue.GetNext(0), IsNull());
+}
+
 }  // namespace platform
 }  // namespace v8
@@ -0,0 +1,239 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "include/libplatform/v8-tracing.h"
+#include "src/base/platform/platform.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace platform {
+namespace tracing {
+
+namespace {
+
+class CountingTraceWriter : public TraceWriter {
+ public:
+  explicit CountingTraceWriter(std::vector<std::string>* names)
+      : names_(names) {}
+
+  void AppendTraceEvent(TraceObject* trace_event) override {
+    names_->push_back(trace_event->name());
+  }
+  void Flush() override {}
+
+ private:
+  std::vector<std::string>* names_;
+};
+
+void AddTraceEventForTesting(TraceBuffer* buffer, const char* name) {
+  static uint8_t category_enabled_flag = 1;
+  uint64_t handle;
+  TraceObject* trace_object = buffer->AddTraceEvent(&handle);
+  ASSERT_NE(nullptr, trace_object);
+  trace_object->InitializeForTesting('X', &category_enabled_flag, name, nullptr,
+                                     0, 0, 0, nullptr, nullptr, nullptr, 0, 0,
+                                     0, 0, 0, 0, 0);
+}
+
+class TraceEventThread final : public base::Thread {
+ public:
+  TraceEventThread(TraceBuffer* buffer, size_t num_events)
+      : Thread(Options("libplatform TraceEventThread")),
+        buffer_(buffer),
+        num_events_(num_events) {}
+
+  void Run() override {
+    for (size_t i = 0; i < num_events_; ++i) {
+      AddTraceEventForTesting(buffer_, "thread");
+    }
+  }
+
+ private:
+  TraceBuffer* buffer_;
+  size_t num_events_;
+};
+
+}  // namespace
+
+
+TEST(TracingTest, TraceConfigCategories) {
+  std::unique_ptr<TraceConfig> default_config(
+      TraceConfig::CreateDefaultTraceConfig());
+  EXPECT_TRUE(default_config->IsCategoryGroupEnabled("v8"));
+  EXPECT_FALSE(default_config->IsCategoryGroupEnabled("v8.runtime"));
+
+  TraceConfig config;
+  config.AddIncludedCategories("v8,v8.runtime");
+  EXPECT_EQ(2u, config.GetEnabledCategories().size());
+  EXPECT_TRUE(config.IsCategoryGroupEnabled("v8.runtime"));
+  EXPECT_TRUE(config.IsCategoryGroupEnabled("blink,v8"));
+  EXPECT_FALSE(config.IsCategoryGroupEnabled("blink"));
+
+  TraceConfig wildcard_config;
+  wildcard_config.AddIncludedCategory("*");
+  EXPECT_TRUE(wildcard_config.IsCategoryGroupEnabled("blink"));
+  EXPECT_FALSE(
+      wildcard_config.IsCategoryGroupEnabled("disabled-by-default-v8.gc"));
+}
+
+
+TEST(TracingTest, RingBufferHandles) {
+  std::vector<std::string> names;
+  std::unique_ptr<TraceBuffer> buffer(TraceBuffer::CreateTraceBufferRingBuffer(
+      2, new CountingTraceWriter(&names)));
+  uint8_t category_enabled_flag = 1;
+  std::vector<uint64_t> handles;
+  // Fill both chunks of the buffer.
+  for (size_t i = 0; i < 2 * TraceBufferChunk::kChunkSize; ++i) {
+    uint64_t handle;
+    TraceObject* trace_object = buffer->AddTraceEvent(&handle);
+    ASSERT_NE(nullptr, trace_object);
+    trace_object->InitializeForTesting('X', &category_enabled_flag, "event",
+                                       nullptr, 0, 0, 0, nullptr, nullptr,
+                                       nullptr, 0, 0, 0, 0, 0, 0, 0);
+    EXPECT_EQ(trace_object, buffer->GetEventByHandle(handle));
+    handles.push_back(handle);
+  }
+
+  // The next event recycles the oldest chunk, which invalidates its handles.
+  uint64_t handle;
+  TraceObject* trace_object = buffer->AddTraceEvent(&handle);
+  ASSERT_NE(nullptr, trace_object);
+  trace_object->InitializeForTesting('X', &category_enabled_flag, "last",
+                                     nullptr, 0, 0, 0, nullptr, nullptr,
+                                     nullptr, 0, 0, 0, 0, 0, 0, 0);
+  EXPECT_EQ(trace_object, buffer->GetEventByHandle(handle));
+  EXPECT_EQ(nullptr, buffer->GetEventByHandle(handles.front()));
+  EXPECT_NE(nullptr, buffer->GetEventByHandle(handles.back()));
+
+  // A stale handle must not update the event that reuses its slot.
+  buffer->UpdateEventDuration(handles.front());
+  EXPECT_EQ(0u, trace_object->duration());
+  buffer->UpdateEventDuration(handle);
+  EXPECT_NE(0u, trace_object->duration());
+
+  buffer->Flush();
+  EXPECT_EQ(TraceBufferChunk::kChunkSize + 1, names.size());
+  EXPECT_EQ("last", names.front());
+}
+
+
+TEST(TracingTest, RingBufferReleasesFullChunks) {
+  std::vector<std::string> names;
+  std::unique_ptr<TraceBuffer> buffer(TraceBuffer::CreateTraceBufferRingBuffer(
+      1, new CountingTraceWriter(&names)));
+  // The thread fills the only chunk and exits. The chunk is released with
+  // the last event, so the main thread can still record.
+  TraceEventThread thread(buffer.get(), TraceBufferChunk::kChunkSize);
+  thread.Start();
+  thread.Join();
+  AddTraceEventForTesting(buffer.get(), "main");
+
+  buffer->Flush();
+  ASSERT_EQ(1u, names.size());
+  EXPECT_EQ("main", names.front());
+}
+
+
+TEST(TracingTest, RingBufferRecyclesChunksOfExitedThreads) {
+  std::vector<std::string> names;
+  std::unique_ptr<TraceBuffer> buffer(TraceBuffer::CreateTraceBufferRingBuffer(
+      2, new CountingTraceWriter(&names)));
+  // Both threads exit before filling their chunks.
+  TraceEventThread thread1(buffer.get(), 1);
+  thread1.Start();
+  thread1.Join();
+  TraceEventThread thread2(buffer.get(), 2);
+  thread2.Start();
+  thread2.Join();
+
+  // The chunk of the first thread is recycled first.
+  AddTraceEventForTesting(buffer.get(), "main");
+  buffer->Flush();
+  ASSERT_EQ(3u, names.size());
+  EXPECT_EQ("main", names[0]);
+  EXPECT_EQ("thread", names[1]);
+  EXPECT_EQ("thread", names[2]);
+}
+
+
+TEST(TracingTest, RingBufferPerBufferChunks) {
+  std::vector<std::string> names1, names2;
+  std::unique_ptr<TraceBuffer> buffer1(
+      TraceBuffer::CreateTraceBufferRingBuffer(
+          1, new CountingTraceWriter(&names1)));
+  std::unique_ptr<TraceBuffer> buffer2(
+      TraceBuffer::CreateTraceBufferRingBuffer(
+          1, new CountingTraceWriter(&names2)));
+  // Switching between buffers keeps the chunk of each buffer, so events do
+  // not need a new chunk.
+  for (int i = 0; i < 3; ++i) {
+    AddTraceEventForTesting(buffer1.get(), "first");
+    AddTraceEventForTesting(buffer2.get(), "second");
+  }
+  buffer1->Flush();
+  buffer2->Flush();
+  EXPECT_EQ(3u, names1.size());
+  EXPECT_EQ(3u, names2.size());
+}
+
+
+TEST(TracingTest, JSONOutput) {
+  std::ostringstream stream;
+  {
+    TracingController tracing_controller;
+    tracing_controller.Initialize(TraceBuffer::CreateTraceBufferRingBuffer(
+        TraceBuffer::kRingBufferChunks,
+        TraceWriter::CreateJSONTraceWriter(stream)));
+    TraceConfig* trace_config = new TraceConfig();
+    trace_config->AddIncludedCategory("v8-cat");
+    trace_config->AddIncludedCategory("v8\"quoted");
+    tracing_controller.StartTracing(trace_config);
+
+    const uint8_t* enabled =
+        tracing_controller.GetCategoryGroupEnabled("v8-cat");
+    const uint8_t* disabled =
+        tracing_controller.GetCategoryGroupEnabled("other-cat");
+    EXPECT_TRUE(*enabled);
+    EXPECT_FALSE(*disabled);
+    EXPECT_STREQ("v8-cat", TracingController::GetCategoryGroupName(enabled));
+
+    const char* arg_names[] = {"str", "num"};
+    uint8_t arg_types[] = {7 /* TRACE_VALUE_TYPE_COPY_STRING */,
+                           2 /* TRACE_VALUE_TYPE_UINT */};
+    uint64_t arg_values[] = {reinterpret_cast<uint64_t>("a\"b"), 42};
+    uint64_t handle = tracing_controller.AddTraceEvent(
+        'X', enabled, "test.event", nullptr, 0, 0, 2, arg_names, arg_types,
+        arg_values, 0);
+    tracing_controller.UpdateTraceEventDuration(enabled, "test.event", handle);
+    const uint8_t* quoted =
+        tracing_controller.GetCategoryGroupEnabled("v8\"quoted");
+    EXPECT_TRUE(*quoted);
+    tracing_controller.AddTraceEvent('X', quoted, "quoted.event", nullptr, 0,
+                                     0, 0, nullptr, nullptr, nullptr, 0);
+    EXPECT_EQ(0u, tracing_controller.AddTraceEvent('X', disabled, "skipped",
+                                                   nullptr, 0, 0, 0, nullptr,
+                                                   nullptr, nullptr, 0));
+    tracing_controller.StopTracing();
+    EXPECT_FALSE(*enabled);
+  }
+
+  std::string json = stream.str();
+  EXPECT_EQ(0u, json.find("{\"traceEvents\":[{"));
+  EXPECT_EQ(json.size() - 2, json.rfind("]}"));
+  EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\",\"cat\":\"v8-cat\","
+                                         "\"name\":\"test.event\""));
+  EXPECT_NE(std::string::npos,
+            json.find("\"args\":{\"str\":\"a\\\"b\",\"num\":42}"));
+  EXPECT_NE(std::string::npos, json.find("\"cat\":\"v8\\\"quoted\","));
+  EXPECT_EQ(std::string::npos, json.find("skipped"));
+}
+
+}  // namespace tracing
+}  // namespace platform
+}  // namespace v8
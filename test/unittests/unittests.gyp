@@ -40,6 +40,8 @@
         'base/utils/random-number-generator-unittest.cc',
         'cancelable-tasks-unittest.cc',
         'char-predicates-unittest.cc',
+        'compiler/allocation-sinking-unittest.cc',
+        'compiler/bounds-check-elimination-unittest.cc',
         'compiler/branch-elimination-unittest.cc',
         'compiler/coalesced-live-ranges-unittest.cc',
         'compiler/common-operator-reducer-unittest.cc',
@@ -56,6 +58,8 @@
         'compiler/graph-trimmer-unittest.cc',
         'compiler/graph-unittest.cc',
         'compiler/graph-unittest.h',
+        'compiler/greedy-allocator-unittest.cc',
+        'compiler/induction-variable-analysis-unittest.cc',
         'compiler/instruction-selector-unittest.cc',
         'compiler/instruction-selector-unittest.h',
         'compiler/instruction-sequence-unittest.cc',
@@ -70,6 +74,7 @@
         'compiler/liveness-analyzer-unittest.cc',
         'compiler/live-range-unittest.cc',
         'compiler/load-elimination-unittest.cc',
+        'compiler/loop-invariant-code-motion-unittest.cc',
         'compiler/loop-peeling-unittest.cc',
         'compiler/machine-operator-reducer-unittest.cc',
         'compiler/machine-operator-unittest.cc',
@@ -87,6 +92,7 @@
         'compiler/scheduler-rpo-unittest.cc',
         'compiler/simplified-operator-reducer-unittest.cc',
         'compiler/simplified-operator-unittest.cc',
+        'compiler/slp-vectorizer-unittest.cc',
         'compiler/state-values-utils-unittest.cc',
         'compiler/tail-call-optimization-unittest.cc',
         'compiler/typer-unittest.cc',
@@ -97,12 +103,14 @@
         'interpreter/bytecode-array-builder-unittest.cc',
         'interpreter/bytecode-array-iterator-unittest.cc',
         'interpreter/bytecode-register-allocator-unittest.cc',
+        'interpreter/bytecode-register-optimizer-unittest.cc',
         'interpreter/constant-array-builder-unittest.cc',
         'interpreter/interpreter-assembler-unittest.cc',
         'interpreter/interpreter-assembler-unittest.h',
         'interpreter/source-position-table-unittest.cc',
         'libplatform/default-platform-unittest.cc',
         'libplatform/task-queue-unittest.cc',
+        'libplatform/tracing-unittest.cc',
         'libplatform/worker-thread-unittest.cc',
         'heap/bitmap-unittest.cc',
         'heap/gc-idle-time-handler-unittest.cc',
@@ -162,6 +170,7 @@
         }],
         ['v8_target_arch=="x64"', {
           'sources': [  ### gcmole(arch:x64) ###
+            'compiler/x64/instruction-scheduler-x64-unittest.cc',
             'compiler/x64/instruction-selector-x64-unittest.cc',
           ],
         }],
@@ -16,7 +16,8 @@ import struct
 
 __DESCRIPTION = """
 Process v8.ignition_dispatches_counters.json and list top counters,
-or plot a dispatch heatmap.
+rank candidate bytecode pairs for superinstructions, or plot a dispatch
+heatmap.
 
 Please note that those handlers that may not or will never dispatch
 (e.g. Return or Throw) do not show up in the results.
@@ -32,6 +33,10 @@ examples:
   # Print the hottest 15 bytecode dispatch pairs reading from data.json
   $ tools/ignition/bytecode_dispatches_report.py -t -n 15 data.json
 
+  # Print the 20 best candidates for fused bytecodes, ignoring pairs which
+  # account for less than half of the dispatches from their first bytecode
+  $ tools/ignition/bytecode_dispatches_report.py -f -n 20 -a 0.5
+
   # Save heatmap to default filename v8.ignition_dispatches_counters.svg
   $ tools/ignition/bytecode_dispatches_report.py -p
 
@@ -72,6 +77,50 @@ def print_top_bytecode_dispatch_pairs(dispatches_table, top_count):
     print "{:>12d}\t{} -> {}".format(counter, source, destination)
 
 
+def is_fusion_source(bytecode):
+  # Prefixes dispatch to the bytecode they scale, and jumps do not necessarily
+  # dispatch to the next bytecode, so neither can start a superinstruction.
+  return not (bytecode in ("Wide", "ExtraWide") or
+              bytecode.startswith("Jump") or
+              bytecode.startswith("DebugBreak"))
+
+
+def is_fusion_destination(bytecode):
+  return not (bytecode in ("Wide", "ExtraWide") or
+              bytecode.startswith("DebugBreak"))
+
+
+def find_fusion_candidates(dispatches_table, top_count, min_affinity):
+  # The affinity of a pair is the fraction of the dispatches from its first
+  # bytecode that go to its second bytecode. Fusing a pair saves as many
+  # dispatches as the pair has, so candidates are ranked by that counter.
+  candidates = []
+  for source, counters_from_source in dispatches_table.items():
+    if not is_fusion_source(source):
+      continue
+    total = sum(counters_from_source.values())
+    if total == 0:
+      continue
+    for destination, counter in counters_from_source.items():
+      if not is_fusion_destination(destination):
+        continue
+      affinity = float(counter) / total
+      if affinity >= min_affinity:
+        candidates.append((source, destination, counter, affinity))
+  return heapq.nlargest(top_count, candidates, key=lambda x: x[2])
+
+
+def print_fusion_candidates(dispatches_table, top_count, min_affinity):
+  fusion_candidates = (
+    find_fusion_candidates(dispatches_table, top_count, min_affinity))
+  total = sum(sum(counters_from_source.values())
+              for counters_from_source in dispatches_table.values())
+  print "Top {} superinstruction candidates:".format(top_count)
+  for source, destination, counter, affinity in fusion_candidates:
+    print "{:>12d}\t{:>6.2%}\t{:>6.2%}\t{} + {}".format(
+      counter, float(counter) / total, affinity, source, destination)
+
+
 def find_top_bytecodes(dispatches_table):
   top_bytecodes = []
   for bytecode, counters_from_bytecode in dispatches_table.items():
@@ -171,7 +220,23 @@ def parse_command_line():
     metavar="N",
     type=int,
     default=10,
-    help="print N top bytecode dispatch pairs when running with -t (default 10)"
+    help=("print N top bytecode dispatch pairs when running with -t or -f "
+          "(default 10)")
+  )
+  command_line_parser.add_argument(
+    "--fusion-candidates", "-f",
+    action="store_true",
+    help=("rank bytecode pairs by the dispatches a superinstruction would "
+          "save, printing the counter, the share of all dispatches and the "
+          "share of dispatches from the first bytecode")
+  )
+  command_line_parser.add_argument(
+    "--min-affinity", "-a",
+    metavar="F",
+    type=float,
+    default=0.1,
+    help=("ignore pairs with less than this fraction of the dispatches from "
+          "their first bytecode when running with -f (default 0.1)")
   )
   command_line_parser.add_argument(
     "--output-filename", "-o",
@@ -209,6 +274,10 @@ def main():
       figure.set_size_inches(program_options.plot_size,
                              program_options.plot_size)
       pyplot.savefig(program_options.output_filename)
+  elif program_options.fusion_candidates:
+    print_fusion_candidates(
+      dispatches_table, program_options.top_bytecode_dispatch_pairs_number,
+      program_options.min_affinity)
   elif program_options.top_bytecode_dispatch_pairs:
     print_top_bytecode_dispatch_pairs(
       dispatches_table, program_options.top_bytecode_dispatch_pairs_number)
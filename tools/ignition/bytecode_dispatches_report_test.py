@@ -41,3 +41,15 @@ class BytecodeDispatchesReportTest(unittest.TestCase):
       ('a',  25),
       ('b',   5)
     ])
+
+  def test_find_fusion_candidates(self):
+    fusion_candidates = bdr.find_fusion_candidates({
+      "LdaZero": {"Star": 90, "Add": 10},
+      "JumpIfFalse": {"LdaZero": 500},
+      "Wide": {"Star": 300},
+      "Star": {"LdaZero": 30, "Wide": 50, "Ldar": 20},
+      "Ldar": {"Return": 5}}, 3, 0.15)
+    self.assertListEqual(fusion_candidates, [
+      ('LdaZero', 'Star', 90, 0.9),
+      ('Star', 'LdaZero', 30, 0.3),
+      ('Star', 'Ldar', 20, 0.2)])